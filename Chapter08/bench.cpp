@@ -0,0 +1,846 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <chrono>
+#include <thread>
+#include "leptjson.h"
+
+struct buffer
+{
+	char* p;
+	size_t size, capacity;
+};
+
+static void buffer_append(buffer* b, const char* s, size_t len)
+{
+	if (b->size + len + 1 > b->capacity)
+	{
+		while (b->size + len + 1 > b->capacity)
+			b->capacity = b->capacity ? b->capacity * 2 : 4096;
+		b->p = (char*)realloc(b->p, b->capacity);
+	}
+	memcpy(b->p + b->size, s, len);
+	b->size += len;
+	b->p[b->size] = '\0';
+}
+
+static void buffer_puts(buffer* b, const char* s)
+{
+	buffer_append(b, s, strlen(s));
+}
+
+static void buffer_indent(buffer* b, int depth, int width)
+{
+	for (int i = 0; i < depth * width; i++)
+		buffer_append(b, " ", 1);
+}
+
+// records pretty-printed the way our upstream services send them
+static char* make_indented_json(size_t records, int width, size_t* length)
+{
+	buffer b = { NULL, 0, 0 };
+	char num[32];
+	buffer_puts(&b, "[\n");
+	for (size_t i = 0; i < records; i++)
+	{
+		buffer_indent(&b, 1, width); buffer_puts(&b, "{\n");
+		buffer_indent(&b, 2, width); sprintf(num, "\"id\": %u,\n", (unsigned)i); buffer_puts(&b, num);
+		buffer_indent(&b, 2, width); buffer_puts(&b, "\"name\": \"record\",\n");
+		buffer_indent(&b, 2, width); buffer_puts(&b, "\"tags\": [\n");
+		buffer_indent(&b, 3, width); buffer_puts(&b, "true,\n");
+		buffer_indent(&b, 3, width); buffer_puts(&b, "null\n");
+		buffer_indent(&b, 2, width); buffer_puts(&b, "]\n");
+		buffer_indent(&b, 1, width); buffer_puts(&b, i + 1 < records ? "},\n" : "}\n");
+	}
+	buffer_puts(&b, "]\n");
+	*length = b.size;
+	return b.p;
+}
+
+static double bench_parse(const char* json, size_t length, int iterations, int (*parse)(lept_value*, const char*) = lept_parse)
+{
+	clock_t start = clock();
+	for (int i = 0; i < iterations; i++)
+	{
+		lept_value v;
+		lept_init(&v);
+		if (parse(&v, json) != LEPT_PARSE_OK)
+		{
+			fprintf(stderr, "parse failed\n");
+			exit(1);
+		}
+		lept_free(&v);
+	}
+	double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+	return length * (double)iterations / seconds / (1024 * 1024);
+}
+
+static void bench_whitespace()
+{
+	static const char* names[] = { "scalar", "sse2", "avx2" };
+	static const int widths[] = { 2, 4, 8 };
+	for (int w = 0; w < 3; w++)
+	{
+		size_t length;
+		char* json = make_indented_json(20000, widths[w], &length);
+		printf("whitespace: indent %d, %.1f MB\n", widths[w], length / (1024.0 * 1024));
+		for (int level = LEPT_SIMD_NONE; level <= LEPT_SIMD_AVX2; level++)
+		{
+			if (lept_set_simd((lept_simd)level) != level)
+				continue;
+			printf("  %-8s %8.1f MB/s\n", names[level], bench_parse(json, length, 20));
+		}
+		lept_set_simd(LEPT_SIMD_AVX2);
+		free(json);
+	}
+}
+
+static void bench_strings()
+{
+	static const char* names[] = { "scalar", "sse2", "avx2" };
+	buffer b = { NULL, 0, 0 };
+	buffer_puts(&b, "[");
+	for (int i = 0; i < 20000; i++)
+	{
+		buffer_puts(&b, i ? ",\"" : "\"");
+		for (int j = 0; j < 12; j++)
+			buffer_puts(&b, "lorem ipsum ");
+		buffer_puts(&b, "\"");
+	}
+	buffer_puts(&b, "]");
+	printf("strings: %.1f MB\n", b.size / (1024.0 * 1024));
+	for (int level = LEPT_SIMD_NONE; level <= LEPT_SIMD_AVX2; level++)
+	{
+		if (lept_set_simd((lept_simd)level) != level)
+			continue;
+		printf("  %-8s %8.1f MB/s\n", names[level], bench_parse(b.p, b.size, 20));
+	}
+	lept_set_simd(LEPT_SIMD_AVX2);
+	free(b.p);
+}
+
+static size_t allocations;
+
+static void* counting_malloc(void*, size_t size)
+{
+	allocations++;
+	return malloc(size);
+}
+
+static void* counting_realloc(void*, void* p, size_t size)
+{
+	allocations++;
+	return realloc(p, size);
+}
+
+static void counting_free(void*, void* p)
+{
+	free(p);
+}
+
+static void bench_short_strings()
+{
+	lept_allocator counting = { counting_malloc, counting_realloc, counting_free, NULL };
+	buffer b = { NULL, 0, 0 };
+	char record[96];
+	lept_value v;
+	buffer_puts(&b, "[");
+	for (int i = 0; i < 20000; i++)
+	{
+		sprintf(record, "%s{\"status\":\"ok\",\"code\":\"E%02d\",\"user\":\"u%06d\",\"tags\":[\"new\",\"vip\"]}", i ? "," : "", i % 100, i);
+		buffer_puts(&b, record);
+	}
+	buffer_puts(&b, "]");
+	allocations = 0;
+	lept_set_allocator(&counting);
+	lept_init(&v);
+	lept_parse(&v, b.p);
+	lept_free(&v);
+	lept_set_allocator(NULL);
+	printf("short strings: %.1f MB, %u allocations per parse\n", b.size / (1024.0 * 1024), (unsigned)allocations);
+	printf("  %-8s %8.1f MB/s\n", "parse", bench_parse(b.p, b.size, 20));
+	free(b.p);
+}
+
+static void bench_large_object()
+{
+	static const size_t sizes[] = { 16, 1000, 10000 };
+	char key[16];
+	printf("large objects: build, look up every key, compare with a copy\n");
+	for (int s = 0; s < 3; s++)
+	{
+		size_t n = sizes[s], found = 0;
+		int rounds = (int)(200000 / n);
+		lept_value o, copy;
+		lept_init(&o);
+		lept_init(&copy);
+		clock_t start = clock();
+		for (int r = 0; r < rounds; r++)
+		{
+			lept_set_object(&o, 0);
+			for (size_t i = 0; i < n; i++)
+			{
+				sprintf(key, "key%u", (unsigned)i);
+				lept_set_number(lept_set_object_value(&o, key, strlen(key)), (double)i);
+			}
+		}
+		double build = (double)(clock() - start) / CLOCKS_PER_SEC / rounds;
+		start = clock();
+		for (int r = 0; r < rounds; r++)
+			for (size_t i = 0; i < n; i++)
+			{
+				sprintf(key, "key%u", (unsigned)i);
+				found += lept_find_object_index(&o, key, strlen(key)) == i;
+			}
+		double lookup = (double)(clock() - start) / CLOCKS_PER_SEC / rounds;
+		lept_copy(&copy, &o);
+		start = clock();
+		for (int r = 0; r < rounds; r++)
+			found += lept_is_equal(&o, &copy);
+		double equal = (double)(clock() - start) / CLOCKS_PER_SEC / rounds;
+		printf("  %6u keys %10.1f us build %10.1f us lookup %10.1f us equal\n", (unsigned)n, build * 1e6, lookup * 1e6, equal * 1e6);
+		if (found != (n + 1) * rounds)
+			exit(1);
+		lept_free(&o);
+		lept_free(&copy);
+	}
+}
+
+static void bench_numbers()
+{
+	buffer b = { NULL, 0, 0 };
+	char num[32];
+	unsigned seed = 12345;
+	buffer_puts(&b, "[");
+	for (int i = 0; i < 200000; i++)
+	{
+		seed = seed * 1103515245 + 12345;
+		sprintf(num, i ? ",%.*g" : "%.*g", 6 + i % 12, (seed >> 8) / 1024.0 - 4096.0);
+		buffer_puts(&b, num);
+	}
+	buffer_puts(&b, "]");
+	printf("numbers: %.1f MB\n  %-8s %8.1f MB/s\n", b.size / (1024.0 * 1024), "parse", bench_parse(b.p, b.size, 10));
+	free(b.p);
+}
+
+static void bench_indexed()
+{
+	size_t length;
+	char* json = make_indented_json(20000, 4, &length);
+	printf("indexed: %.1f MB\n", length / (1024.0 * 1024));
+	printf("  %-8s %8.1f MB/s\n", "parse", bench_parse(json, length, 20));
+	printf("  %-8s %8.1f MB/s\n", "indexed", bench_parse(json, length, 20, lept_parse_indexed));
+	free(json);
+}
+
+static double bench_parse_tape(const char* json, size_t length, int iterations)
+{
+	clock_t start = clock();
+	for (int i = 0; i < iterations; i++)
+	{
+		lept_tape t;
+		if (lept_parse_tape(&t, json) != LEPT_PARSE_OK)
+		{
+			fprintf(stderr, "parse failed\n");
+			exit(1);
+		}
+		lept_free_tape(&t);
+	}
+	double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+	return length * (double)iterations / seconds / (1024 * 1024);
+}
+
+// the copy into the mutable buffer is counted, as a server would read into it anyway
+static double bench_parse_insitu(const char* json, size_t length, int iterations)
+{
+	char* buffer = (char*)malloc(length + 1);
+	clock_t start = clock();
+	for (int i = 0; i < iterations; i++)
+	{
+		lept_value v;
+		lept_init(&v);
+		memcpy(buffer, json, length + 1);
+		if (lept_parse_insitu(&v, buffer) != LEPT_PARSE_OK)
+		{
+			fprintf(stderr, "parse failed\n");
+			exit(1);
+		}
+		lept_free(&v);
+	}
+	double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+	free(buffer);
+	return length * (double)iterations / seconds / (1024 * 1024);
+}
+
+static void bench_insitu()
+{
+	size_t length;
+	char* json = make_indented_json(20000, 0, &length);
+	printf("insitu: %.1f MB\n", length / (1024.0 * 1024));
+	printf("  %-8s %8.1f MB/s\n", "parse", bench_parse(json, length, 20));
+	printf("  %-8s %8.1f MB/s\n", "insitu", bench_parse_insitu(json, length, 20));
+	free(json);
+}
+
+// in 1460-byte pieces, the payload of one TCP segment
+static double bench_parse_chunked(const char* json, size_t length, int iterations)
+{
+	lept_parser* p = lept_parser_create();
+	clock_t start = clock();
+	for (int i = 0; i < iterations; i++)
+	{
+		lept_value v;
+		for (size_t off = 0; off < length; off += 1460)
+			lept_parser_feed(p, json + off, length - off < 1460 ? length - off : 1460);
+		if (lept_parser_finish(p, &v) != LEPT_PARSE_OK)
+		{
+			fprintf(stderr, "parse failed\n");
+			exit(1);
+		}
+		lept_free(&v);
+	}
+	double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+	lept_parser_destroy(p);
+	return length * (double)iterations / seconds / (1024 * 1024);
+}
+
+static void bench_chunked()
+{
+	size_t length;
+	char* json = make_indented_json(20000, 2, &length);
+	printf("chunked: %.1f MB\n", length / (1024.0 * 1024));
+	printf("  %-8s %8.1f MB/s\n", "parse", bench_parse(json, length, 20));
+	printf("  %-8s %8.1f MB/s\n", "chunked", bench_parse_chunked(json, length, 20));
+	free(json);
+}
+
+// a consumer that only picks out one field, the case SAX is for
+static int sax_count_id(void* ctx, const char* k, size_t len)
+{
+	if (len == 2 && memcmp(k, "id", 2) == 0)
+		++*(size_t*)ctx;
+	return 1;
+}
+
+static void bench_sax()
+{
+	static const lept_handler handler = { NULL, NULL, NULL, NULL, NULL, NULL, sax_count_id, NULL, NULL, NULL, NULL };
+	size_t length, ids = 0;
+	char* json = make_indented_json(20000, 0, &length);
+	printf("sax: %.1f MB\n", length / (1024.0 * 1024));
+	printf("  %-8s %8.1f MB/s\n", "tree", bench_parse(json, length, 20));
+	clock_t start = clock();
+	for (int i = 0; i < 20; i++)
+		lept_parse_sax(json, length, &handler, &ids);
+	double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+	printf("  %-8s %8.1f MB/s\n", "sax", length * 20.0 / seconds / (1024 * 1024));
+	free(json);
+}
+
+// a hand-written decoder pulling "id" and "name" from each record, against a tree and lookups
+static size_t read_records(const char* json, size_t length)
+{
+	lept_reader* r = lept_reader_create(json, length);
+	size_t sum = 0;
+	lept_reader_next(r);
+	while (lept_reader_next(r) == LEPT_TOKEN_START_OBJECT)
+	{
+		while (lept_reader_next(r) == LEPT_TOKEN_KEY)
+		{
+			size_t len = lept_reader_get_string_length(r);
+			const char* k = lept_reader_get_string(r);
+			if (len == 2 && memcmp(k, "id", 2) == 0 && lept_reader_next(r) == LEPT_TOKEN_NUMBER)
+				sum += (size_t)lept_reader_get_int64(r);
+			else if (len == 4 && memcmp(k, "name", 4) == 0 && lept_reader_next(r) == LEPT_TOKEN_STRING)
+				sum += lept_reader_get_string_length(r);
+			else
+				lept_reader_skip(r);
+		}
+	}
+	if (lept_reader_get_error(r) != LEPT_PARSE_OK)
+	{
+		fprintf(stderr, "parse failed\n");
+		exit(1);
+	}
+	lept_reader_destroy(r);
+	return sum;
+}
+
+static size_t lookup_records(const char* json)
+{
+	lept_value v;
+	size_t sum = 0;
+	lept_init(&v);
+	if (lept_parse(&v, json) != LEPT_PARSE_OK)
+	{
+		fprintf(stderr, "parse failed\n");
+		exit(1);
+	}
+	for (size_t i = 0; i < lept_get_array_size(&v); i++)
+	{
+		lept_value* record = lept_get_array_element(&v, i);
+		sum += (size_t)lept_get_int64(lept_find_object_value(record, "id", 2));
+		sum += lept_get_string_length(lept_find_object_value(record, "name", 4));
+	}
+	lept_free(&v);
+	return sum;
+}
+
+static void bench_reader()
+{
+	size_t length, sum1 = 0, sum2 = 0;
+	char* json = make_indented_json(20000, 0, &length);
+	printf("reader: %.1f MB\n", length / (1024.0 * 1024));
+	clock_t start = clock();
+	for (int i = 0; i < 20; i++)
+		sum1 += lookup_records(json);
+	double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+	printf("  %-8s %8.1f MB/s\n", "lookup", length * 20.0 / seconds / (1024 * 1024));
+	start = clock();
+	for (int i = 0; i < 20; i++)
+		sum2 += read_records(json, length);
+	seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+	printf("  %-8s %8.1f MB/s\n", "reader", length * 20.0 / seconds / (1024 * 1024));
+	if (sum1 != sum2)
+		fprintf(stderr, "reader and lookup disagree\n");
+	free(json);
+}
+
+// three fields out of one large document, the records array is never looked into
+static size_t sparse_lookup(const char* json, int (*parse)(lept_value*, const char*))
+{
+	lept_value v;
+	size_t sum;
+	lept_init(&v);
+	if (parse(&v, json) != LEPT_PARSE_OK)
+	{
+		fprintf(stderr, "parse failed\n");
+		exit(1);
+	}
+	lept_value* meta = lept_find_object_value(&v, "meta", 4);
+	sum = (size_t)lept_get_int64(lept_find_object_value(meta, "id", 2));
+	sum += lept_get_string_length(lept_find_object_value(meta, "name", 4));
+	sum += (size_t)lept_get_int64(lept_find_object_value(meta, "version", 7));
+	lept_free(&v);
+	return sum;
+}
+
+static void bench_lazy()
+{
+	size_t length, sum1 = 0, sum2 = 0;
+	char* records = make_indented_json(20000, 2, &length);
+	buffer b = { NULL, 0, 0 };
+	buffer_puts(&b, "{\n  \"meta\": { \"id\": 7, \"name\": \"snapshot\", \"version\": 3 },\n  \"records\": ");
+	buffer_append(&b, records, length);
+	buffer_puts(&b, "}\n");
+	free(records);
+	printf("lazy: %.1f MB, 3 fields\n", b.size / (1024.0 * 1024));
+	clock_t start = clock();
+	for (int i = 0; i < 20; i++)
+		sum1 += sparse_lookup(b.p, lept_parse);
+	double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+	printf("  %-8s %8.1f MB/s\n", "parse", b.size * 20.0 / seconds / (1024 * 1024));
+	start = clock();
+	for (int i = 0; i < 20; i++)
+		sum2 += sparse_lookup(b.p, lept_parse_lazy);
+	seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+	printf("  %-8s %8.1f MB/s\n", "lazy", b.size * 20.0 / seconds / (1024 * 1024));
+	if (sum1 != sum2)
+		fprintf(stderr, "lazy and parse disagree\n");
+	free(b.p);
+}
+
+// many small messages, where the scratch stack of each lept_parse is a malloc, reallocs and a free
+static void bench_reuse()
+{
+	static const char* message = "{\"id\":12345,\"user\":\"alice\",\"text\":\"hello\\nworld\",\"tags\":[\"a\",\"b\"],\"score\":0.75}";
+	size_t length = strlen(message);
+	lept_parser* p = lept_parser_create();
+	lept_value v;
+	printf("reuse: %u-byte messages\n", (unsigned)length);
+	clock_t start = clock();
+	for (int i = 0; i < 200000; i++)
+	{
+		lept_parse(&v, message);
+		lept_free(&v);
+	}
+	double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+	printf("  %-8s %8.0f msg/s\n", "parse", 200000 / seconds);
+	start = clock();
+	for (int i = 0; i < 200000; i++)
+	{
+		lept_parser_parse(p, &v, message, length);
+		lept_free(&v);
+	}
+	seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+	printf("  %-8s %8.0f msg/s\n", "reused", 200000 / seconds);
+	lept_parser_destroy(p);
+}
+
+static void bench_document()
+{
+	size_t length;
+	char* json = make_indented_json(2000, 0, &length);
+	lept_document* d = lept_document_create();
+	lept_value v;
+	printf("document: %.1f KB\n", length / 1024.0);
+	clock_t start = clock();
+	for (int i = 0; i < 100; i++)
+	{
+		lept_parse(&v, json);
+		lept_free(&v);
+	}
+	double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+	printf("  %-8s %8.1f MB/s\n", "malloc", length * 100 / (1024.0 * 1024) / seconds);
+	start = clock();
+	for (int i = 0; i < 100; i++)
+	{
+		lept_parse_document(d, json);
+		lept_document_reset(d);
+	}
+	seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+	printf("  %-8s %8.1f MB/s\n", "arena", length * 100 / (1024.0 * 1024) / seconds);
+	lept_document_destroy(d);
+	free(json);
+}
+
+static void bench_intern()
+{
+	size_t length;
+	char* json = make_indented_json(100000, 0, &length);
+	printf("intern: %.1f MB of records\n", length / (1024.0 * 1024));
+	for (int intern = 0; intern < 2; intern++)
+	{
+		lept_document* d = lept_document_create();
+		lept_document_set_intern_keys(d, intern);
+		clock_t start = clock();
+		for (int i = 0; i < 10; i++)
+			lept_parse_document(d, json);
+		double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+		printf("  %-8s %8.1f MB/s %8.1f MB used\n", intern ? "interned" : "copied", length * 10 / (1024.0 * 1024) / seconds, lept_document_get_used(d) / (1024.0 * 1024));
+		lept_document_destroy(d);
+	}
+	free(json);
+}
+
+// the allocator keeps each block's size in front of it, so the live bytes are known
+static size_t live_bytes;
+
+static void* sized_malloc(void*, size_t size)
+{
+	size_t* p = (size_t*)malloc(sizeof(size_t) * 2 + size);
+	live_bytes += size;
+	*p = size;
+	return p + 2;
+}
+
+static void* sized_realloc(void*, void* q, size_t size)
+{
+	size_t* p = q != NULL ? (size_t*)q - 2 : NULL;
+	live_bytes += size - (p != NULL ? *p : 0);
+	p = (size_t*)realloc(p, sizeof(size_t) * 2 + size);
+	*p = size;
+	return p + 2;
+}
+
+static void sized_free(void*, void* q)
+{
+	if (q != NULL)
+	{
+		live_bytes -= ((size_t*)q)[-2];
+		free((size_t*)q - 2);
+	}
+}
+
+static void bench_footprint()
+{
+	lept_allocator sized = { sized_malloc, sized_realloc, sized_free, NULL };
+	static const char* kinds[] = { "numbers", "strings", "records" };
+	printf("footprint: sizeof(lept_value) = %u\n", (unsigned)sizeof(lept_value));
+	for (int k = 0; k < 3; k++)
+	{
+		buffer b = { NULL, 0, 0 };
+		char item[64];
+		size_t n = k == 2 ? 500000 : 2000000;
+		lept_value v;
+		buffer_puts(&b, "[");
+		for (size_t i = 0; i < n; i++)
+		{
+			if (k == 0)
+				sprintf(item, "%s%u.5", i ? "," : "", (unsigned)i);
+			else if (k == 1)
+				sprintf(item, "%s\"s%u\"", i ? "," : "", (unsigned)(i % 1000));
+			else
+				sprintf(item, "%s{\"id\":%u,\"ok\":true,\"v\":[1,2]}", i ? "," : "", (unsigned)i);
+			buffer_puts(&b, item);
+		}
+		buffer_puts(&b, "]");
+		lept_set_allocator(&sized);
+		live_bytes = 0;
+		lept_init(&v);
+		clock_t start = clock();
+		lept_parse(&v, b.p);
+		double parse = (double)(clock() - start) / CLOCKS_PER_SEC;
+		size_t bytes = live_bytes;
+		double sum = 0;
+		start = clock();
+		for (int r = 0; r < 20; r++)
+			for (size_t i = 0; i < n; i++)
+			{
+				const lept_value* e = lept_get_array_element(&v, i);
+				if (k == 0)
+					sum += lept_get_number(e);
+				else if (k == 1)
+					sum += lept_get_string_length(e);
+				else
+					sum += lept_get_array_size(lept_get_object_value(e, 2));
+			}
+		double walk = (double)(clock() - start) / CLOCKS_PER_SEC / 20;
+		lept_free(&v);
+		lept_set_allocator(NULL);
+		printf("  %-8s %7.1f MB %8.1f ms parse %7.2f ms walk (%g)\n", kinds[k], bytes / (1024.0 * 1024), parse * 1e3, walk * 1e3, sum);
+		free(b.p);
+	}
+}
+
+static void bench_packed()
+{
+	lept_allocator sized = { sized_malloc, sized_realloc, sized_free, NULL };
+	buffer b = { NULL, 0, 0 };
+	char item[32];
+	lept_value v;
+	double* data;
+	size_t n;
+	buffer_puts(&b, "[");
+	for (int i = 0; i < 1000000; i++)
+	{
+		sprintf(item, "%s%d.25", i ? "," : "", i % 100000 - 50000);
+		buffer_puts(&b, item);
+	}
+	buffer_puts(&b, "]");
+	printf("packed: 1M doubles, %.1f MB of json\n", b.size / (1024.0 * 1024));
+	for (int pack = 1; pack >= 0; pack--)
+	{
+		lept_set_pack_numbers(pack);
+		lept_set_allocator(&sized);
+		live_bytes = 0;
+		lept_init(&v);
+		lept_parse(&v, b.p);
+		size_t bytes = live_bytes;
+		lept_free(&v);
+		lept_set_allocator(NULL);
+		printf("  %s, %.1f MB parsed\n", pack ? "packed by the parser" : "lept_values, packed by the first sum", bytes / (1024.0 * 1024));
+		printf("  %-8s %8.1f MB/s\n", "parse", bench_parse(b.p, b.size, 10));
+		lept_parse(&v, b.p);
+		clock_t start = clock();
+		for (int r = 0; r < 10; r++)
+			free(lept_stringify(&v, NULL));
+		double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+		printf("  %-8s %8.1f MB/s\n", "stringify", b.size * 10 / (1024.0 * 1024) / seconds);
+		double sum = 0;
+		start = clock();
+		for (int r = 0; r < 10; r++)
+		{
+			if (lept_get_number_array(&v, &data, &n))
+				for (size_t i = 0; i < n; i++)
+					sum += data[i];
+			else
+				for (size_t i = 0; i < lept_get_array_size(&v); i++)
+					sum += lept_get_number(lept_get_array_element(&v, i));
+		}
+		seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+		printf("  %-8s %8.2f ms (%g)\n", "sum", seconds * 100, sum);
+		lept_free(&v);
+	}
+	lept_set_pack_numbers(1);
+	free(b.p);
+}
+
+// wall time, since the threads share the work
+static void bench_parallel()
+{
+	size_t length;
+	char* json = make_indented_json(1000000, 2, &length);
+	unsigned cores = std::thread::hardware_concurrency();
+	printf("parallel: %.1f MB, %u cores\n", length / (1024.0 * 1024), cores);
+	for (unsigned threads = 0; threads <= 16; threads = threads ? threads * 2 : 1)
+	{
+		auto start = std::chrono::steady_clock::now();
+		for (int r = 0; r < 3; r++)
+		{
+			lept_value v;
+			lept_init(&v);
+			int ret = threads ? lept_parse_parallel(&v, json, length, threads) : lept_parse_n(&v, json, length);
+			if (ret != LEPT_PARSE_OK)
+			{
+				fprintf(stderr, "parse failed\n");
+				exit(1);
+			}
+			lept_free(&v);
+		}
+		double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		if (threads)
+			printf("  %2u threads %8.1f MB/s\n", threads, length * 3 / (1024.0 * 1024) / seconds);
+		else
+			printf("  parse_n    %8.1f MB/s\n", length * 3 / (1024.0 * 1024) / seconds);
+	}
+	free(json);
+}
+
+static int count_record(void* ctx, size_t, int ret, lept_value*)
+{
+	if (ret == LEPT_PARSE_OK)
+		++*static_cast<size_t*>(ctx);
+	return 1;
+}
+
+// one record per line, against splitting the lines and calling lept_parse_n on each
+static void bench_ndjson()
+{
+	buffer b = { NULL, 0, 0 };
+	char line[128];
+	for (unsigned i = 0; i < 1000000; i++)
+	{
+		sprintf(line, "{\"id\":%u,\"name\":\"record\",\"score\":%u.5,\"tags\":[true,null,\"t%u\"]}\n", i, i % 1000, i % 7);
+		buffer_puts(&b, line);
+	}
+	printf("ndjson: %.1f MB, 1M records\n", b.size / (1024.0 * 1024));
+	for (unsigned threads = 0; threads <= 16; threads = threads ? threads * 2 : 1)
+	{
+		size_t records = 0;
+		auto start = std::chrono::steady_clock::now();
+		if (threads)
+			lept_parse_ndjson(b.p, b.size, threads, count_record, &records);
+		else
+			for (const char *p = b.p, *nl; p != b.p + b.size; p = nl + 1)
+			{
+				lept_value v;
+				lept_init(&v);
+				nl = strchr(p, '\n');
+				if (lept_parse_n(&v, p, nl - p) == LEPT_PARSE_OK)
+					records++;
+				lept_free(&v);
+			}
+		double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		if (records != 1000000)
+		{
+			fprintf(stderr, "parse failed\n");
+			exit(1);
+		}
+		if (threads)
+			printf("  %2u threads %8.1f MB/s\n", threads, b.size / (1024.0 * 1024) / seconds);
+		else
+			printf("  per line   %8.1f MB/s\n", b.size / (1024.0 * 1024) / seconds);
+	}
+	free(b.p);
+}
+
+// wall time of the output of a large tree, threads 0 being lept_stringify
+static void bench_stringify_parallel()
+{
+	size_t length, n;
+	char* json = make_indented_json(1000000, 2, &length);
+	lept_value v;
+	lept_init(&v);
+	lept_parse(&v, json);
+	free(json);
+	json = lept_stringify(&v, &length);
+	free(json);
+	printf("stringify parallel: %.1f MB of output\n", length / (1024.0 * 1024));
+	for (unsigned threads = 0; threads <= 16; threads = threads ? threads * 2 : 1)
+	{
+		auto start = std::chrono::steady_clock::now();
+		for (int r = 0; r < 5; r++)
+			free(threads ? lept_stringify_parallel(&v, &n, threads) : lept_stringify(&v, &n));
+		double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		if (threads)
+			printf("  %2u threads %8.1f MB/s\n", threads, length * 5 / (1024.0 * 1024) / seconds);
+		else
+			printf("  serial     %8.1f MB/s\n", length * 5 / (1024.0 * 1024) / seconds);
+	}
+	lept_free(&v);
+}
+
+static void bench_shortest()
+{
+	const char* names[2] = { "random bits", "short decimals" };
+	uint64_t x = 88172645463325252ULL;
+	char number[32];
+	printf("shortest numbers: 1000000 doubles\n");
+	for (int kind = 0; kind < 2; kind++)
+	{
+		buffer b = { NULL, 0, 0 };
+		buffer_puts(&b, "[");
+		for (int i = 0; i < 1000000; i++)
+		{
+			double d;
+			do
+			{
+				x ^= x << 13;
+				x ^= x >> 7;
+				x ^= x << 17;
+				if (kind)
+					d = (x % 1000000) / 1000.0;
+				else
+					memcpy(&d, &x, sizeof(double));
+			} while (d != d || d - d != 0);
+			sprintf(number, i ? ",%.17g" : "%.17g", d);
+			buffer_puts(&b, number);
+		}
+		buffer_puts(&b, "]");
+		lept_value v;
+		lept_init(&v);
+		lept_parse(&v, b.p);
+		free(b.p);
+		for (int shortest = 1; shortest >= 0; shortest--)
+		{
+			size_t length;
+			lept_set_shortest_numbers(shortest);
+			clock_t start = clock();
+			for (int r = 0; r < 5; r++)
+				free(lept_stringify(&v, &length));
+			double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+			printf("  %-14s %-9s %6.1f M numbers/s %6.1f MB\n", names[kind], shortest ? "shortest" : "%.17g",
+				5 / seconds, length / (1024.0 * 1024));
+		}
+		lept_free(&v);
+	}
+	lept_set_shortest_numbers(1);
+}
+
+static void bench_tape()
+{
+	size_t length;
+	char* json = make_indented_json(20000, 0, &length);
+	printf("tape: %.1f MB\n", length / (1024.0 * 1024));
+	printf("  %-8s %8.1f MB/s\n", "tree", bench_parse(json, length, 20));
+	printf("  %-8s %8.1f MB/s\n", "tape", bench_parse_tape(json, length, 20));
+	free(json);
+}
+
+int main()
+{
+	bench_whitespace();
+	bench_strings();
+	bench_short_strings();
+	bench_large_object();
+	bench_numbers();
+	bench_indexed();
+	bench_tape();
+	bench_insitu();
+	bench_chunked();
+	bench_sax();
+	bench_reader();
+	bench_lazy();
+	bench_reuse();
+	bench_document();
+	bench_intern();
+	bench_footprint();
+	bench_packed();
+	bench_parallel();
+	bench_ndjson();
+	bench_stringify_parallel();
+	bench_shortest();
+	return 0;
+}
@@ -5,12 +5,35 @@
 
 #include "leptjson.h"
 #include <assert.h>  /* assert() */
-#include <errno.h>   /* errno, ERANGE */
-#include <math.h>    /* HUGE_VAL */
-#include <stdlib.h>  /* NULL, malloc(), realloc(), free(), strtod() */
-#include <string.h>  /* memcpy() */
+#include <float.h>   /* FLT_EVAL_METHOD */
+#include <math.h>    /* signbit(), isfinite() */
+#include <stdint.h>  /* uint64_t, int64_t */
+#include <stdlib.h>  /* NULL, malloc(), realloc(), free() */
+#include <string.h>  /* memcpy(), memmove(), memset() */
 #include <stdio.h>   // sprintf()
+#include <time.h>    /* time(), clock() */
+#include <atomic>    // std::atomic
+#include <condition_variable>  // std::condition_variable
+#include <mutex>     // std::mutex
+#include <system_error>  // std::system_error
+#include <new>       // placement new
+#include <thread>    // std::thread
+#include <vector>    // std::vector
 
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define LEPT_X86 1
+#include <emmintrin.h>  /* SSE2 */
+#include <immintrin.h>  /* AVX2 */
+#ifdef _MSC_VER
+#include <intrin.h>     /* __cpuid(), _BitScanForward() */
+#endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define LEPT_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define LEPT_TARGET_AVX2
+#endif
 
 #ifndef LEPT_PARSE_STACK_INIT_SIZE
 #define LEPT_PARSE_STACK_INIT_SIZE 256
@@ -20,17 +43,74 @@
 #define LEPT_PARSE_STRINGIFY_INIT_SIZE 256
 #endif
 
+#ifndef LEPT_PARSE_MAX_DEPTH
+#define LEPT_PARSE_MAX_DEPTH 1024
+#endif
+
+#ifndef LEPT_TREE_MAX_DEPTH
+#define LEPT_TREE_MAX_DEPTH 2048  // whatever lept_set_max_depth() allows, see lept_tree_depth()
+#endif
+
 #define EXPECT(c, ch)    do {assert(*(c->json)==(ch)); c->json++;}while(0)
 #define ISDIGIT(ch)      ((ch)>='0' && (ch)<='9')
 #define ISDIGIT1TO9(ch)  ((ch)>='1' && (ch)<='9')
+#define ISWHITESPACE(ch) ((ch)==' ' || (ch)=='\t' || (ch)=='\n' || (ch)=='\r')
 #define PUTC(c, ch)      do {*(char*)lept_context_push(c, sizeof(char)) = (ch);}while(0)
 #define PUTS(c, s, len)  memcpy(lept_context_push(c, len), s, len)
+#define CHAR_AT(p, end)  ((p) != (end) ? *(p) : '\0')  /* '\0' past the end of input */
+#define PEEK(c)          CHAR_AT((c)->json, (c)->end)
+
+static void* lept_default_malloc(void*, size_t size)
+{
+	return malloc(size);
+}
+
+static void* lept_default_realloc(void*, void* p, size_t size)
+{
+	return realloc(p, size);
+}
+
+static void lept_default_free(void*, void* p)
+{
+	free(p);
+}
+
+static const lept_allocator lept_default_allocator = {lept_default_malloc, lept_default_realloc, lept_default_free, NULL};
+static lept_allocator lept_allocator_in_use = {lept_default_malloc, lept_default_realloc, lept_default_free, NULL};
+
+// every allocation and release below goes through these
+#define LEPT_MALLOC(size)     lept_allocator_in_use.malloc_fn(lept_allocator_in_use.ctx, (size))
+#define LEPT_REALLOC(p, size) lept_allocator_in_use.realloc_fn(lept_allocator_in_use.ctx, (p), (size))
+#define LEPT_FREE(p)          lept_allocator_in_use.free_fn(lept_allocator_in_use.ctx, (p))
+
+/* lept_value::flags */
+#define LEPT_BORROWED      0x1  /* string: s points into the buffer given to lept_parse_insitu */
+#define LEPT_BORROWED_KEYS 0x2  /* object: so do all of its keys */
+#define LEPT_LAZY          0x4  /* array/object: only [src, src_end) is known, see lept_expand */
+#define LEPT_ARENA         0x8  /* any type: storage is in a lept_document's arena, see lept_home */
+#define LEPT_INLINE        0x10 /* string: characters are in sso, never in an arena */
+#define LEPT_PACKED        0x20 /* array: elements are the doubles in packed */
+
+// strings shorter than this are stored in place, with no allocation
+#define LEPT_INLINE_SIZE   (sizeof(((lept_value*)0)->sso))
+
+// for the array and object functions, which may be the first to look inside a lazy value
+#define EXPAND(v)        do {if ((v)->flags & LEPT_LAZY) lept_expand(const_cast<lept_value*>(v));} while(0)
+// for the array functions that add elements
+#define UNPACK(v)        do {if ((v)->flags & LEPT_PACKED) lept_unpack(v);} while(0)
+// for the others that change an array: a packed one whose elements were handed out goes on with those
+#define SETTLE(v)        do {if (((v)->flags & LEPT_PACKED) && lept_packed_view(v) != NULL) lept_unpack(v);} while(0)
+
+#ifndef LEPT_PACK_MIN
+#define LEPT_PACK_MIN 16
+#endif
 
 struct lept_context
 {
-	const char* json;
+	const char *json, *end;   // input is [json, end), it need not be null-terminated
 	char* stack;
 	size_t size, top;
+	int insitu;               // json is the caller's mutable buffer, strings are left in it
 };
 
 static void* lept_context_push(lept_context* c, size_t size)
@@ -43,7 +123,7 @@ static void* lept_context_push(lept_context* c, size_t size)
 			c->size = LEPT_PARSE_STACK_INIT_SIZE;
 		while (c->top + size >= c->size)
 			c->size += c->size >> 1;  /* c->size * 1.5 */
-		c->stack = (char*)realloc(c->stack, c->size);
+		c->stack = (char*)LEPT_REALLOC(c->stack, c->size);
 	}
 	ret = c->stack + c->top;
 	c->top += size;
@@ -56,346 +136,4075 @@ static void* lept_context_pop(lept_context* c, size_t size)
 	return c->stack + (c->top -= size);
 }
 
-static void lept_parse_whitespace(lept_context* c)
+/* document arena: blocks are only ever bumped, and freed all together. Every allocation made for a
+   value of the document (string, elements, members, key) is preceded by the document's address,
+   so the array/object functions find where to grow without a parameter. */
+
+#ifndef LEPT_ARENA_BLOCK_SIZE
+#define LEPT_ARENA_BLOCK_SIZE 4096
+#endif
+
+struct lept_arena_block
 {
-	const char* p = c->json;
-	while (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')
-		p++;
-	c->json = p;
+	lept_arena_block* next;   // the block filled before this one
+	size_t size, used;        // bytes of data after this header
+};
+
+// an interned key, its characters are in the arena
+struct lept_key_entry
+{
+	const char* k;            // NULL for an empty slot
+	size_t klen;
+	uint32_t hash;
+};
+
+struct lept_document
+{
+	lept_value root;
+	lept_arena_block* blocks; // newest first
+	lept_key_entry* keys;     // open addressing, key_capacity is a power of two
+	size_t key_count, key_capacity;
+	int intern;               // lept_document_set_intern_keys
+};
+
+#define LEPT_ARENA_ALIGN(n) (((n) + 7) & ~static_cast<size_t>(7))
+
+// size bytes from d's arena, or from the allocator when d is NULL
+static void* lept_alloc(lept_document* d, size_t size)
+{
+	lept_arena_block* b;
+	lept_document** p;
+	if (d == NULL)
+		return LEPT_MALLOC(size);
+	size = LEPT_ARENA_ALIGN(size) + sizeof(lept_document*);
+	b = d->blocks;
+	if (b == NULL || b->size - b->used < size)
+	{
+		size_t bsize = b != NULL ? b->size * 2 : LEPT_ARENA_BLOCK_SIZE;
+		while (bsize < size)
+			bsize *= 2;
+		b = static_cast<lept_arena_block*>(LEPT_MALLOC(sizeof(lept_arena_block) + bsize));
+		b->next = d->blocks;
+		b->size = bsize;
+		b->used = 0;
+		d->blocks = b;
+	}
+	p = reinterpret_cast<lept_document**>(reinterpret_cast<char*>(b + 1) + b->used);
+	b->used += size;
+	*p = d;
+	return p + 1;
 }
 
-static int lept_parse_literal(lept_context* c, lept_value* v, const char* literal, lept_type type)
+// p of old_size bytes resized to size; an arena leaves the old bytes where they are
+static void* lept_realloc(lept_document* d, void* p, size_t old_size, size_t size)
+{
+	void* ret;
+	if (d == NULL)
+		return LEPT_REALLOC(p, size);
+	ret = lept_alloc(d, size);
+	memcpy(ret, p, old_size < size ? old_size : size);
+	return ret;
+}
+
+#define LEPT_ARENA_OWNER(p) (static_cast<lept_document* const*>(static_cast<const void*>(p))[-1])
+
+/* element and member arrays. The compact lept_value has no room for a capacity, so there it is
+   written in front of the items, after the arena owner: [owner][capacity][items...] */
+
+#ifdef LEPT_COMPACT
+#define LEPT_ITEMS_HEADER       sizeof(size_t)
+#define LEPT_CAPACITY(p)        ((p) != NULL ? static_cast<const size_t*>(static_cast<const void*>(p))[-1] : 0)
+#define LEPT_E_CAPACITY(v)      LEPT_CAPACITY((v)->e)
+#define LEPT_M_CAPACITY(v)      LEPT_CAPACITY((v)->m)
+#define LEPT_SET_E_CAPACITY(v, n)
+#define LEPT_SET_M_CAPACITY(v, n)
+#define LEPT_SRC_END(v)         ((v)->src + (v)->src_len)
+#define LEPT_SET_SRC(v, b, end) do {(v)->src = (b); (v)->src_len = static_cast<uint32_t>((end) - (b));} while(0)
+#define LEPT_COUNT_MAX          UINT32_MAX
+#else
+#define LEPT_ITEMS_HEADER       0
+#define LEPT_E_CAPACITY(v)      ((v)->e_capacity)
+#define LEPT_M_CAPACITY(v)      ((v)->m_capacity)
+#define LEPT_SET_E_CAPACITY(v, n) ((v)->e_capacity = (n))
+#define LEPT_SET_M_CAPACITY(v, n) ((v)->m_capacity = (n))
+#define LEPT_SRC_END(v)         ((v)->src_end)
+#define LEPT_SET_SRC(v, b, end) do {(v)->src = (b); (v)->src_end = (end);} while(0)
+#define LEPT_COUNT_MAX          SIZE_MAX
+#endif
+
+#define LEPT_ITEMS_OWNER(p) LEPT_ARENA_OWNER(static_cast<const char*>(static_cast<const void*>(p)) - LEPT_ITEMS_HEADER)
+
+// room for capacity items taking bytes in all, from d or the heap
+static void* lept_alloc_items(lept_document* d, size_t capacity, size_t bytes)
+{
+	char* p = static_cast<char*>(lept_alloc(d, LEPT_ITEMS_HEADER + bytes));
+	assert(capacity <= LEPT_COUNT_MAX);
+#ifdef LEPT_COMPACT
+	*reinterpret_cast<size_t*>(p) = capacity;
+#else
+	(void)capacity;
+#endif
+	return p + LEPT_ITEMS_HEADER;
+}
+
+// items resized to capacity, the first used bytes are kept
+static void* lept_realloc_items(lept_document* d, void* items, size_t used, size_t capacity, size_t bytes)
+{
+	char* p;
+	if (items == NULL)
+		return lept_alloc_items(d, capacity, bytes);
+	p = static_cast<char*>(lept_realloc(d, static_cast<char*>(items) - LEPT_ITEMS_HEADER, LEPT_ITEMS_HEADER + used, LEPT_ITEMS_HEADER + bytes));
+	assert(capacity <= LEPT_COUNT_MAX);
+#ifdef LEPT_COMPACT
+	*reinterpret_cast<size_t*>(p) = capacity;
+#endif
+	return p + LEPT_ITEMS_HEADER;
+}
+
+static void lept_free_items(void* items)
+{
+	if (items != NULL)
+		LEPT_FREE(static_cast<char*>(items) - LEPT_ITEMS_HEADER);
+}
+
+// the document of a null, boolean or number
+static lept_document* lept_get_doc(const lept_value* v)
+{
+#ifdef LEPT_COMPACT
+	return reinterpret_cast<lept_document*>(static_cast<uintptr_t>(v->doc_lo | static_cast<uint64_t>(v->doc_hi) << 32));
+#else
+	return v->doc;
+#endif
+}
+
+static void lept_set_doc(lept_value* v, lept_document* d)
+{
+#ifdef LEPT_COMPACT
+	uint64_t a = reinterpret_cast<uintptr_t>(d);
+	assert(a >> 48 == 0);
+	v->doc_lo = static_cast<uint32_t>(a);
+	v->doc_hi = static_cast<uint16_t>(a >> 32);
+#else
+	v->doc = d;
+#endif
+}
+
+// the document v belongs to, NULL for a value on the heap
+static lept_document* lept_home(const lept_value* v)
+{
+	if (!(v->flags & LEPT_ARENA))
+		return NULL;
+	switch (v->type)
+	{
+	case LEPT_STRING: return LEPT_ARENA_OWNER(v->s);
+	case LEPT_ARRAY:  return LEPT_ITEMS_OWNER(v->e);
+	case LEPT_OBJECT: return LEPT_ITEMS_OWNER(v->m);
+	default:          return lept_get_doc(v);
+	}
+}
+
+// lept_init for a value that is to live in d (or on the heap when d is NULL)
+static void lept_init_home(lept_value* v, lept_document* d)
+{
+	v->type = LEPT_NULL;
+	v->flags = d != NULL ? LEPT_ARENA : 0;
+	lept_set_doc(v, d);
+}
+
+/* packed arrays: the doubles are followed in their block by a slot for the view, the lept_values
+   lept_get_array_element hands out for them. A reader through a const pointer makes the view once,
+   under a lock, and never touches the doubles, so the other readers (stringify, lept_is_equal, the
+   threads of lept_stringify_parallel) may go on at the same time; they read the view when there is
+   one, as its elements may have been changed. A function that changes the array settles it first,
+   the view becoming its elements. There is a slot only for a capacity above 0, and so a view. */
+
+#define LEPT_PACKED_BYTES(capacity) ((capacity) * sizeof(double) + sizeof(std::atomic<lept_value*>))
+
+static std::mutex lept_view_mutex;
+
+static std::atomic<lept_value*>* lept_view_slot(const lept_value* v)
+{
+	return reinterpret_cast<std::atomic<lept_value*>*>(v->packed + LEPT_E_CAPACITY(v));
+}
+
+// once the capacity of a packed array is set
+static void lept_init_view_slot(lept_value* v)
+{
+	if (LEPT_E_CAPACITY(v) > 0)
+		new (lept_view_slot(v)) std::atomic<lept_value*>(NULL);
+}
+
+static lept_value* lept_packed_view(const lept_value* v)
+{
+	return LEPT_E_CAPACITY(v) > 0 ? lept_view_slot(v)->load(std::memory_order_acquire) : NULL;
+}
+
+// the view, made by whichever reader comes first, in the array's home and with its capacity
+static lept_value* lept_make_view(const lept_value* v)
 {
+	std::lock_guard<std::mutex> lock(lept_view_mutex);
+	std::atomic<lept_value*>* slot = lept_view_slot(v);
+	lept_value* view = slot->load(std::memory_order_relaxed);
+	if (view == NULL)
+	{
+		lept_document* home = lept_home(v);
+		size_t capacity = LEPT_E_CAPACITY(v);
+		view = static_cast<lept_value*>(lept_alloc_items(home, capacity, capacity * sizeof(lept_value)));
+		for (size_t i = 0; i < v->size; i++)
+		{
+			lept_init_home(&view[i], home);
+			lept_set_number(&view[i], v->packed[i]);
+		}
+		slot->store(view, std::memory_order_release);
+	}
+	return view;
+}
+
+// the elements of an expanded array as lept_values: its own, or the view of a packed one (maybe NULL)
+static const lept_value* lept_array_values(const lept_value* v)
+{
+	return v->flags & LEPT_PACKED ? lept_packed_view(v) : v->e;
+}
+
+static void lept_unpack(lept_value* v);
+
+#ifndef LEPT_INTERN_INIT_SIZE
+#define LEPT_INTERN_INIT_SIZE 64
+#endif
+
+/* keys are hashed with SipHash-1-3 under a seed picked at startup, so that nobody can prepare a set
+   of keys that all land on one slot of an intern table or object index */
+
+static uint64_t lept_mix64(uint64_t x)
+{
+	x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+	x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+	return x ^ (x >> 31);
+}
+
+// the time and the addresses of a local and of the code, which move with ASLR
+static uint64_t lept_random_seed(uint64_t n)
+{
+	uint64_t x = static_cast<uint64_t>(time(NULL));
+	x = lept_mix64(x ^ (static_cast<uint64_t>(clock()) << 20) ^ reinterpret_cast<uintptr_t>(&x));
+	x = lept_mix64(x ^ reinterpret_cast<uintptr_t>(&lept_random_seed));
+	return lept_mix64(x + n * 0x9e3779b97f4a7c15ull);
+}
+
+static const uint64_t lept_hash_seed[2] = {lept_random_seed(1), lept_random_seed(2)};
+
+#define LEPT_ROTL(x, b) (((x) << (b)) | ((x) >> (64 - (b))))
+#define LEPT_SIPROUND(v0, v1, v2, v3) do {\
+		v0 += v1; v1 = LEPT_ROTL(v1, 13); v1 ^= v0; v0 = LEPT_ROTL(v0, 32);\
+		v2 += v3; v3 = LEPT_ROTL(v3, 16); v3 ^= v2;\
+		v0 += v3; v3 = LEPT_ROTL(v3, 21); v3 ^= v0;\
+		v2 += v1; v1 = LEPT_ROTL(v1, 17); v1 ^= v2; v2 = LEPT_ROTL(v2, 32);\
+	} while (0)
+
+static uint32_t lept_hash_key(const char* k, size_t klen)
+{
+	uint64_t v0 = 0x736f6d6570736575ull ^ lept_hash_seed[0];
+	uint64_t v1 = 0x646f72616e646f6dull ^ lept_hash_seed[1];
+	uint64_t v2 = 0x6c7967656e657261ull ^ lept_hash_seed[0];
+	uint64_t v3 = 0x7465646279746573ull ^ lept_hash_seed[1];
+	uint64_t m, last = static_cast<uint64_t>(klen) << 56;
+	const unsigned char* p = reinterpret_cast<const unsigned char*>(k);
 	size_t i;
-	EXPECT(c, literal[0]);
-	for (i = 0; literal[i + 1]; i++)
+	for (i = 0; i + 8 <= klen; i += 8)
 	{
-		if (c->json[i] != literal[i + 1])
-			return LEPT_PARSE_INVALID_VALUE;
+		memcpy(&m, p + i, 8);
+		v3 ^= m;
+		LEPT_SIPROUND(v0, v1, v2, v3);
+		v0 ^= m;
 	}
-	c->json += i;
-	v->type = type;
-	return LEPT_PARSE_OK;
+	for (size_t j = 0; i + j < klen; j++)
+		last |= static_cast<uint64_t>(p[i + j]) << (8 * j);
+	v3 ^= last;
+	LEPT_SIPROUND(v0, v1, v2, v3);
+	v0 ^= last;
+	v2 ^= 0xff;
+	LEPT_SIPROUND(v0, v1, v2, v3);
+	LEPT_SIPROUND(v0, v1, v2, v3);
+	LEPT_SIPROUND(v0, v1, v2, v3);
+	return static_cast<uint32_t>(v0 ^ v1 ^ v2 ^ v3);
 }
 
-static int lept_parse_number(lept_context* c, lept_value* v)
+// the one copy of k kept in d's arena; it lives as long as the arena, so any number of members share it
+static char* lept_intern_key(lept_document* d, const char* k, size_t klen)
 {
-	const char* p = c->json;
-	if (*p == '-')
-		p++;
-	if (*p == '0')
-		p++;
+	uint32_t h = lept_hash_key(k, klen);
+	size_t i, mask;
+	lept_key_entry* e;
+	if (2 * (d->key_count + 1) > d->key_capacity)
+	{
+		lept_key_entry* old = d->keys;
+		size_t old_capacity = d->key_capacity;
+		d->key_capacity = old_capacity ? old_capacity * 2 : LEPT_INTERN_INIT_SIZE;
+		d->keys = static_cast<lept_key_entry*>(LEPT_MALLOC(d->key_capacity * sizeof(lept_key_entry)));
+		memset(d->keys, 0, d->key_capacity * sizeof(lept_key_entry));
+		mask = d->key_capacity - 1;
+		for (i = 0; i < old_capacity; i++)
+		{
+			if (old[i].k == NULL)
+				continue;
+			for (e = &d->keys[old[i].hash & mask]; e->k != NULL; e = &d->keys[(e - d->keys + 1) & mask])
+				;
+			*e = old[i];
+		}
+		LEPT_FREE(old);
+	}
+	mask = d->key_capacity - 1;
+	for (i = h & mask; d->keys[i].k != NULL; i = (i + 1) & mask)
+	{
+		e = &d->keys[i];
+		if (e->hash == h && e->klen == klen && memcmp(e->k, k, klen) == 0)
+			return const_cast<char*>(e->k);
+	}
+	e = &d->keys[i];
+	char* copy = static_cast<char*>(lept_alloc(d, klen + 1));
+	memcpy(copy, k, klen);
+	copy[klen] = '\0';
+	e->k = copy;
+	e->klen = klen;
+	e->hash = h;
+	d->key_count++;
+	return copy;
+}
+
+// a member key for an object living in d, shared with the other members of that name when d interns
+static char* lept_alloc_key(lept_document* d, const char* k, size_t klen)
+{
+	char* copy;
+	if (d != NULL && d->intern)
+		return lept_intern_key(d, k, klen);
+	copy = static_cast<char*>(lept_alloc(d, klen + 1));
+	memcpy(copy, k, klen);
+	copy[klen] = '\0';
+	return copy;
+}
+
+/* hash index of a large object. Once an object has room for LEPT_OBJECT_INDEX_MIN members, its member
+   array ends with one more pointer, to the index; the parsers build it for objects of that many members,
+   lept_set_object_value when it gets there, and lept_remove_object_value keeps it current. Lookups only
+   read it, so concurrent lookups through const pointers are safe. The members stay in insertion order. */
+
+#ifndef LEPT_OBJECT_INDEX_MIN
+#define LEPT_OBJECT_INDEX_MIN 16
+#endif
+
+struct lept_index_entry
+{
+	uint32_t hash;
+	uint32_t pos;             // member index + 1, 0 for an empty slot
+};
+
+struct lept_object_index
+{
+	size_t capacity;          // entries after this header, a power of two at least twice the members
+};
+
+#define LEPT_INDEX_ENTRIES(x) reinterpret_cast<lept_index_entry*>((x) + 1)
+
+// bytes of a member array with room for capacity members
+static size_t lept_members_size(size_t capacity)
+{
+	return capacity * sizeof(lept_member) + (capacity >= LEPT_OBJECT_INDEX_MIN ? sizeof(lept_object_index*) : 0);
+}
+
+// where v keeps its index, NULL while v has no room for one
+static lept_object_index** lept_index_slot(const lept_value* v)
+{
+	if (LEPT_M_CAPACITY(v) < LEPT_OBJECT_INDEX_MIN)
+		return NULL;
+	return reinterpret_cast<lept_object_index**>(v->m + LEPT_M_CAPACITY(v));
+}
+
+static void lept_index_add(lept_object_index* x, uint32_t hash, size_t index)
+{
+	lept_index_entry* e = LEPT_INDEX_ENTRIES(x);
+	size_t mask = x->capacity - 1, i;
+	assert(index < UINT32_MAX);
+	for (i = hash & mask; e[i].pos != 0; i = (i + 1) & mask)
+		;
+	e[i].hash = hash;
+	e[i].pos = static_cast<uint32_t>(index + 1);
+}
+
+// a new index for v with room for size members; the entries of old are moved over, the hashes kept
+static lept_object_index* lept_index_resize(lept_value* v, size_t size, lept_object_index* old)
+{
+	lept_document* home = lept_home(v);
+	size_t capacity = 2 * LEPT_OBJECT_INDEX_MIN;
+	lept_object_index* x;
+	while (capacity < 2 * size)
+		capacity *= 2;
+	x = static_cast<lept_object_index*>(lept_alloc(home, sizeof(lept_object_index) + capacity * sizeof(lept_index_entry)));
+	x->capacity = capacity;
+	memset(LEPT_INDEX_ENTRIES(x), 0, capacity * sizeof(lept_index_entry));
+	if (old == NULL)
+	{
+		for (size_t i = 0; i < v->msize; i++)
+			lept_index_add(x, lept_hash_key(v->m[i].k, v->m[i].klen), i);
+	}
 	else
 	{
-		if (!ISDIGIT(*p))
-			return LEPT_PARSE_INVALID_VALUE;
-		do p++; while (ISDIGIT(*p));
+		for (size_t i = 0; i < old->capacity; i++)
+			if (LEPT_INDEX_ENTRIES(old)[i].pos != 0)
+				lept_index_add(x, LEPT_INDEX_ENTRIES(old)[i].hash, LEPT_INDEX_ENTRIES(old)[i].pos - 1);
+		if (home == NULL)
+			LEPT_FREE(old);
 	}
-	if (*p == '.')
+	*lept_index_slot(v) = x;
+	return x;
+}
+
+// gives v its index once it has enough members; only called by functions that may modify v
+static void lept_index_build(lept_value* v)
+{
+	if (v->msize >= LEPT_OBJECT_INDEX_MIN && *lept_index_slot(v) == NULL)
+		lept_index_resize(v, v->msize, NULL);
+}
+
+static size_t lept_index_find(const lept_value* v, const char* key, size_t klen)
+{
+	lept_object_index* x = *lept_index_slot(v);
+	const lept_index_entry* e = LEPT_INDEX_ENTRIES(x);
+	uint32_t hash = lept_hash_key(key, klen);
+	size_t mask = x->capacity - 1;
+	for (size_t i = hash & mask; e[i].pos != 0; i = (i + 1) & mask)
 	{
-		p++;
-		if (!ISDIGIT(*p))
-			return LEPT_PARSE_INVALID_VALUE;
-		do p++; while (ISDIGIT(*p));
+		const lept_member* m = &v->m[e[i].pos - 1];
+		if (e[i].hash == hash && m->klen == klen && (m->k == key || memcmp(m->k, key, klen) == 0))
+			return e[i].pos - 1;
+	}
+	return LEPT_KEY_NOT_EXIST;
+}
+
+// the entry of member index, which is in x
+static size_t lept_index_entry_of(const lept_value* v, lept_object_index* x, size_t index)
+{
+	const lept_index_entry* e = LEPT_INDEX_ENTRIES(x);
+	size_t mask = x->capacity - 1, i;
+	for (i = lept_hash_key(v->m[index].k, v->m[index].klen) & mask; e[i].pos != index + 1; i = (i + 1) & mask)
+		;
+	return i;
+}
+
+// forgets member index of v, and renumbers the members after it, which are about to move down by
+// one: each is found from its key, so the cost is that of moving them, bounded by one pass over the index
+static void lept_index_remove(const lept_value* v, lept_object_index* x, size_t index)
+{
+	lept_index_entry* e = LEPT_INDEX_ENTRIES(x);
+	size_t mask = x->capacity - 1, i, j, ideal;
+	i = lept_index_entry_of(v, x, index);
+	// backward shift: pull up every later entry of the run that may no longer be reached past the hole
+	for (j = (i + 1) & mask; e[j].pos != 0; j = (j + 1) & mask)
+	{
+		ideal = e[j].hash & mask;
+		if (i <= j ? (ideal <= i || ideal > j) : (ideal <= i && ideal > j))
+		{
+			e[i] = e[j];
+			i = j;
+		}
 	}
-	if (*p == 'e' || *p == 'E')
+	e[i].pos = 0;
+	// when most of the members move, one pass over the entries is cheaper than hashing each key
+	if ((v->msize - index - 1) * 4 > x->capacity)
 	{
+		for (j = 0; j <= mask; j++)
+			if (e[j].pos > index + 1)
+				e[j].pos--;
+		return;
+	}
+	// in increasing order, so that only member j has position j + 1 when it is looked for
+	for (j = index + 1; j < v->msize; j++)
+		e[lept_index_entry_of(v, x, j)].pos--;
+}
+
+// drops the index of v, it is rebuilt by the next lookup
+static void lept_index_free(lept_value* v)
+{
+	lept_object_index** slot = lept_index_slot(v);
+	if (slot == NULL || *slot == NULL)
+		return;
+	if (!(v->flags & LEPT_ARENA))
+		LEPT_FREE(*slot);
+	*slot = NULL;
+}
+
+static unsigned lept_ctz(unsigned x)
+{
+	assert(x != 0);
+#ifdef _MSC_VER
+	unsigned long i;
+	_BitScanForward(&i, x);
+	return i;
+#else
+	return __builtin_ctz(x);
+#endif
+}
+
+static const char* lept_skip_whitespace_scalar(const char* p, const char* end)
+{
+	while (p != end && ISWHITESPACE(*p))
 		p++;
-		if (*p == '+' || *p == '-')
-			p++;
-		do p++; while (ISDIGIT(*p));
+	return p;
+}
+
+static const char* lept_scan_string_scalar(const char* p, const char* end)
+{
+	while (p != end && *p != '\"' && *p != '\\' && static_cast<unsigned char>(*p) >= 0x20)
+		p++;
+	return p;
+}
+
+// one bit per byte of a 64-byte block, for the structural index of lept_parse_indexed
+struct lept_block
+{
+	uint64_t backslash, quote, whitespace, op;
+};
+
+static void lept_classify_scalar(const char* p, lept_block* b)
+{
+	b->backslash = b->quote = b->whitespace = b->op = 0;
+	for (int i = 0; i < 64; i++)
+	{
+		uint64_t bit = static_cast<uint64_t>(1) << i;
+		switch (p[i])
+		{
+		case '\\': b->backslash |= bit; break;
+		case '\"': b->quote |= bit; break;
+		case ' ': case '\t': case '\n': case '\r': b->whitespace |= bit; break;
+		case '{': case '}': case '[': case ']': case ':': case ',': b->op |= bit; break;
+		}
 	}
-	errno = 0;
-	v->n = strtod(c->json, NULL);
-	if (errno == ERANGE && abs(v->n) == HUGE_VAL)
-		return LEPT_PARSE_NUMBER_TOO_BIG;
-	v->type = LEPT_NUMBER;
-	c->json = p;
-	return LEPT_PARSE_OK;
 }
 
-static const char* lept_parse_hex4(const char* p, unsigned* u)
+#ifdef LEPT_X86
+// The vector loops load whole blocks from p on while they fit before end, and leave the last
+// partial block to the scalar loop, so no byte outside [p, end) is ever read.
+static const char* lept_skip_whitespace_sse2(const char* p, const char* end)
 {
-	int i;
-	*u = 0;
-	for (i = 0; i < 4; i++)
+	const __m128i sp = _mm_set1_epi8(' '), ht = _mm_set1_epi8('\t');
+	const __m128i lf = _mm_set1_epi8('\n'), cr = _mm_set1_epi8('\r');
+	for (; end - p >= 16; p += 16)
 	{
-		char ch = *p++;
-		*u <<= 4;
-		if      (ch >= '0' && ch <= '9') *u |= ch - '0';
-		else if (ch >= 'A' && ch <= 'F') *u |= ch - 'A' + 10;
-		else if (ch >= 'a' && ch <= 'f') *u |= ch - 'a' + 10;
-		else return NULL;
+		__m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+		__m128i ws = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(x, sp), _mm_cmpeq_epi8(x, ht)),
+		                          _mm_or_si128(_mm_cmpeq_epi8(x, lf), _mm_cmpeq_epi8(x, cr)));
+		unsigned mask = ~static_cast<unsigned>(_mm_movemask_epi8(ws)) & 0xFFFF;
+		if (mask)
+			return p + lept_ctz(mask);
 	}
-	return p;
+	return lept_skip_whitespace_scalar(p, end);
 }
 
-static void lept_encode_utf8(lept_context* c, unsigned u)
+LEPT_TARGET_AVX2
+static const char* lept_skip_whitespace_avx2(const char* p, const char* end)
 {
-	if (u <= 0x7F)
-		PUTC(c, u & 0xFF);
-	else if (u <= 0x7FF)
+	const __m256i sp = _mm256_set1_epi8(' '), ht = _mm256_set1_epi8('\t');
+	const __m256i lf = _mm256_set1_epi8('\n'), cr = _mm256_set1_epi8('\r');
+	for (; end - p >= 32; p += 32)
 	{
-		PUTC(c, 0xC0 | ((u >> 6) & 0xFF));
-		PUTC(c, 0x80 | ( u       & 0x3F));
+		__m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+		__m256i ws = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(x, sp), _mm256_cmpeq_epi8(x, ht)),
+		                             _mm256_or_si256(_mm256_cmpeq_epi8(x, lf), _mm256_cmpeq_epi8(x, cr)));
+		unsigned mask = ~static_cast<unsigned>(_mm256_movemask_epi8(ws));
+		if (mask)
+			return p + lept_ctz(mask);
 	}
-	else if (u <= 0xFFFF)
+	return lept_skip_whitespace_scalar(p, end);
+}
+
+// Stops at the first '\"', '\\' or control character, or at end.
+static const char* lept_scan_string_sse2(const char* p, const char* end)
+{
+	const __m128i quote = _mm_set1_epi8('\"'), backslash = _mm_set1_epi8('\\'), ctrl = _mm_set1_epi8(0x1F);
+	for (; end - p >= 16; p += 16)
 	{
-		PUTC(c, 0xE0 | ((u >> 12) & 0xFF));
-		PUTC(c, 0x80 | ((u >>  6) & 0x3F));
-		PUTC(c, 0x80 | ( u        & 0x3F));
+		__m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+		__m128i stop = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(x, quote), _mm_cmpeq_epi8(x, backslash)),
+		                            _mm_cmpeq_epi8(_mm_max_epu8(x, ctrl), ctrl));  /* x <= 0x1F */
+		unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(stop));
+		if (mask)
+			return p + lept_ctz(mask);
 	}
-	else
+	return lept_scan_string_scalar(p, end);
+}
+
+LEPT_TARGET_AVX2
+static const char* lept_scan_string_avx2(const char* p, const char* end)
+{
+	const __m256i quote = _mm256_set1_epi8('\"'), backslash = _mm256_set1_epi8('\\'), ctrl = _mm256_set1_epi8(0x1F);
+	for (; end - p >= 32; p += 32)
 	{
-		assert(u <= 0x10FFFF);
-		PUTC(c, 0xF0 | ((u >> 18) & 0xFF));
-		PUTC(c, 0x80 | ((u >> 12) & 0x3F));
-		PUTC(c, 0x80 | ((u >>  6) & 0x3F));
-		PUTC(c, 0x80 | ( u        & 0x3F));
+		__m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+		__m256i stop = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(x, quote), _mm256_cmpeq_epi8(x, backslash)),
+		                               _mm256_cmpeq_epi8(_mm256_max_epu8(x, ctrl), ctrl));
+		unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(stop));
+		if (mask)
+			return p + lept_ctz(mask);
 	}
+	return lept_scan_string_scalar(p, end);
 }
 
-#define STRING_ERROR(ret) do {c->top = head; return ret;}while(0)
+// '[' and ']' are '{' and '}' without bit 0x20, so four compares find the six operators
+static void lept_classify_sse2(const char* p, lept_block* b)
+{
+	const __m128i backslash = _mm_set1_epi8('\\'), quote = _mm_set1_epi8('\"');
+	const __m128i sp = _mm_set1_epi8(' '), ht = _mm_set1_epi8('\t');
+	const __m128i lf = _mm_set1_epi8('\n'), cr = _mm_set1_epi8('\r');
+	const __m128i lower = _mm_set1_epi8(0x20), lbrace = _mm_set1_epi8('{'), rbrace = _mm_set1_epi8('}');
+	const __m128i colon = _mm_set1_epi8(':'), comma = _mm_set1_epi8(',');
+	b->backslash = b->quote = b->whitespace = b->op = 0;
+	for (int i = 0; i < 64; i += 16)
+	{
+		__m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+		__m128i folded = _mm_or_si128(x, lower);
+		__m128i ws = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(x, sp), _mm_cmpeq_epi8(x, ht)),
+		                          _mm_or_si128(_mm_cmpeq_epi8(x, lf), _mm_cmpeq_epi8(x, cr)));
+		__m128i op = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(folded, lbrace), _mm_cmpeq_epi8(folded, rbrace)),
+		                          _mm_or_si128(_mm_cmpeq_epi8(x, colon), _mm_cmpeq_epi8(x, comma)));
+		b->backslash |= static_cast<uint64_t>(static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(x, backslash)))) << i;
+		b->quote |= static_cast<uint64_t>(static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(x, quote)))) << i;
+		b->whitespace |= static_cast<uint64_t>(static_cast<unsigned>(_mm_movemask_epi8(ws))) << i;
+		b->op |= static_cast<uint64_t>(static_cast<unsigned>(_mm_movemask_epi8(op))) << i;
+	}
+}
 
-static int lept_parse_string_raw(lept_context* c, char** str, size_t* len)
+LEPT_TARGET_AVX2
+static void lept_classify_avx2(const char* p, lept_block* b)
 {
-	size_t head = c->top;
-	unsigned u, u2; // for unicode to utf8
-	const char* p;
-	EXPECT(c, '\"');
-	p = c->json;
-	while (1)
+	const __m256i backslash = _mm256_set1_epi8('\\'), quote = _mm256_set1_epi8('\"');
+	const __m256i sp = _mm256_set1_epi8(' '), ht = _mm256_set1_epi8('\t');
+	const __m256i lf = _mm256_set1_epi8('\n'), cr = _mm256_set1_epi8('\r');
+	const __m256i lower = _mm256_set1_epi8(0x20), lbrace = _mm256_set1_epi8('{'), rbrace = _mm256_set1_epi8('}');
+	const __m256i colon = _mm256_set1_epi8(':'), comma = _mm256_set1_epi8(',');
+	b->backslash = b->quote = b->whitespace = b->op = 0;
+	for (int i = 0; i < 64; i += 32)
 	{
-		char ch = *p++;
+		__m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+		__m256i folded = _mm256_or_si256(x, lower);
+		__m256i ws = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(x, sp), _mm256_cmpeq_epi8(x, ht)),
+		                             _mm256_or_si256(_mm256_cmpeq_epi8(x, lf), _mm256_cmpeq_epi8(x, cr)));
+		__m256i op = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(folded, lbrace), _mm256_cmpeq_epi8(folded, rbrace)),
+		                             _mm256_or_si256(_mm256_cmpeq_epi8(x, colon), _mm256_cmpeq_epi8(x, comma)));
+		b->backslash |= static_cast<uint64_t>(static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, backslash)))) << i;
+		b->quote |= static_cast<uint64_t>(static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, quote)))) << i;
+		b->whitespace |= static_cast<uint64_t>(static_cast<unsigned>(_mm256_movemask_epi8(ws))) << i;
+		b->op |= static_cast<uint64_t>(static_cast<unsigned>(_mm256_movemask_epi8(op))) << i;
+	}
+}
+
+static int lept_cpu_has_avx2()
+{
+#ifdef _MSC_VER
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] < 7)
+		return 0;
+	__cpuid(info, 1);
+	if ((info[2] & (1 << 27)) == 0 || (_xgetbv(0) & 6) != 6)  /* OSXSAVE, YMM state enabled */
+		return 0;
+	__cpuidex(info, 7, 0);
+	return (info[1] & (1 << 5)) != 0;
+#else
+	return __builtin_cpu_supports("avx2");
+#endif
+}
+
+static int lept_cpu_has_sse2()
+{
+#if defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__)
+	return 1;
+#elif defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 1);
+	return (info[3] & (1 << 26)) != 0;
+#else
+	return __builtin_cpu_supports("sse2");
+#endif
+}
+#endif
+
+// the scanning functions of one level, swapped as a whole through one atomic pointer so that
+// parsers on other threads see either the old set or the new one
+struct lept_simd_ops
+{
+	lept_simd level;
+	const char* (*skip_whitespace)(const char*, const char*);
+	const char* (*scan_string)(const char*, const char*);
+	void (*classify)(const char*, lept_block*);
+};
+
+static const lept_simd_ops lept_simd_ops_none = {LEPT_SIMD_NONE, lept_skip_whitespace_scalar, lept_scan_string_scalar, lept_classify_scalar};
+#ifdef LEPT_X86
+static const lept_simd_ops lept_simd_ops_sse2 = {LEPT_SIMD_SSE2, lept_skip_whitespace_sse2, lept_scan_string_sse2, lept_classify_sse2};
+static const lept_simd_ops lept_simd_ops_avx2 = {LEPT_SIMD_AVX2, lept_skip_whitespace_avx2, lept_scan_string_avx2, lept_classify_avx2};
+#endif
+static std::atomic<const lept_simd_ops*> lept_simd_in_use(NULL);  // NULL until the first parse or lept_set_simd
+
+static lept_simd lept_simd_supported()
+{
+#ifdef LEPT_X86
+	if (lept_cpu_has_avx2())
+		return LEPT_SIMD_AVX2;
+	if (lept_cpu_has_sse2())
+		return LEPT_SIMD_SSE2;
+#endif
+	return LEPT_SIMD_NONE;
+}
+
+static const lept_simd_ops* lept_simd_ops_for(lept_simd level)
+{
+	switch (level)
+	{
+#ifdef LEPT_X86
+	case LEPT_SIMD_AVX2: return &lept_simd_ops_avx2;
+	case LEPT_SIMD_SSE2: return &lept_simd_ops_sse2;
+#endif
+	default:             return &lept_simd_ops_none;
+	}
+}
+
+// the CPU is asked once, by whichever thread comes first; the others wait in the static's initializer
+static lept_simd lept_simd_detected()
+{
+	static const lept_simd supported = lept_simd_supported();
+	return supported;
+}
+
+static const lept_simd_ops* lept_simd_current()
+{
+	const lept_simd_ops* ops = lept_simd_in_use.load(std::memory_order_acquire);
+	if (ops == NULL)
+	{
+		const lept_simd_ops* best = lept_simd_ops_for(lept_simd_detected());
+		// a lept_set_simd on another thread in the meantime wins, ops is then what it set
+		if (lept_simd_in_use.compare_exchange_strong(ops, best, std::memory_order_acq_rel, std::memory_order_acquire))
+			ops = best;
+	}
+	return ops;
+}
+
+static const char* lept_skip_whitespace(const char* p, const char* end)
+{
+	return lept_simd_current()->skip_whitespace(p, end);
+}
+
+static const char* lept_scan_string(const char* p, const char* end)
+{
+	return lept_simd_current()->scan_string(p, end);
+}
+
+static void lept_classify(const char* p, lept_block* b)
+{
+	lept_simd_current()->classify(p, b);
+}
+
+lept_simd lept_set_simd(lept_simd level)
+{
+	lept_simd supported = lept_simd_detected();
+	if (level > supported)
+		level = supported;
+	lept_simd_in_use.store(lept_simd_ops_for(level), std::memory_order_release);
+	return level;
+}
+
+lept_simd lept_get_simd(void)
+{
+	return lept_simd_current()->level;
+}
+
+static size_t lept_max_depth = LEPT_PARSE_MAX_DEPTH;
+
+void lept_set_max_depth(size_t depth)
+{
+	lept_max_depth = depth;
+}
+
+size_t lept_get_max_depth(void)
+{
+	return lept_max_depth;
+}
+
+// The limit of the parsers that build a tree, or that recurse while parsing: lept_free, lept_copy,
+// lept_is_equal and lept_stringify take one call per level, so no tree gets deeper than a 512 KB
+// thread stack takes. lept_parse_sax and the reader build nothing and go as deep as set.
+static size_t lept_tree_depth(void)
+{
+	return lept_max_depth < LEPT_TREE_MAX_DEPTH ? lept_max_depth : LEPT_TREE_MAX_DEPTH;
+}
+
+static int lept_shortest_numbers = 1;
+
+void lept_set_shortest_numbers(int enable)
+{
+	lept_shortest_numbers = enable;
+}
+
+int lept_get_shortest_numbers(void)
+{
+	return lept_shortest_numbers;
+}
+
+static int lept_pack_numbers = 1;
+
+void lept_set_pack_numbers(int enable)
+{
+	lept_pack_numbers = enable;
+}
+
+int lept_get_pack_numbers(void)
+{
+	return lept_pack_numbers;
+}
+
+void lept_set_allocator(const lept_allocator* a)
+{
+	if (a == NULL)
+		a = &lept_default_allocator;
+	assert(a->malloc_fn != NULL && a->realloc_fn != NULL && a->free_fn != NULL);
+	lept_allocator_in_use = *a;
+}
+
+const lept_allocator* lept_get_allocator(void)
+{
+	return &lept_allocator_in_use;
+}
+
+static void lept_parse_whitespace(lept_context* c)
+{
+	const char* p = c->json;
+	// most runs between tokens are empty or a single space, keep those off the vector path
+	if (p == c->end || !ISWHITESPACE(*p))
+		return;
+	if (++p == c->end || !ISWHITESPACE(*p))
+	{
+		c->json = p;
+		return;
+	}
+	c->json = lept_skip_whitespace(p + 1, c->end);
+}
+
+static int lept_parse_literal(lept_context* c, lept_value* v, const char* literal, lept_type type)
+{
+	size_t i;
+	EXPECT(c, literal[0]);
+	for (i = 0; literal[i + 1]; i++)
+	{
+		if (c->json + i == c->end || c->json[i] != literal[i + 1])
+			return LEPT_PARSE_INVALID_VALUE;
+	}
+	c->json += i;
+	v->type = type;
+	return LEPT_PARSE_OK;
+}
+
+/* decimal to double: Clinger's exact fast path, then Eisel-Lemire, then a big-integer comparison */
+
+#define LEPT_POW5_MIN_EXP (-342)
+#define LEPT_POW5_MAX_EXP 308
+#define LEPT_DECIMAL_MAX_DIGITS 768
+#define LEPT_BIGINT_LIMBS 128
+
+// 5^q for q in [-342, 308], normalized to 128 bits with the top bit set
+// (truncated for q >= 0, rounded up for q < 0), high word first.
+static const uint64_t lept_pow5_128[] = {
+	0xEEF453D6923BD65A, 0x113FAA2906A13B3F,
+	0x9558B4661B6565F8, 0x4AC7CA59A424C507,
+	0xBAAEE17FA23EBF76, 0x5D79BCF00D2DF649,
+	0xE95A99DF8ACE6F53, 0xF4D82C2C107973DC,
+	0x91D8A02BB6C10594, 0x79071B9B8A4BE869,
+	0xB64EC836A47146F9, 0x9748E2826CDEE284,
+	0xE3E27A444D8D98B7, 0xFD1B1B2308169B25,
+	0x8E6D8C6AB0787F72, 0xFE30F0F5E50E20F7,
+	0xB208EF855C969F4F, 0xBDBD2D335E51A935,
+	0xDE8B2B66B3BC4723, 0xAD2C788035E61382,
+	0x8B16FB203055AC76, 0x4C3BCB5021AFCC31,
+	0xADDCB9E83C6B1793, 0xDF4ABE242A1BBF3D,
+	0xD953E8624B85DD78, 0xD71D6DAD34A2AF0D,
+	0x87D4713D6F33AA6B, 0x8672648C40E5AD68,
+	0xA9C98D8CCB009506, 0x680EFDAF511F18C2,
+	0xD43BF0EFFDC0BA48, 0x0212BD1B2566DEF2,
+	0x84A57695FE98746D, 0x014BB630F7604B57,
+	0xA5CED43B7E3E9188, 0x419EA3BD35385E2D,
+	0xCF42894A5DCE35EA, 0x52064CAC828675B9,
+	0x818995CE7AA0E1B2, 0x7343EFEBD1940993,
+	0xA1EBFB4219491A1F, 0x1014EBE6C5F90BF8,
+	0xCA66FA129F9B60A6, 0xD41A26E077774EF6,
+	0xFD00B897478238D0, 0x8920B098955522B4,
+	0x9E20735E8CB16382, 0x55B46E5F5D5535B0,
+	0xC5A890362FDDBC62, 0xEB2189F734AA831D,
+	0xF712B443BBD52B7B, 0xA5E9EC7501D523E4,
+	0x9A6BB0AA55653B2D, 0x47B233C92125366E,
+	0xC1069CD4EABE89F8, 0x999EC0BB696E840A,
+	0xF148440A256E2C76, 0xC00670EA43CA250D,
+	0x96CD2A865764DBCA, 0x380406926A5E5728,
+	0xBC807527ED3E12BC, 0xC605083704F5ECF2,
+	0xEBA09271E88D976B, 0xF7864A44C633682E,
+	0x93445B8731587EA3, 0x7AB3EE6AFBE0211D,
+	0xB8157268FDAE9E4C, 0x5960EA05BAD82964,
+	0xE61ACF033D1A45DF, 0x6FB92487298E33BD,
+	0x8FD0C16206306BAB, 0xA5D3B6D479F8E056,
+	0xB3C4F1BA87BC8696, 0x8F48A4899877186C,
+	0xE0B62E2929ABA83C, 0x331ACDABFE94DE87,
+	0x8C71DCD9BA0B4925, 0x9FF0C08B7F1D0B14,
+	0xAF8E5410288E1B6F, 0x07ECF0AE5EE44DD9,
+	0xDB71E91432B1A24A, 0xC9E82CD9F69D6150,
+	0x892731AC9FAF056E, 0xBE311C083A225CD2,
+	0xAB70FE17C79AC6CA, 0x6DBD630A48AAF406,
+	0xD64D3D9DB981787D, 0x092CBBCCDAD5B108,
+	0x85F0468293F0EB4E, 0x25BBF56008C58EA5,
+	0xA76C582338ED2621, 0xAF2AF2B80AF6F24E,
+	0xD1476E2C07286FAA, 0x1AF5AF660DB4AEE1,
+	0x82CCA4DB847945CA, 0x50D98D9FC890ED4D,
+	0xA37FCE126597973C, 0xE50FF107BAB528A0,
+	0xCC5FC196FEFD7D0C, 0x1E53ED49A96272C8,
+	0xFF77B1FCBEBCDC4F, 0x25E8E89C13BB0F7A,
+	0x9FAACF3DF73609B1, 0x77B191618C54E9AC,
+	0xC795830D75038C1D, 0xD59DF5B9EF6A2417,
+	0xF97AE3D0D2446F25, 0x4B0573286B44AD1D,
+	0x9BECCE62836AC577, 0x4EE367F9430AEC32,
+	0xC2E801FB244576D5, 0x229C41F793CDA73F,
+	0xF3A20279ED56D48A, 0x6B43527578C1110F,
+	0x9845418C345644D6, 0x830A13896B78AAA9,
+	0xBE5691EF416BD60C, 0x23CC986BC656D553,
+	0xEDEC366B11C6CB8F, 0x2CBFBE86B7EC8AA8,
+	0x94B3A202EB1C3F39, 0x7BF7D71432F3D6A9,
+	0xB9E08A83A5E34F07, 0xDAF5CCD93FB0CC53,
+	0xE858AD248F5C22C9, 0xD1B3400F8F9CFF68,
+	0x91376C36D99995BE, 0x23100809B9C21FA1,
+	0xB58547448FFFFB2D, 0xABD40A0C2832A78A,
+	0xE2E69915B3FFF9F9, 0x16C90C8F323F516C,
+	0x8DD01FAD907FFC3B, 0xAE3DA7D97F6792E3,
+	0xB1442798F49FFB4A, 0x99CD11CFDF41779C,
+	0xDD95317F31C7FA1D, 0x40405643D711D583,
+	0x8A7D3EEF7F1CFC52, 0x482835EA666B2572,
+	0xAD1C8EAB5EE43B66, 0xDA3243650005EECF,
+	0xD863B256369D4A40, 0x90BED43E40076A82,
+	0x873E4F75E2224E68, 0x5A7744A6E804A291,
+	0xA90DE3535AAAE202, 0x711515D0A205CB36,
+	0xD3515C2831559A83, 0x0D5A5B44CA873E03,
+	0x8412D9991ED58091, 0xE858790AFE9486C2,
+	0xA5178FFF668AE0B6, 0x626E974DBE39A872,
+	0xCE5D73FF402D98E3, 0xFB0A3D212DC8128F,
+	0x80FA687F881C7F8E, 0x7CE66634BC9D0B99,
+	0xA139029F6A239F72, 0x1C1FFFC1EBC44E80,
+	0xC987434744AC874E, 0xA327FFB266B56220,
+	0xFBE9141915D7A922, 0x4BF1FF9F0062BAA8,
+	0x9D71AC8FADA6C9B5, 0x6F773FC3603DB4A9,
+	0xC4CE17B399107C22, 0xCB550FB4384D21D3,
+	0xF6019DA07F549B2B, 0x7E2A53A146606A48,
+	0x99C102844F94E0FB, 0x2EDA7444CBFC426D,
+	0xC0314325637A1939, 0xFA911155FEFB5308,
+	0xF03D93EEBC589F88, 0x793555AB7EBA27CA,
+	0x96267C7535B763B5, 0x4BC1558B2F3458DE,
+	0xBBB01B9283253CA2, 0x9EB1AAEDFB016F16,
+	0xEA9C227723EE8BCB, 0x465E15A979C1CADC,
+	0x92A1958A7675175F, 0x0BFACD89EC191EC9,
+	0xB749FAED14125D36, 0xCEF980EC671F667B,
+	0xE51C79A85916F484, 0x82B7E12780E7401A,
+	0x8F31CC0937AE58D2, 0xD1B2ECB8B0908810,
+	0xB2FE3F0B8599EF07, 0x861FA7E6DCB4AA15,
+	0xDFBDCECE67006AC9, 0x67A791E093E1D49A,
+	0x8BD6A141006042BD, 0xE0C8BB2C5C6D24E0,
+	0xAECC49914078536D, 0x58FAE9F773886E18,
+	0xDA7F5BF590966848, 0xAF39A475506A899E,
+	0x888F99797A5E012D, 0x6D8406C952429603,
+	0xAAB37FD7D8F58178, 0xC8E5087BA6D33B83,
+	0xD5605FCDCF32E1D6, 0xFB1E4A9A90880A64,
+	0x855C3BE0A17FCD26, 0x5CF2EEA09A55067F,
+	0xA6B34AD8C9DFC06F, 0xF42FAA48C0EA481E,
+	0xD0601D8EFC57B08B, 0xF13B94DAF124DA26,
+	0x823C12795DB6CE57, 0x76C53D08D6B70858,
+	0xA2CB1717B52481ED, 0x54768C4B0C64CA6E,
+	0xCB7DDCDDA26DA268, 0xA9942F5DCF7DFD09,
+	0xFE5D54150B090B02, 0xD3F93B35435D7C4C,
+	0x9EFA548D26E5A6E1, 0xC47BC5014A1A6DAF,
+	0xC6B8E9B0709F109A, 0x359AB6419CA1091B,
+	0xF867241C8CC6D4C0, 0xC30163D203C94B62,
+	0x9B407691D7FC44F8, 0x79E0DE63425DCF1D,
+	0xC21094364DFB5636, 0x985915FC12F542E4,
+	0xF294B943E17A2BC4, 0x3E6F5B7B17B2939D,
+	0x979CF3CA6CEC5B5A, 0xA705992CEECF9C42,
+	0xBD8430BD08277231, 0x50C6FF782A838353,
+	0xECE53CEC4A314EBD, 0xA4F8BF5635246428,
+	0x940F4613AE5ED136, 0x871B7795E136BE99,
+	0xB913179899F68584, 0x28E2557B59846E3F,
+	0xE757DD7EC07426E5, 0x331AEADA2FE589CF,
+	0x9096EA6F3848984F, 0x3FF0D2C85DEF7621,
+	0xB4BCA50B065ABE63, 0x0FED077A756B53A9,
+	0xE1EBCE4DC7F16DFB, 0xD3E8495912C62894,
+	0x8D3360F09CF6E4BD, 0x64712DD7ABBBD95C,
+	0xB080392CC4349DEC, 0xBD8D794D96AACFB3,
+	0xDCA04777F541C567, 0xECF0D7A0FC5583A0,
+	0x89E42CAAF9491B60, 0xF41686C49DB57244,
+	0xAC5D37D5B79B6239, 0x311C2875C522CED5,
+	0xD77485CB25823AC7, 0x7D633293366B828B,
+	0x86A8D39EF77164BC, 0xAE5DFF9C02033197,
+	0xA8530886B54DBDEB, 0xD9F57F830283FDFC,
+	0xD267CAA862A12D66, 0xD072DF63C324FD7B,
+	0x8380DEA93DA4BC60, 0x4247CB9E59F71E6D,
+	0xA46116538D0DEB78, 0x52D9BE85F074E608,
+	0xCD795BE870516656, 0x67902E276C921F8B,
+	0x806BD9714632DFF6, 0x00BA1CD8A3DB53B6,
+	0xA086CFCD97BF97F3, 0x80E8A40ECCD228A4,
+	0xC8A883C0FDAF7DF0, 0x6122CD128006B2CD,
+	0xFAD2A4B13D1B5D6C, 0x796B805720085F81,
+	0x9CC3A6EEC6311A63, 0xCBE3303674053BB0,
+	0xC3F490AA77BD60FC, 0xBEDBFC4411068A9C,
+	0xF4F1B4D515ACB93B, 0xEE92FB5515482D44,
+	0x991711052D8BF3C5, 0x751BDD152D4D1C4A,
+	0xBF5CD54678EEF0B6, 0xD262D45A78A0635D,
+	0xEF340A98172AACE4, 0x86FB897116C87C34,
+	0x9580869F0E7AAC0E, 0xD45D35E6AE3D4DA0,
+	0xBAE0A846D2195712, 0x8974836059CCA109,
+	0xE998D258869FACD7, 0x2BD1A438703FC94B,
+	0x91FF83775423CC06, 0x7B6306A34627DDCF,
+	0xB67F6455292CBF08, 0x1A3BC84C17B1D542,
+	0xE41F3D6A7377EECA, 0x20CABA5F1D9E4A93,
+	0x8E938662882AF53E, 0x547EB47B7282EE9C,
+	0xB23867FB2A35B28D, 0xE99E619A4F23AA43,
+	0xDEC681F9F4C31F31, 0x6405FA00E2EC94D4,
+	0x8B3C113C38F9F37E, 0xDE83BC408DD3DD04,
+	0xAE0B158B4738705E, 0x9624AB50B148D445,
+	0xD98DDAEE19068C76, 0x3BADD624DD9B0957,
+	0x87F8A8D4CFA417C9, 0xE54CA5D70A80E5D6,
+	0xA9F6D30A038D1DBC, 0x5E9FCF4CCD211F4C,
+	0xD47487CC8470652B, 0x7647C3200069671F,
+	0x84C8D4DFD2C63F3B, 0x29ECD9F40041E073,
+	0xA5FB0A17C777CF09, 0xF468107100525890,
+	0xCF79CC9DB955C2CC, 0x7182148D4066EEB4,
+	0x81AC1FE293D599BF, 0xC6F14CD848405530,
+	0xA21727DB38CB002F, 0xB8ADA00E5A506A7C,
+	0xCA9CF1D206FDC03B, 0xA6D90811F0E4851C,
+	0xFD442E4688BD304A, 0x908F4A166D1DA663,
+	0x9E4A9CEC15763E2E, 0x9A598E4E043287FE,
+	0xC5DD44271AD3CDBA, 0x40EFF1E1853F29FD,
+	0xF7549530E188C128, 0xD12BEE59E68EF47C,
+	0x9A94DD3E8CF578B9, 0x82BB74F8301958CE,
+	0xC13A148E3032D6E7, 0xE36A52363C1FAF01,
+	0xF18899B1BC3F8CA1, 0xDC44E6C3CB279AC1,
+	0x96F5600F15A7B7E5, 0x29AB103A5EF8C0B9,
+	0xBCB2B812DB11A5DE, 0x7415D448F6B6F0E7,
+	0xEBDF661791D60F56, 0x111B495B3464AD21,
+	0x936B9FCEBB25C995, 0xCAB10DD900BEEC34,
+	0xB84687C269EF3BFB, 0x3D5D514F40EEA742,
+	0xE65829B3046B0AFA, 0x0CB4A5A3112A5112,
+	0x8FF71A0FE2C2E6DC, 0x47F0E785EABA72AB,
+	0xB3F4E093DB73A093, 0x59ED216765690F56,
+	0xE0F218B8D25088B8, 0x306869C13EC3532C,
+	0x8C974F7383725573, 0x1E414218C73A13FB,
+	0xAFBD2350644EEACF, 0xE5D1929EF90898FA,
+	0xDBAC6C247D62A583, 0xDF45F746B74ABF39,
+	0x894BC396CE5DA772, 0x6B8BBA8C328EB783,
+	0xAB9EB47C81F5114F, 0x066EA92F3F326564,
+	0xD686619BA27255A2, 0xC80A537B0EFEFEBD,
+	0x8613FD0145877585, 0xBD06742CE95F5F36,
+	0xA798FC4196E952E7, 0x2C48113823B73704,
+	0xD17F3B51FCA3A7A0, 0xF75A15862CA504C5,
+	0x82EF85133DE648C4, 0x9A984D73DBE722FB,
+	0xA3AB66580D5FDAF5, 0xC13E60D0D2E0EBBA,
+	0xCC963FEE10B7D1B3, 0x318DF905079926A8,
+	0xFFBBCFE994E5C61F, 0xFDF17746497F7052,
+	0x9FD561F1FD0F9BD3, 0xFEB6EA8BEDEFA633,
+	0xC7CABA6E7C5382C8, 0xFE64A52EE96B8FC0,
+	0xF9BD690A1B68637B, 0x3DFDCE7AA3C673B0,
+	0x9C1661A651213E2D, 0x06BEA10CA65C084E,
+	0xC31BFA0FE5698DB8, 0x486E494FCFF30A62,
+	0xF3E2F893DEC3F126, 0x5A89DBA3C3EFCCFA,
+	0x986DDB5C6B3A76B7, 0xF89629465A75E01C,
+	0xBE89523386091465, 0xF6BBB397F1135823,
+	0xEE2BA6C0678B597F, 0x746AA07DED582E2C,
+	0x94DB483840B717EF, 0xA8C2A44EB4571CDC,
+	0xBA121A4650E4DDEB, 0x92F34D62616CE413,
+	0xE896A0D7E51E1566, 0x77B020BAF9C81D17,
+	0x915E2486EF32CD60, 0x0ACE1474DC1D122E,
+	0xB5B5ADA8AAFF80B8, 0x0D819992132456BA,
+	0xE3231912D5BF60E6, 0x10E1FFF697ED6C69,
+	0x8DF5EFABC5979C8F, 0xCA8D3FFA1EF463C1,
+	0xB1736B96B6FD83B3, 0xBD308FF8A6B17CB2,
+	0xDDD0467C64BCE4A0, 0xAC7CB3F6D05DDBDE,
+	0x8AA22C0DBEF60EE4, 0x6BCDF07A423AA96B,
+	0xAD4AB7112EB3929D, 0x86C16C98D2C953C6,
+	0xD89D64D57A607744, 0xE871C7BF077BA8B7,
+	0x87625F056C7C4A8B, 0x11471CD764AD4972,
+	0xA93AF6C6C79B5D2D, 0xD598E40D3DD89BCF,
+	0xD389B47879823479, 0x4AFF1D108D4EC2C3,
+	0x843610CB4BF160CB, 0xCEDF722A585139BA,
+	0xA54394FE1EEDB8FE, 0xC2974EB4EE658828,
+	0xCE947A3DA6A9273E, 0x733D226229FEEA32,
+	0x811CCC668829B887, 0x0806357D5A3F525F,
+	0xA163FF802A3426A8, 0xCA07C2DCB0CF26F7,
+	0xC9BCFF6034C13052, 0xFC89B393DD02F0B5,
+	0xFC2C3F3841F17C67, 0xBBAC2078D443ACE2,
+	0x9D9BA7832936EDC0, 0xD54B944B84AA4C0D,
+	0xC5029163F384A931, 0x0A9E795E65D4DF11,
+	0xF64335BCF065D37D, 0x4D4617B5FF4A16D5,
+	0x99EA0196163FA42E, 0x504BCED1BF8E4E45,
+	0xC06481FB9BCF8D39, 0xE45EC2862F71E1D6,
+	0xF07DA27A82C37088, 0x5D767327BB4E5A4C,
+	0x964E858C91BA2655, 0x3A6A07F8D510F86F,
+	0xBBE226EFB628AFEA, 0x890489F70A55368B,
+	0xEADAB0ABA3B2DBE5, 0x2B45AC74CCEA842E,
+	0x92C8AE6B464FC96F, 0x3B0B8BC90012929D,
+	0xB77ADA0617E3BBCB, 0x09CE6EBB40173744,
+	0xE55990879DDCAABD, 0xCC420A6A101D0515,
+	0x8F57FA54C2A9EAB6, 0x9FA946824A12232D,
+	0xB32DF8E9F3546564, 0x47939822DC96ABF9,
+	0xDFF9772470297EBD, 0x59787E2B93BC56F7,
+	0x8BFBEA76C619EF36, 0x57EB4EDB3C55B65A,
+	0xAEFAE51477A06B03, 0xEDE622920B6B23F1,
+	0xDAB99E59958885C4, 0xE95FAB368E45ECED,
+	0x88B402F7FD75539B, 0x11DBCB0218EBB414,
+	0xAAE103B5FCD2A881, 0xD652BDC29F26A119,
+	0xD59944A37C0752A2, 0x4BE76D3346F0495F,
+	0x857FCAE62D8493A5, 0x6F70A4400C562DDB,
+	0xA6DFBD9FB8E5B88E, 0xCB4CCD500F6BB952,
+	0xD097AD07A71F26B2, 0x7E2000A41346A7A7,
+	0x825ECC24C873782F, 0x8ED400668C0C28C8,
+	0xA2F67F2DFA90563B, 0x728900802F0F32FA,
+	0xCBB41EF979346BCA, 0x4F2B40A03AD2FFB9,
+	0xFEA126B7D78186BC, 0xE2F610C84987BFA8,
+	0x9F24B832E6B0F436, 0x0DD9CA7D2DF4D7C9,
+	0xC6EDE63FA05D3143, 0x91503D1C79720DBB,
+	0xF8A95FCF88747D94, 0x75A44C6397CE912A,
+	0x9B69DBE1B548CE7C, 0xC986AFBE3EE11ABA,
+	0xC24452DA229B021B, 0xFBE85BADCE996168,
+	0xF2D56790AB41C2A2, 0xFAE27299423FB9C3,
+	0x97C560BA6B0919A5, 0xDCCD879FC967D41A,
+	0xBDB6B8E905CB600F, 0x5400E987BBC1C920,
+	0xED246723473E3813, 0x290123E9AAB23B68,
+	0x9436C0760C86E30B, 0xF9A0B6720AAF6521,
+	0xB94470938FA89BCE, 0xF808E40E8D5B3E69,
+	0xE7958CB87392C2C2, 0xB60B1D1230B20E04,
+	0x90BD77F3483BB9B9, 0xB1C6F22B5E6F48C2,
+	0xB4ECD5F01A4AA828, 0x1E38AEB6360B1AF3,
+	0xE2280B6C20DD5232, 0x25C6DA63C38DE1B0,
+	0x8D590723948A535F, 0x579C487E5A38AD0E,
+	0xB0AF48EC79ACE837, 0x2D835A9DF0C6D851,
+	0xDCDB1B2798182244, 0xF8E431456CF88E65,
+	0x8A08F0F8BF0F156B, 0x1B8E9ECB641B58FF,
+	0xAC8B2D36EED2DAC5, 0xE272467E3D222F3F,
+	0xD7ADF884AA879177, 0x5B0ED81DCC6ABB0F,
+	0x86CCBB52EA94BAEA, 0x98E947129FC2B4E9,
+	0xA87FEA27A539E9A5, 0x3F2398D747B36224,
+	0xD29FE4B18E88640E, 0x8EEC7F0D19A03AAD,
+	0x83A3EEEEF9153E89, 0x1953CF68300424AC,
+	0xA48CEAAAB75A8E2B, 0x5FA8C3423C052DD7,
+	0xCDB02555653131B6, 0x3792F412CB06794D,
+	0x808E17555F3EBF11, 0xE2BBD88BBEE40BD0,
+	0xA0B19D2AB70E6ED6, 0x5B6ACEAEAE9D0EC4,
+	0xC8DE047564D20A8B, 0xF245825A5A445275,
+	0xFB158592BE068D2E, 0xEED6E2F0F0D56712,
+	0x9CED737BB6C4183D, 0x55464DD69685606B,
+	0xC428D05AA4751E4C, 0xAA97E14C3C26B886,
+	0xF53304714D9265DF, 0xD53DD99F4B3066A8,
+	0x993FE2C6D07B7FAB, 0xE546A8038EFE4029,
+	0xBF8FDB78849A5F96, 0xDE98520472BDD033,
+	0xEF73D256A5C0F77C, 0x963E66858F6D4440,
+	0x95A8637627989AAD, 0xDDE7001379A44AA8,
+	0xBB127C53B17EC159, 0x5560C018580D5D52,
+	0xE9D71B689DDE71AF, 0xAAB8F01E6E10B4A6,
+	0x9226712162AB070D, 0xCAB3961304CA70E8,
+	0xB6B00D69BB55C8D1, 0x3D607B97C5FD0D22,
+	0xE45C10C42A2B3B05, 0x8CB89A7DB77C506A,
+	0x8EB98A7A9A5B04E3, 0x77F3608E92ADB242,
+	0xB267ED1940F1C61C, 0x55F038B237591ED3,
+	0xDF01E85F912E37A3, 0x6B6C46DEC52F6688,
+	0x8B61313BBABCE2C6, 0x2323AC4B3B3DA015,
+	0xAE397D8AA96C1B77, 0xABEC975E0A0D081A,
+	0xD9C7DCED53C72255, 0x96E7BD358C904A21,
+	0x881CEA14545C7575, 0x7E50D64177DA2E54,
+	0xAA242499697392D2, 0xDDE50BD1D5D0B9E9,
+	0xD4AD2DBFC3D07787, 0x955E4EC64B44E864,
+	0x84EC3C97DA624AB4, 0xBD5AF13BEF0B113E,
+	0xA6274BBDD0FADD61, 0xECB1AD8AEACDD58E,
+	0xCFB11EAD453994BA, 0x67DE18EDA5814AF2,
+	0x81CEB32C4B43FCF4, 0x80EACF948770CED7,
+	0xA2425FF75E14FC31, 0xA1258379A94D028D,
+	0xCAD2F7F5359A3B3E, 0x096EE45813A04330,
+	0xFD87B5F28300CA0D, 0x8BCA9D6E188853FC,
+	0x9E74D1B791E07E48, 0x775EA264CF55347E,
+	0xC612062576589DDA, 0x95364AFE032A819E,
+	0xF79687AED3EEC551, 0x3A83DDBD83F52205,
+	0x9ABE14CD44753B52, 0xC4926A9672793543,
+	0xC16D9A0095928A27, 0x75B7053C0F178294,
+	0xF1C90080BAF72CB1, 0x5324C68B12DD6339,
+	0x971DA05074DA7BEE, 0xD3F6FC16EBCA5E04,
+	0xBCE5086492111AEA, 0x88F4BB1CA6BCF585,
+	0xEC1E4A7DB69561A5, 0x2B31E9E3D06C32E6,
+	0x9392EE8E921D5D07, 0x3AFF322E62439FD0,
+	0xB877AA3236A4B449, 0x09BEFEB9FAD487C3,
+	0xE69594BEC44DE15B, 0x4C2EBE687989A9B4,
+	0x901D7CF73AB0ACD9, 0x0F9D37014BF60A11,
+	0xB424DC35095CD80F, 0x538484C19EF38C95,
+	0xE12E13424BB40E13, 0x2865A5F206B06FBA,
+	0x8CBCCC096F5088CB, 0xF93F87B7442E45D4,
+	0xAFEBFF0BCB24AAFE, 0xF78F69A51539D749,
+	0xDBE6FECEBDEDD5BE, 0xB573440E5A884D1C,
+	0x89705F4136B4A597, 0x31680A88F8953031,
+	0xABCC77118461CEFC, 0xFDC20D2B36BA7C3E,
+	0xD6BF94D5E57A42BC, 0x3D32907604691B4D,
+	0x8637BD05AF6C69B5, 0xA63F9A49C2C1B110,
+	0xA7C5AC471B478423, 0x0FCF80DC33721D54,
+	0xD1B71758E219652B, 0xD3C36113404EA4A9,
+	0x83126E978D4FDF3B, 0x645A1CAC083126EA,
+	0xA3D70A3D70A3D70A, 0x3D70A3D70A3D70A4,
+	0xCCCCCCCCCCCCCCCC, 0xCCCCCCCCCCCCCCCD,
+	0x8000000000000000, 0x0000000000000000,
+	0xA000000000000000, 0x0000000000000000,
+	0xC800000000000000, 0x0000000000000000,
+	0xFA00000000000000, 0x0000000000000000,
+	0x9C40000000000000, 0x0000000000000000,
+	0xC350000000000000, 0x0000000000000000,
+	0xF424000000000000, 0x0000000000000000,
+	0x9896800000000000, 0x0000000000000000,
+	0xBEBC200000000000, 0x0000000000000000,
+	0xEE6B280000000000, 0x0000000000000000,
+	0x9502F90000000000, 0x0000000000000000,
+	0xBA43B74000000000, 0x0000000000000000,
+	0xE8D4A51000000000, 0x0000000000000000,
+	0x9184E72A00000000, 0x0000000000000000,
+	0xB5E620F480000000, 0x0000000000000000,
+	0xE35FA931A0000000, 0x0000000000000000,
+	0x8E1BC9BF04000000, 0x0000000000000000,
+	0xB1A2BC2EC5000000, 0x0000000000000000,
+	0xDE0B6B3A76400000, 0x0000000000000000,
+	0x8AC7230489E80000, 0x0000000000000000,
+	0xAD78EBC5AC620000, 0x0000000000000000,
+	0xD8D726B7177A8000, 0x0000000000000000,
+	0x878678326EAC9000, 0x0000000000000000,
+	0xA968163F0A57B400, 0x0000000000000000,
+	0xD3C21BCECCEDA100, 0x0000000000000000,
+	0x84595161401484A0, 0x0000000000000000,
+	0xA56FA5B99019A5C8, 0x0000000000000000,
+	0xCECB8F27F4200F3A, 0x0000000000000000,
+	0x813F3978F8940984, 0x4000000000000000,
+	0xA18F07D736B90BE5, 0x5000000000000000,
+	0xC9F2C9CD04674EDE, 0xA400000000000000,
+	0xFC6F7C4045812296, 0x4D00000000000000,
+	0x9DC5ADA82B70B59D, 0xF020000000000000,
+	0xC5371912364CE305, 0x6C28000000000000,
+	0xF684DF56C3E01BC6, 0xC732000000000000,
+	0x9A130B963A6C115C, 0x3C7F400000000000,
+	0xC097CE7BC90715B3, 0x4B9F100000000000,
+	0xF0BDC21ABB48DB20, 0x1E86D40000000000,
+	0x96769950B50D88F4, 0x1314448000000000,
+	0xBC143FA4E250EB31, 0x17D955A000000000,
+	0xEB194F8E1AE525FD, 0x5DCFAB0800000000,
+	0x92EFD1B8D0CF37BE, 0x5AA1CAE500000000,
+	0xB7ABC627050305AD, 0xF14A3D9E40000000,
+	0xE596B7B0C643C719, 0x6D9CCD05D0000000,
+	0x8F7E32CE7BEA5C6F, 0xE4820023A2000000,
+	0xB35DBF821AE4F38B, 0xDDA2802C8A800000,
+	0xE0352F62A19E306E, 0xD50B2037AD200000,
+	0x8C213D9DA502DE45, 0x4526F422CC340000,
+	0xAF298D050E4395D6, 0x9670B12B7F410000,
+	0xDAF3F04651D47B4C, 0x3C0CDD765F114000,
+	0x88D8762BF324CD0F, 0xA5880A69FB6AC800,
+	0xAB0E93B6EFEE0053, 0x8EEA0D047A457A00,
+	0xD5D238A4ABE98068, 0x72A4904598D6D880,
+	0x85A36366EB71F041, 0x47A6DA2B7F864750,
+	0xA70C3C40A64E6C51, 0x999090B65F67D924,
+	0xD0CF4B50CFE20765, 0xFFF4B4E3F741CF6D,
+	0x82818F1281ED449F, 0xBFF8F10E7A8921A4,
+	0xA321F2D7226895C7, 0xAFF72D52192B6A0D,
+	0xCBEA6F8CEB02BB39, 0x9BF4F8A69F764490,
+	0xFEE50B7025C36A08, 0x02F236D04753D5B4,
+	0x9F4F2726179A2245, 0x01D762422C946590,
+	0xC722F0EF9D80AAD6, 0x424D3AD2B7B97EF5,
+	0xF8EBAD2B84E0D58B, 0xD2E0898765A7DEB2,
+	0x9B934C3B330C8577, 0x63CC55F49F88EB2F,
+	0xC2781F49FFCFA6D5, 0x3CBF6B71C76B25FB,
+	0xF316271C7FC3908A, 0x8BEF464E3945EF7A,
+	0x97EDD871CFDA3A56, 0x97758BF0E3CBB5AC,
+	0xBDE94E8E43D0C8EC, 0x3D52EEED1CBEA317,
+	0xED63A231D4C4FB27, 0x4CA7AAA863EE4BDD,
+	0x945E455F24FB1CF8, 0x8FE8CAA93E74EF6A,
+	0xB975D6B6EE39E436, 0xB3E2FD538E122B44,
+	0xE7D34C64A9C85D44, 0x60DBBCA87196B616,
+	0x90E40FBEEA1D3A4A, 0xBC8955E946FE31CD,
+	0xB51D13AEA4A488DD, 0x6BABAB6398BDBE41,
+	0xE264589A4DCDAB14, 0xC696963C7EED2DD1,
+	0x8D7EB76070A08AEC, 0xFC1E1DE5CF543CA2,
+	0xB0DE65388CC8ADA8, 0x3B25A55F43294BCB,
+	0xDD15FE86AFFAD912, 0x49EF0EB713F39EBE,
+	0x8A2DBF142DFCC7AB, 0x6E3569326C784337,
+	0xACB92ED9397BF996, 0x49C2C37F07965404,
+	0xD7E77A8F87DAF7FB, 0xDC33745EC97BE906,
+	0x86F0AC99B4E8DAFD, 0x69A028BB3DED71A3,
+	0xA8ACD7C0222311BC, 0xC40832EA0D68CE0C,
+	0xD2D80DB02AABD62B, 0xF50A3FA490C30190,
+	0x83C7088E1AAB65DB, 0x792667C6DA79E0FA,
+	0xA4B8CAB1A1563F52, 0x577001B891185938,
+	0xCDE6FD5E09ABCF26, 0xED4C0226B55E6F86,
+	0x80B05E5AC60B6178, 0x544F8158315B05B4,
+	0xA0DC75F1778E39D6, 0x696361AE3DB1C721,
+	0xC913936DD571C84C, 0x03BC3A19CD1E38E9,
+	0xFB5878494ACE3A5F, 0x04AB48A04065C723,
+	0x9D174B2DCEC0E47B, 0x62EB0D64283F9C76,
+	0xC45D1DF942711D9A, 0x3BA5D0BD324F8394,
+	0xF5746577930D6500, 0xCA8F44EC7EE36479,
+	0x9968BF6ABBE85F20, 0x7E998B13CF4E1ECB,
+	0xBFC2EF456AE276E8, 0x9E3FEDD8C321A67E,
+	0xEFB3AB16C59B14A2, 0xC5CFE94EF3EA101E,
+	0x95D04AEE3B80ECE5, 0xBBA1F1D158724A12,
+	0xBB445DA9CA61281F, 0x2A8A6E45AE8EDC97,
+	0xEA1575143CF97226, 0xF52D09D71A3293BD,
+	0x924D692CA61BE758, 0x593C2626705F9C56,
+	0xB6E0C377CFA2E12E, 0x6F8B2FB00C77836C,
+	0xE498F455C38B997A, 0x0B6DFB9C0F956447,
+	0x8EDF98B59A373FEC, 0x4724BD4189BD5EAC,
+	0xB2977EE300C50FE7, 0x58EDEC91EC2CB657,
+	0xDF3D5E9BC0F653E1, 0x2F2967B66737E3ED,
+	0x8B865B215899F46C, 0xBD79E0D20082EE74,
+	0xAE67F1E9AEC07187, 0xECD8590680A3AA11,
+	0xDA01EE641A708DE9, 0xE80E6F4820CC9495,
+	0x884134FE908658B2, 0x3109058D147FDCDD,
+	0xAA51823E34A7EEDE, 0xBD4B46F0599FD415,
+	0xD4E5E2CDC1D1EA96, 0x6C9E18AC7007C91A,
+	0x850FADC09923329E, 0x03E2CF6BC604DDB0,
+	0xA6539930BF6BFF45, 0x84DB8346B786151C,
+	0xCFE87F7CEF46FF16, 0xE612641865679A63,
+	0x81F14FAE158C5F6E, 0x4FCB7E8F3F60C07E,
+	0xA26DA3999AEF7749, 0xE3BE5E330F38F09D,
+	0xCB090C8001AB551C, 0x5CADF5BFD3072CC5,
+	0xFDCB4FA002162A63, 0x73D9732FC7C8F7F6,
+	0x9E9F11C4014DDA7E, 0x2867E7FDDCDD9AFA,
+	0xC646D63501A1511D, 0xB281E1FD541501B8,
+	0xF7D88BC24209A565, 0x1F225A7CA91A4226,
+	0x9AE757596946075F, 0x3375788DE9B06958,
+	0xC1A12D2FC3978937, 0x0052D6B1641C83AE,
+	0xF209787BB47D6B84, 0xC0678C5DBD23A49A,
+	0x9745EB4D50CE6332, 0xF840B7BA963646E0,
+	0xBD176620A501FBFF, 0xB650E5A93BC3D898,
+	0xEC5D3FA8CE427AFF, 0xA3E51F138AB4CEBE,
+	0x93BA47C980E98CDF, 0xC66F336C36B10137,
+	0xB8A8D9BBE123F017, 0xB80B0047445D4184,
+	0xE6D3102AD96CEC1D, 0xA60DC059157491E5,
+	0x9043EA1AC7E41392, 0x87C89837AD68DB2F,
+	0xB454E4A179DD1877, 0x29BABE4598C311FB,
+	0xE16A1DC9D8545E94, 0xF4296DD6FEF3D67A,
+	0x8CE2529E2734BB1D, 0x1899E4A65F58660C,
+	0xB01AE745B101E9E4, 0x5EC05DCFF72E7F8F,
+	0xDC21A1171D42645D, 0x76707543F4FA1F73,
+	0x899504AE72497EBA, 0x6A06494A791C53A8,
+	0xABFA45DA0EDBDE69, 0x0487DB9D17636892,
+	0xD6F8D7509292D603, 0x45A9D2845D3C42B6,
+	0x865B86925B9BC5C2, 0x0B8A2392BA45A9B2,
+	0xA7F26836F282B732, 0x8E6CAC7768D7141E,
+	0xD1EF0244AF2364FF, 0x3207D795430CD926,
+	0x8335616AED761F1F, 0x7F44E6BD49E807B8,
+	0xA402B9C5A8D3A6E7, 0x5F16206C9C6209A6,
+	0xCD036837130890A1, 0x36DBA887C37A8C0F,
+	0x802221226BE55A64, 0xC2494954DA2C9789,
+	0xA02AA96B06DEB0FD, 0xF2DB9BAA10B7BD6C,
+	0xC83553C5C8965D3D, 0x6F92829494E5ACC7,
+	0xFA42A8B73ABBF48C, 0xCB772339BA1F17F9,
+	0x9C69A97284B578D7, 0xFF2A760414536EFB,
+	0xC38413CF25E2D70D, 0xFEF5138519684ABA,
+	0xF46518C2EF5B8CD1, 0x7EB258665FC25D69,
+	0x98BF2F79D5993802, 0xEF2F773FFBD97A61,
+	0xBEEEFB584AFF8603, 0xAAFB550FFACFD8FA,
+	0xEEAABA2E5DBF6784, 0x95BA2A53F983CF38,
+	0x952AB45CFA97A0B2, 0xDD945A747BF26183,
+	0xBA756174393D88DF, 0x94F971119AEEF9E4,
+	0xE912B9D1478CEB17, 0x7A37CD5601AAB85D,
+	0x91ABB422CCB812EE, 0xAC62E055C10AB33A,
+	0xB616A12B7FE617AA, 0x577B986B314D6009,
+	0xE39C49765FDF9D94, 0xED5A7E85FDA0B80B,
+	0x8E41ADE9FBEBC27D, 0x14588F13BE847307,
+	0xB1D219647AE6B31C, 0x596EB2D8AE258FC8,
+	0xDE469FBD99A05FE3, 0x6FCA5F8ED9AEF3BB,
+	0x8AEC23D680043BEE, 0x25DE7BB9480D5854,
+	0xADA72CCC20054AE9, 0xAF561AA79A10AE6A,
+	0xD910F7FF28069DA4, 0x1B2BA1518094DA04,
+	0x87AA9AFF79042286, 0x90FB44D2F05D0842,
+	0xA99541BF57452B28, 0x353A1607AC744A53,
+	0xD3FA922F2D1675F2, 0x42889B8997915CE8,
+	0x847C9B5D7C2E09B7, 0x69956135FEBADA11,
+	0xA59BC234DB398C25, 0x43FAB9837E699095,
+	0xCF02B2C21207EF2E, 0x94F967E45E03F4BB,
+	0x8161AFB94B44F57D, 0x1D1BE0EEBAC278F5,
+	0xA1BA1BA79E1632DC, 0x6462D92A69731732,
+	0xCA28A291859BBF93, 0x7D7B8F7503CFDCFE,
+	0xFCB2CB35E702AF78, 0x5CDA735244C3D43E,
+	0x9DEFBF01B061ADAB, 0x3A0888136AFA64A7,
+	0xC56BAEC21C7A1916, 0x088AAA1845B8FDD0,
+	0xF6C69A72A3989F5B, 0x8AAD549E57273D45,
+	0x9A3C2087A63F6399, 0x36AC54E2F678864B,
+	0xC0CB28A98FCF3C7F, 0x84576A1BB416A7DD,
+	0xF0FDF2D3F3C30B9F, 0x656D44A2A11C51D5,
+	0x969EB7C47859E743, 0x9F644AE5A4B1B325,
+	0xBC4665B596706114, 0x873D5D9F0DDE1FEE,
+	0xEB57FF22FC0C7959, 0xA90CB506D155A7EA,
+	0x9316FF75DD87CBD8, 0x09A7F12442D588F2,
+	0xB7DCBF5354E9BECE, 0x0C11ED6D538AEB2F,
+	0xE5D3EF282A242E81, 0x8F1668C8A86DA5FA,
+	0x8FA475791A569D10, 0xF96E017D694487BC,
+	0xB38D92D760EC4455, 0x37C981DCC395A9AC,
+	0xE070F78D3927556A, 0x85BBE253F47B1417,
+	0x8C469AB843B89562, 0x93956D7478CCEC8E,
+	0xAF58416654A6BABB, 0x387AC8D1970027B2,
+	0xDB2E51BFE9D0696A, 0x06997B05FCC0319E,
+	0x88FCF317F22241E2, 0x441FECE3BDF81F03,
+	0xAB3C2FDDEEAAD25A, 0xD527E81CAD7626C3,
+	0xD60B3BD56A5586F1, 0x8A71E223D8D3B074,
+	0x85C7056562757456, 0xF6872D5667844E49,
+	0xA738C6BEBB12D16C, 0xB428F8AC016561DB,
+	0xD106F86E69D785C7, 0xE13336D701BEBA52,
+	0x82A45B450226B39C, 0xECC0024661173473,
+	0xA34D721642B06084, 0x27F002D7F95D0190,
+	0xCC20CE9BD35C78A5, 0x31EC038DF7B441F4,
+	0xFF290242C83396CE, 0x7E67047175A15271,
+	0x9F79A169BD203E41, 0x0F0062C6E984D386,
+	0xC75809C42C684DD1, 0x52C07B78A3E60868,
+	0xF92E0C3537826145, 0xA7709A56CCDF8A82,
+	0x9BBCC7A142B17CCB, 0x88A66076400BB691,
+	0xC2ABF989935DDBFE, 0x6ACFF893D00EA435,
+	0xF356F7EBF83552FE, 0x0583F6B8C4124D43,
+	0x98165AF37B2153DE, 0xC3727A337A8B704A,
+	0xBE1BF1B059E9A8D6, 0x744F18C0592E4C5C,
+	0xEDA2EE1C7064130C, 0x1162DEF06F79DF73,
+	0x9485D4D1C63E8BE7, 0x8ADDCB5645AC2BA8,
+	0xB9A74A0637CE2EE1, 0x6D953E2BD7173692,
+	0xE8111C87C5C1BA99, 0xC8FA8DB6CCDD0437,
+	0x910AB1D4DB9914A0, 0x1D9C9892400A22A2,
+	0xB54D5E4A127F59C8, 0x2503BEB6D00CAB4B,
+	0xE2A0B5DC971F303A, 0x2E44AE64840FD61D,
+	0x8DA471A9DE737E24, 0x5CEAECFED289E5D2,
+	0xB10D8E1456105DAD, 0x7425A83E872C5F47,
+	0xDD50F1996B947518, 0xD12F124E28F77719,
+	0x8A5296FFE33CC92F, 0x82BD6B70D99AAA6F,
+	0xACE73CBFDC0BFB7B, 0x636CC64D1001550B,
+	0xD8210BEFD30EFA5A, 0x3C47F7E05401AA4E,
+	0x8714A775E3E95C78, 0x65ACFAEC34810A71,
+	0xA8D9D1535CE3B396, 0x7F1839A741A14D0D,
+	0xD31045A8341CA07C, 0x1EDE48111209A050,
+	0x83EA2B892091E44D, 0x934AED0AAB460432,
+	0xA4E4B66B68B65D60, 0xF81DA84D5617853F,
+	0xCE1DE40642E3F4B9, 0x36251260AB9D668E,
+	0x80D2AE83E9CE78F3, 0xC1D72B7C6B426019,
+	0xA1075A24E4421730, 0xB24CF65B8612F81F,
+	0xC94930AE1D529CFC, 0xDEE033F26797B627,
+	0xFB9B7CD9A4A7443C, 0x169840EF017DA3B1,
+	0x9D412E0806E88AA5, 0x8E1F289560EE864E,
+	0xC491798A08A2AD4E, 0xF1A6F2BAB92A27E2,
+	0xF5B5D7EC8ACB58A2, 0xAE10AF696774B1DB,
+	0x9991A6F3D6BF1765, 0xACCA6DA1E0A8EF29,
+	0xBFF610B0CC6EDD3F, 0x17FD090A58D32AF3,
+	0xEFF394DCFF8A948E, 0xDDFC4B4CEF07F5B0,
+	0x95F83D0A1FB69CD9, 0x4ABDAF101564F98E,
+	0xBB764C4CA7A4440F, 0x9D6D1AD41ABE37F1,
+	0xEA53DF5FD18D5513, 0x84C86189216DC5ED,
+	0x92746B9BE2F8552C, 0x32FD3CF5B4E49BB4,
+	0xB7118682DBB66A77, 0x3FBC8C33221DC2A1,
+	0xE4D5E82392A40515, 0x0FABAF3FEAA5334A,
+	0x8F05B1163BA6832D, 0x29CB4D87F2A7400E,
+	0xB2C71D5BCA9023F8, 0x743E20E9EF511012,
+	0xDF78E4B2BD342CF6, 0x914DA9246B255416,
+	0x8BAB8EEFB6409C1A, 0x1AD089B6C2F7548E,
+	0xAE9672ABA3D0C320, 0xA184AC2473B529B1,
+	0xDA3C0F568CC4F3E8, 0xC9E5D72D90A2741E,
+	0x8865899617FB1871, 0x7E2FA67C7A658892,
+	0xAA7EEBFB9DF9DE8D, 0xDDBB901B98FEEAB7,
+	0xD51EA6FA85785631, 0x552A74227F3EA565,
+	0x8533285C936B35DE, 0xD53A88958F87275F,
+	0xA67FF273B8460356, 0x8A892ABAF368F137,
+	0xD01FEF10A657842C, 0x2D2B7569B0432D85,
+	0x8213F56A67F6B29B, 0x9C3B29620E29FC73,
+	0xA298F2C501F45F42, 0x8349F3BA91B47B8F,
+	0xCB3F2F7642717713, 0x241C70A936219A73,
+	0xFE0EFB53D30DD4D7, 0xED238CD383AA0110,
+	0x9EC95D1463E8A506, 0xF4363804324A40AA,
+	0xC67BB4597CE2CE48, 0xB143C6053EDCD0D5,
+	0xF81AA16FDC1B81DA, 0xDD94B7868E94050A,
+	0x9B10A4E5E9913128, 0xCA7CF2B4191C8326,
+	0xC1D4CE1F63F57D72, 0xFD1C2F611F63A3F0,
+	0xF24A01A73CF2DCCF, 0xBC633B39673C8CEC,
+	0x976E41088617CA01, 0xD5BE0503E085D813,
+	0xBD49D14AA79DBC82, 0x4B2D8644D8A74E18,
+	0xEC9C459D51852BA2, 0xDDF8E7D60ED1219E,
+	0x93E1AB8252F33B45, 0xCABB90E5C942B503,
+	0xB8DA1662E7B00A17, 0x3D6A751F3B936243,
+	0xE7109BFBA19C0C9D, 0x0CC512670A783AD4,
+	0x906A617D450187E2, 0x27FB2B80668B24C5,
+	0xB484F9DC9641E9DA, 0xB1F9F660802DEDF6,
+	0xE1A63853BBD26451, 0x5E7873F8A0396973,
+	0x8D07E33455637EB2, 0xDB0B487B6423E1E8,
+	0xB049DC016ABC5E5F, 0x91CE1A9A3D2CDA62,
+	0xDC5C5301C56B75F7, 0x7641A140CC7810FB,
+	0x89B9B3E11B6329BA, 0xA9E904C87FCB0A9D,
+	0xAC2820D9623BF429, 0x546345FA9FBDCD44,
+	0xD732290FBACAF133, 0xA97C177947AD4095,
+	0x867F59A9D4BED6C0, 0x49ED8EABCCCC485D,
+	0xA81F301449EE8C70, 0x5C68F256BFFF5A74,
+	0xD226FC195C6A2F8C, 0x73832EEC6FFF3111,
+	0x83585D8FD9C25DB7, 0xC831FD53C5FF7EAB,
+	0xA42E74F3D032F525, 0xBA3E7CA8B77F5E55,
+	0xCD3A1230C43FB26F, 0x28CE1BD2E55F35EB,
+	0x80444B5E7AA7CF85, 0x7980D163CF5B81B3,
+	0xA0555E361951C366, 0xD7E105BCC332621F,
+	0xC86AB5C39FA63440, 0x8DD9472BF3FEFAA7,
+	0xFA856334878FC150, 0xB14F98F6F0FEB951,
+	0x9C935E00D4B9D8D2, 0x6ED1BF9A569F33D3,
+	0xC3B8358109E84F07, 0x0A862F80EC4700C8,
+	0xF4A642E14C6262C8, 0xCD27BB612758C0FA,
+	0x98E7E9CCCFBD7DBD, 0x8038D51CB897789C,
+	0xBF21E44003ACDD2C, 0xE0470A63E6BD56C3,
+	0xEEEA5D5004981478, 0x1858CCFCE06CAC74,
+	0x95527A5202DF0CCB, 0x0F37801E0C43EBC8,
+	0xBAA718E68396CFFD, 0xD30560258F54E6BA,
+	0xE950DF20247C83FD, 0x47C6B82EF32A2069,
+	0x91D28B7416CDD27E, 0x4CDC331D57FA5441,
+	0xB6472E511C81471D, 0xE0133FE4ADF8E952,
+	0xE3D8F9E563A198E5, 0x58180FDDD97723A6,
+	0x8E679C2F5E44FF8F, 0x570F09EAA7EA7648
+};
+
+static const double lept_pow10[] = {
+	1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+struct lept_decimal
+{
+	const char *int_begin, *int_end;    // integer digits
+	const char *frac_begin, *frac_end;  // fraction digits, empty if there is no '.'
+	int64_t exp10;                      // value of the exponent part, saturated
+	int neg;
+};
+
+// (mantissa without the hidden bit, biased exponent), 0x7FF is infinity
+struct lept_adjusted_mantissa
+{
+	uint64_t mantissa;
+	int power2;
+};
+
+struct lept_bigint
+{
+	uint32_t d[LEPT_BIGINT_LIMBS];  // little-endian limbs, no leading zero limbs
+	int n;
+};
+
+static uint64_t lept_umul128(uint64_t a, uint64_t b, uint64_t* hi)
+{
+#if defined(__SIZEOF_INT128__)
+	unsigned __int128 r = static_cast<unsigned __int128>(a) * b;
+	*hi = static_cast<uint64_t>(r >> 64);
+	return static_cast<uint64_t>(r);
+#elif defined(_MSC_VER) && defined(_M_X64)
+	return _umul128(a, b, hi);
+#else
+	uint64_t a_lo = a & 0xFFFFFFFF, a_hi = a >> 32, b_lo = b & 0xFFFFFFFF, b_hi = b >> 32;
+	uint64_t lo_lo = a_lo * b_lo, hi_lo = a_hi * b_lo, lo_hi = a_lo * b_hi, hi_hi = a_hi * b_hi;
+	uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFF) + lo_hi;
+	*hi = (hi_lo >> 32) + (cross >> 32) + hi_hi;
+	return (cross << 32) | (lo_lo & 0xFFFFFFFF);
+#endif
+}
+
+static int lept_clz64(uint64_t x)
+{
+	assert(x != 0);
+#if defined(_MSC_VER) && defined(_M_X64)
+	unsigned long i;
+	_BitScanReverse64(&i, x);
+	return 63 - static_cast<int>(i);
+#elif defined(_MSC_VER)
+	unsigned long i;
+	if (_BitScanReverse(&i, static_cast<unsigned long>(x >> 32)))
+		return 31 - static_cast<int>(i);
+	_BitScanReverse(&i, static_cast<unsigned long>(x));
+	return 63 - static_cast<int>(i);
+#else
+	return __builtin_clzll(x);
+#endif
+}
+
+// eight ASCII digits at once (SWAR); the caller has already checked they are all digits
+static uint64_t lept_parse_eight_digits(const char* p)
+{
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	uint64_t val = 0;
+	for (int i = 0; i < 8; i++)
+		val = val * 10 + (p[i] - '0');
+	return val;
+#else
+	uint64_t val;
+	memcpy(&val, p, 8);
+	val = (val & 0x0F0F0F0F0F0F0F0F) * 2561 >> 8;
+	val = (val & 0x00FF00FF00FF00FF) * 6553601 >> 16;
+	return (val & 0x0000FFFF0000FFFF) * 42949672960001 >> 32;
+#endif
+}
+
+// The correctly rounded w * 10^q for w < 2^64, or the nearest neighbour in either direction
+// when w has been truncated from a longer digit string.
+static lept_adjusted_mantissa lept_eisel_lemire(int64_t q, uint64_t w)
+{
+	lept_adjusted_mantissa am;
+	uint64_t hi, lo;
+	if (w == 0 || q < LEPT_POW5_MIN_EXP)
+	{
+		am.mantissa = 0;
+		am.power2 = 0;
+		return am;
+	}
+	if (q > LEPT_POW5_MAX_EXP)
+	{
+		am.mantissa = 0;
+		am.power2 = 0x7FF;
+		return am;
+	}
+	int lz = lept_clz64(w);
+	w <<= lz;
+	const uint64_t* pow5 = lept_pow5_128 + 2 * (q - LEPT_POW5_MIN_EXP);
+	lo = lept_umul128(w, pow5[0], &hi);
+	if ((hi & 0x1FF) == 0x1FF)  /* the low 9 bits are below the 55 we keep, refine with the second word */
+	{
+		uint64_t hi2;
+		lept_umul128(w, pow5[1], &hi2);
+		lo += hi2;
+		if (hi2 > lo)
+			hi++;
+	}
+	int upperbit = static_cast<int>(hi >> 63);
+	int shift = upperbit + 64 - 52 - 3;
+	am.mantissa = hi >> shift;
+	am.power2 = static_cast<int>((((152170 + 65536) * q) >> 16) + 63) + upperbit - lz + 1023;
+	if (am.power2 <= 0)  /* subnormal */
+	{
+		if (-am.power2 + 1 >= 64)
+		{
+			am.mantissa = 0;
+			am.power2 = 0;
+			return am;
+		}
+		am.mantissa >>= -am.power2 + 1;
+		am.mantissa += am.mantissa & 1;
+		am.mantissa >>= 1;
+		am.power2 = am.mantissa < (static_cast<uint64_t>(1) << 52) ? 0 : 1;
+		return am;
+	}
+	// exactly halfway between two doubles: round to even instead of up
+	if (lo <= 1 && q >= -4 && q <= 23 && (am.mantissa & 3) == 1 && (am.mantissa << shift) == hi)
+		am.mantissa &= ~static_cast<uint64_t>(1);
+	am.mantissa += am.mantissa & 1;
+	am.mantissa >>= 1;
+	if (am.mantissa >= (static_cast<uint64_t>(2) << 52))
+	{
+		am.mantissa = static_cast<uint64_t>(1) << 52;
+		am.power2++;
+	}
+	am.mantissa &= ~(static_cast<uint64_t>(1) << 52);
+	if (am.power2 >= 0x7FF)
+	{
+		am.mantissa = 0;
+		am.power2 = 0x7FF;
+	}
+	return am;
+}
+
+static void lept_bigint_mul_add(lept_bigint* b, uint32_t m, uint32_t a)
+{
+	uint64_t carry = a;
+	for (int i = 0; i < b->n; i++)
+	{
+		uint64_t t = static_cast<uint64_t>(b->d[i]) * m + carry;
+		b->d[i] = static_cast<uint32_t>(t);
+		carry = t >> 32;
+	}
+	if (carry)
+	{
+		assert(b->n < LEPT_BIGINT_LIMBS);
+		b->d[b->n++] = static_cast<uint32_t>(carry);
+	}
+}
+
+static void lept_bigint_mul_pow5(lept_bigint* b, int64_t e)
+{
+	static const uint32_t pow5[] = { 1, 5, 25, 125, 625, 3125, 15625, 78125, 390625, 1953125, 9765625, 48828125, 244140625, 1220703125 };
+	for (; e >= 13; e -= 13)
+		lept_bigint_mul_add(b, pow5[13], 0);
+	lept_bigint_mul_add(b, pow5[e], 0);
+}
+
+static void lept_bigint_shl(lept_bigint* b, int64_t s)
+{
+	int limbs = static_cast<int>(s / 32), bits = static_cast<int>(s % 32);
+	if (bits)
+	{
+		uint32_t carry = 0;
+		for (int i = 0; i < b->n; i++)
+		{
+			uint32_t t = b->d[i];
+			b->d[i] = (t << bits) | carry;
+			carry = t >> (32 - bits);
+		}
+		if (carry)
+		{
+			assert(b->n < LEPT_BIGINT_LIMBS);
+			b->d[b->n++] = carry;
+		}
+	}
+	if (limbs)
+	{
+		assert(b->n + limbs <= LEPT_BIGINT_LIMBS);
+		memmove(b->d + limbs, b->d, b->n * sizeof(uint32_t));
+		memset(b->d, 0, limbs * sizeof(uint32_t));
+		b->n += limbs;
+	}
+}
+
+static int lept_bigint_compare(const lept_bigint* a, const lept_bigint* b)
+{
+	if (a->n != b->n)
+		return a->n < b->n ? -1 : 1;
+	for (int i = a->n - 1; i >= 0; i--)
+		if (a->d[i] != b->d[i])
+			return a->d[i] < b->d[i] ? -1 : 1;
+	return 0;
+}
+
+// Slow path for long inputs whose truncation left two candidates: compare the exact
+// decimal value against the halfway point between them.
+static lept_adjusted_mantissa lept_decimal_compare(const lept_decimal* d, lept_adjusted_mantissa lo, lept_adjusted_mantissa hi)
+{
+	static const uint32_t pow10[] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000 };
+	const char* runs[2][2] = { { d->int_begin, d->int_end }, { d->frac_begin, d->frac_end } };
+	lept_bigint x, h;
+	int64_t e10 = d->exp10 - (d->frac_end - d->frac_begin);
+	int kept = 0, sticky = 0, chunk_len = 0;
+	uint32_t chunk = 0;
+	x.n = 0;
+	for (int r = 0; r < 2; r++)
+	{
+		const char* p = runs[r][0];
+		if (kept == 0)
+			while (p != runs[r][1] && *p == '0')
+				p++;
+		for (; p != runs[r][1]; p++)
+		{
+			if (kept == LEPT_DECIMAL_MAX_DIGITS)
+			{
+				sticky |= *p != '0';
+				e10++;
+				continue;
+			}
+			chunk = chunk * 10 + (*p - '0');
+			kept++;
+			if (++chunk_len == 9)
+			{
+				lept_bigint_mul_add(&x, pow10[9], chunk);
+				chunk = 0;
+				chunk_len = 0;
+			}
+		}
+	}
+	if (chunk_len)
+		lept_bigint_mul_add(&x, pow10[chunk_len], chunk);
+
+	// halfway point (2m + 1) * 2^(e - 1) above lo
+	uint64_t m = lo.mantissa;
+	int64_t e = -1074;
+	if (lo.power2 != 0)
+	{
+		m |= static_cast<uint64_t>(1) << 52;
+		e = lo.power2 - 1075;
+	}
+	m = 2 * m + 1;
+	h.d[0] = static_cast<uint32_t>(m);
+	h.d[1] = static_cast<uint32_t>(m >> 32);
+	h.n = h.d[1] ? 2 : 1;
+
+	if (e10 >= 0)
+		lept_bigint_mul_pow5(&x, e10);
+	else
+		lept_bigint_mul_pow5(&h, -e10);
+	if (e10 - (e - 1) >= 0)
+		lept_bigint_shl(&x, e10 - (e - 1));
+	else
+		lept_bigint_shl(&h, (e - 1) - e10);
+
+	int cmp = lept_bigint_compare(&x, &h);
+	if (cmp == 0 && sticky)
+		cmp = 1;
+	if (cmp == 0)
+		return (lo.mantissa & 1) ? hi : lo;
+	return cmp > 0 ? hi : lo;
+}
+
+static int lept_decimal_to_double(const lept_decimal* d, double* n)
+{
+	const char* runs[2][2] = { { d->int_begin, d->int_end }, { d->frac_begin, d->frac_end } };
+	uint64_t w = 0;
+	int64_t digits = 0;  /* significant digits, the first 19 of which are in w */
+	for (int r = 0; r < 2; r++)
+	{
+		const char *p = runs[r][0], *end = runs[r][1];
+		if (digits == 0)
+			while (p != end && *p == '0')
+				p++;
+		for (; digits + 8 <= 19 && end - p >= 8; p += 8, digits += 8)
+			w = w * 100000000 + lept_parse_eight_digits(p);
+		for (; digits < 19 && p != end; p++, digits++)
+			w = w * 10 + (*p - '0');
+		digits += end - p;
+	}
+	int64_t q = d->exp10 - (d->frac_end - d->frac_begin) + (digits > 19 ? digits - 19 : 0);
+
+#if !defined(FLT_EVAL_METHOD) || FLT_EVAL_METHOD == 0
+	// both w and 10^|q| are exact doubles, so one IEEE operation rounds correctly
+	if (digits <= 19 && q >= -22 && q <= 22 && w <= (static_cast<uint64_t>(1) << 53))
+	{
+		double r = static_cast<double>(w);
+		r = q < 0 ? r / lept_pow10[-q] : r * lept_pow10[q];
+		*n = d->neg ? -r : r;
+		return LEPT_PARSE_OK;
+	}
+#endif
+
+	lept_adjusted_mantissa am = lept_eisel_lemire(q, w);
+	if (digits > 19)
+	{
+		lept_adjusted_mantissa am1 = lept_eisel_lemire(q, w + 1);
+		if (am.mantissa != am1.mantissa || am.power2 != am1.power2)
+			am = lept_decimal_compare(d, am, am1);
+	}
+	if (am.power2 == 0x7FF)
+		return LEPT_PARSE_NUMBER_TOO_BIG;
+	uint64_t bits = am.mantissa | (static_cast<uint64_t>(am.power2) << 52) | (static_cast<uint64_t>(d->neg) << 63);
+	memcpy(n, &bits, sizeof(double));
+	return LEPT_PARSE_OK;
+}
+
+// Integers that fit 64 bits are stored exactly; returns 0 when the double path must take over.
+static int lept_parse_integer(const lept_decimal* d, lept_value* v)
+{
+	const char *p = d->int_begin, *end = d->int_end;
+	uint64_t u = 0;
+	if (end - p > 20 || (d->neg && *p == '0'))  /* "-0" is the double -0.0 */
+		return 0;
+	for (; end - p >= 8 && p - d->int_begin < 16; p += 8)  /* 16 digits cannot overflow */
+		u = u * 100000000 + lept_parse_eight_digits(p);
+	for (; p != end; p++)
+	{
+		unsigned digit = *p - '0';
+		if (u > (UINT64_MAX - digit) / 10)
+			return 0;
+		u = u * 10 + digit;
+	}
+	if (d->neg)
+	{
+		if (u > static_cast<uint64_t>(1) << 63)
+			return 0;
+		v->i = static_cast<int64_t>(0 - u);
+		v->ntype = LEPT_NUMBER_INT64;
+	}
+	else if (u <= static_cast<uint64_t>(INT64_MAX))
+	{
+		v->i = static_cast<int64_t>(u);
+		v->ntype = LEPT_NUMBER_INT64;
+	}
+	else
+	{
+		v->u = u;
+		v->ntype = LEPT_NUMBER_UINT64;
+	}
+	v->type = LEPT_NUMBER;
+	return 1;
+}
+
+static int lept_parse_number(lept_context* c, lept_value* v)
+{
+	const char *p = c->json, *end = c->end;
+	lept_decimal d;
+	int ret, integer = 1;
+	d.neg = 0;
+	d.exp10 = 0;
+	if (CHAR_AT(p, end) == '-')
+	{
+		d.neg = 1;
+		p++;
+	}
+	d.int_begin = p;
+	if (CHAR_AT(p, end) == '0')
+		p++;
+	else
+	{
+		if (!ISDIGIT(CHAR_AT(p, end)))
+			return LEPT_PARSE_INVALID_VALUE;
+		do p++; while (ISDIGIT(CHAR_AT(p, end)));
+	}
+	d.int_end = d.frac_begin = d.frac_end = p;
+	if (CHAR_AT(p, end) == '.')
+	{
+		p++;
+		if (!ISDIGIT(CHAR_AT(p, end)))
+			return LEPT_PARSE_INVALID_VALUE;
+		d.frac_begin = p;
+		do p++; while (ISDIGIT(CHAR_AT(p, end)));
+		d.frac_end = p;
+		integer = 0;
+	}
+	if (CHAR_AT(p, end) == 'e' || CHAR_AT(p, end) == 'E')
+	{
+		int exp_neg = 0;
+		integer = 0;
+		p++;
+		if (CHAR_AT(p, end) == '+' || CHAR_AT(p, end) == '-')
+			exp_neg = *p++ == '-';
+		if (!ISDIGIT(CHAR_AT(p, end)))
+			return LEPT_PARSE_INVALID_VALUE;
+		do
+		{
+			if (d.exp10 < 100000)  /* far beyond any double, the digit count cannot bring it back */
+				d.exp10 = d.exp10 * 10 + (*p - '0');
+			p++;
+		} while (ISDIGIT(CHAR_AT(p, end)));
+		if (exp_neg)
+			d.exp10 = -d.exp10;
+	}
+	if (!integer || !lept_parse_integer(&d, v))
+	{
+		if ((ret = lept_decimal_to_double(&d, &v->n)) != LEPT_PARSE_OK)
+			return ret;
+		v->type = LEPT_NUMBER;
+		v->ntype = LEPT_NUMBER_DOUBLE;
+	}
+	c->json = p;
+	return LEPT_PARSE_OK;
+}
+
+static const char* lept_parse_hex4(const char* p, const char* end, unsigned* u)
+{
+	int i;
+	*u = 0;
+	if (end - p < 4)
+		return NULL;
+	for (i = 0; i < 4; i++)
+	{
+		char ch = *p++;
+		*u <<= 4;
+		if      (ch >= '0' && ch <= '9') *u |= ch - '0';
+		else if (ch >= 'A' && ch <= 'F') *u |= ch - 'A' + 10;
+		else if (ch >= 'a' && ch <= 'f') *u |= ch - 'a' + 10;
+		else return NULL;
+	}
+	return p;
+}
+
+static void lept_encode_utf8(lept_context* c, unsigned u)
+{
+	if (u <= 0x7F)
+		PUTC(c, u & 0xFF);
+	else if (u <= 0x7FF)
+	{
+		PUTC(c, 0xC0 | ((u >> 6) & 0xFF));
+		PUTC(c, 0x80 | ( u       & 0x3F));
+	}
+	else if (u <= 0xFFFF)
+	{
+		PUTC(c, 0xE0 | ((u >> 12) & 0xFF));
+		PUTC(c, 0x80 | ((u >>  6) & 0x3F));
+		PUTC(c, 0x80 | ( u        & 0x3F));
+	}
+	else
+	{
+		assert(u <= 0x10FFFF);
+		PUTC(c, 0xF0 | ((u >> 18) & 0xFF));
+		PUTC(c, 0x80 | ((u >> 12) & 0x3F));
+		PUTC(c, 0x80 | ((u >>  6) & 0x3F));
+		PUTC(c, 0x80 | ( u        & 0x3F));
+	}
+}
+
+#define STRING_ERROR(ret) do {c->top = head; return ret;}while(0)
+
+// On success *str points either into the input (no escapes, nothing was pushed) or at the
+// unescaped bytes just popped off the stack; either way the caller copies it out at once.
+static int lept_parse_string_raw(lept_context* c, const char** str, size_t* len)
+{
+	size_t head = c->top;
+	unsigned u, u2; // for unicode to utf8
+	const char* p;
+	EXPECT(c, '\"');
+	p = c->json;
+	while (1)
+	{
+		const char* q = lept_scan_string(p, c->end);
+		if (q == c->end)
+			STRING_ERROR(LEPT_PARSE_MISS_QUOTATION_MARK);
+		if (*q == '\"' && c->top == head)
+		{
+			*str = p;
+			*len = q - p;
+			c->json = q + 1;
+			return LEPT_PARSE_OK;
+		}
+		if (q != p)
+			PUTS(c, p, q - p);
+		p = q;
+		char ch = *p++;
 		switch (ch)
 		{
-		case '\"':
-			*len = c->top - head;
-			*str = (char*)lept_context_pop(c, *len);
-			c->json = p;
+		case '\"':
+			*len = c->top - head;
+			*str = (char*)lept_context_pop(c, *len);
+			c->json = p;
+			return LEPT_PARSE_OK;
+		case '\\':
+			switch (p != c->end ? *p++ : '\0')
+			{
+			case '\"': PUTC(c, '\"'); break;
+			case '\\': PUTC(c, '\\'); break;
+			case '/':  PUTC(c, '/' ); break;
+			case 'b':  PUTC(c, '\b'); break;
+			case 'f':  PUTC(c, '\f'); break;
+			case 'n':  PUTC(c, '\n'); break;
+			case 'r':  PUTC(c, '\r'); break;
+			case 't':  PUTC(c, '\t'); break;
+			case 'u':
+				if (!(p = lept_parse_hex4(p, c->end, &u)))
+					STRING_ERROR(LEPT_PARSE_INVALID_UNICODE_HEX);
+				if (u >= 0xD800 && u <= 0xDBFF)
+				{
+					if (c->end - p < 2 || *p++ != '\\')
+						STRING_ERROR(LEPT_PARSE_INVALID_UNICODE_SURROGATE);
+					if (*p++ != 'u')
+						STRING_ERROR(LEPT_PARSE_INVALID_UNICODE_SURROGATE);
+					if (!(p = lept_parse_hex4(p, c->end, &u2)))
+						STRING_ERROR(LEPT_PARSE_INVALID_UNICODE_HEX);
+					if (u2<0xDC00 || u2>0xDFFF)
+						STRING_ERROR(LEPT_PARSE_INVALID_UNICODE_SURROGATE);
+					u = (((u - 0xD800) << 10) | (u2 - 0xDC00)) + 0x10000;
+				}
+				lept_encode_utf8(c, u);
+				break;
+			default:
+				STRING_ERROR(LEPT_PARSE_INVALID_STRING_ESCAPE);
+			}
+			break;
+		default:
+			assert((unsigned char)ch < 0x20);
+			STRING_ERROR(LEPT_PARSE_INVALID_STRING_CHAR);
+		}
+	}
+}
+
+// in-situ: the unescaped bytes are written back over the string's own source, which is never
+// shorter, and the closing quote (or the byte after the last one moved) becomes the '\0'
+static int lept_parse_string_insitu(lept_context* c, char** s, size_t* len)
+{
+	char* dst = const_cast<char*>(c->json) + 1;
+	const char* str;
+	int ret;
+	assert(c->insitu);
+	if ((ret = lept_parse_string_raw(c, &str, len)) == LEPT_PARSE_OK)
+	{
+		if (str != dst)
+			memcpy(dst, str, *len);
+		dst[*len] = '\0';
+		*s = dst;
+	}
+	return ret;
+}
+
+static int lept_parse_string(lept_context* c, lept_value* v)
+{
+	int ret;
+	const char* s;
+	size_t len;
+	if (c->insitu)
+	{
+		if ((ret = lept_parse_string_insitu(c, &v->s, &len)) == LEPT_PARSE_OK)
+		{
+			assert(len <= LEPT_COUNT_MAX);
+			v->len = len;
+			v->type = LEPT_STRING;
+			v->flags = LEPT_BORROWED;
+		}
+		return ret;
+	}
+	ret = lept_parse_string_raw(c, &s, &len);
+	if (ret == LEPT_PARSE_OK)
+		lept_set_string(v, s, len);
+	return ret;
+}
+
+// numbers, strings and literals; containers are left to the caller (the push parser)
+static int lept_parse_scalar(lept_context* c, lept_value* v)
+{
+	if (c->json == c->end)
+		return LEPT_PARSE_EXPECT_VALUE;
+	switch (*(c->json))
+	{
+	case 't':  return lept_parse_literal(c, v, "true", LEPT_TRUE);
+	case 'f':  return lept_parse_literal(c, v, "false", LEPT_FALSE);
+	case 'n':  return lept_parse_literal(c, v, "null", LEPT_NULL);
+	case '\"': return lept_parse_string(c, v);
+	default:   return lept_parse_number(c, v);
+	}
+}
+
+/* SAX: one loop reports every value to a lept_handler instead of building it. The open containers
+   are frames on the parse stack, between which strings are unescaped and popped again. */
+
+#define SAX_CALL(h, cb, ...) ((h)->cb == NULL || (h)->cb(__VA_ARGS__) ? LEPT_PARSE_OK : LEPT_PARSE_ABORTED)
+
+struct lept_sax_frame
+{
+	size_t size;              // elements or members so far
+	char close;               // ']' or '}'
+};
+
+#define SAX_TOP(c)   (reinterpret_cast<lept_sax_frame*>((c)->stack + (c)->top) - 1)
+#define SAX_DEPTH(c) ((c)->top / sizeof(lept_sax_frame))
+
+static int lept_sax_string(lept_context* c, const lept_handler* h, void* ctx, int key)
+{
+	const char* s;
+	char* borrowed;
+	size_t len;
+	int ret;
+	if (c->insitu)
+	{
+		ret = lept_parse_string_insitu(c, &borrowed, &len);
+		s = borrowed;
+	}
+	else
+		ret = lept_parse_string_raw(c, &s, &len);
+	if (ret != LEPT_PARSE_OK)
+		return ret;
+	return key ? SAX_CALL(h, key, ctx, s, len) : SAX_CALL(h, string, ctx, s, len);
+}
+
+static int lept_sax_number(lept_context* c, const lept_handler* h, void* ctx)
+{
+	lept_value v;
+	int ret;
+	if ((ret = lept_parse_number(c, &v)) != LEPT_PARSE_OK)
+		return ret;
+	if (v.ntype == LEPT_NUMBER_INT64 && h->int64)
+		return SAX_CALL(h, int64, ctx, v.i);
+	if (v.ntype == LEPT_NUMBER_UINT64 && h->uint64)
+		return SAX_CALL(h, uint64, ctx, v.u);
+	return SAX_CALL(h, number, ctx, lept_get_number(&v));
+}
+
+static int lept_sax_literal(lept_context* c, const lept_handler* h, void* ctx, const char* literal, lept_type type)
+{
+	lept_value v;
+	int ret;
+	if ((ret = lept_parse_literal(c, &v, literal, type)) != LEPT_PARSE_OK)
+		return ret;
+	return type == LEPT_NULL ? SAX_CALL(h, null, ctx) : SAX_CALL(h, boolean, ctx, type == LEPT_TRUE);
+}
+
+// a member's key and the colon after it, up to its value
+static int lept_sax_key(lept_context* c, const lept_handler* h, void* ctx)
+{
+	int ret;
+	if (PEEK(c) != '"')
+		return LEPT_PARSE_MISS_KEY;
+	if ((ret = lept_sax_string(c, h, ctx, 1)) != LEPT_PARSE_OK)
+		return ret;
+	lept_parse_whitespace(c);
+	if (PEEK(c) != ':')
+		return LEPT_PARSE_MISS_COLON;
+	c->json++;
+	lept_parse_whitespace(c);
+	return LEPT_PARSE_OK;
+}
+
+static int lept_sax_open(lept_context* c, const lept_handler* h, void* ctx, size_t max_depth)
+{
+	lept_sax_frame* f;
+	char open = *c->json;
+	if (SAX_DEPTH(c) >= max_depth)
+		return LEPT_PARSE_TOO_DEEP;
+	f = static_cast<lept_sax_frame*>(lept_context_push(c, sizeof(lept_sax_frame)));
+	f->size = 0;
+	f->close = open == '[' ? ']' : '}';
+	c->json++;
+	lept_parse_whitespace(c);
+	return open == '[' ? SAX_CALL(h, start_array, ctx) : SAX_CALL(h, start_object, ctx);
+}
+
+static int lept_sax_close(lept_context* c, const lept_handler* h, void* ctx)
+{
+	lept_sax_frame f = *static_cast<lept_sax_frame*>(lept_context_pop(c, sizeof(lept_sax_frame)));
+	c->json++;
+	return f.close == ']' ? SAX_CALL(h, end_array, ctx, f.size) : SAX_CALL(h, end_object, ctx, f.size);
+}
+
+static int lept_sax_value(lept_context* c, const lept_handler* h, void* ctx, size_t max_depth)
+{
+	lept_sax_frame* f;
+	int ret;
+	while (1)
+	{
+		// a scalar, or the start of a container, which continues with its first value
+		if (c->json == c->end)
+			return LEPT_PARSE_EXPECT_VALUE;
+		switch (*(c->json))
+		{
+		case 't':  ret = lept_sax_literal(c, h, ctx, "true", LEPT_TRUE); break;
+		case 'f':  ret = lept_sax_literal(c, h, ctx, "false", LEPT_FALSE); break;
+		case 'n':  ret = lept_sax_literal(c, h, ctx, "null", LEPT_NULL); break;
+		case '\"': ret = lept_sax_string(c, h, ctx, 0); break;
+		case '[':
+		case '{':
+			if ((ret = lept_sax_open(c, h, ctx, max_depth)) != LEPT_PARSE_OK)
+				return ret;
+			f = SAX_TOP(c);
+			if (PEEK(c) == f->close)
+			{
+				ret = lept_sax_close(c, h, ctx);
+				break;
+			}
+			if (f->close == '}' && (ret = lept_sax_key(c, h, ctx)) != LEPT_PARSE_OK)
+				return ret;
+			continue;
+		default:   ret = lept_sax_number(c, h, ctx); break;
+		}
+		if (ret != LEPT_PARSE_OK)
+			return ret;
+		// the value is complete: count it, then close every container it completes
+		while (1)
+		{
+			if (c->top == 0)
+				return LEPT_PARSE_OK;
+			f = SAX_TOP(c);
+			f->size++;
+			lept_parse_whitespace(c);
+			if (PEEK(c) == ',')
+			{
+				c->json++;
+				lept_parse_whitespace(c);
+				if (f->close == '}' && (ret = lept_sax_key(c, h, ctx)) != LEPT_PARSE_OK)
+					return ret;
+				break;
+			}
+			if (PEEK(c) != f->close)
+				return f->close == ']' ? LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET : LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET;
+			if ((ret = lept_sax_close(c, h, ctx)) != LEPT_PARSE_OK)
+				return ret;
+		}
+	}
+}
+
+static int lept_sax_root(lept_context* c, const lept_handler* h, void* ctx, size_t max_depth)
+{
+	int ret;
+	lept_parse_whitespace(c);
+	ret = lept_sax_value(c, h, ctx, max_depth);
+	if (ret == LEPT_PARSE_OK)
+	{
+		lept_parse_whitespace(c);
+		if (c->json != c->end)
+			ret = LEPT_PARSE_ROOT_NOT_SINGULAR;
+	}
+	assert(ret != LEPT_PARSE_OK || c->top == 0);  // an error may leave open frames behind
+	c->top = 0;
+	return ret;
+}
+
+static int lept_parse_sax_depth(const char* json, size_t len, const lept_handler* handler, void* ctx, size_t max_depth)
+{
+	lept_context c;
+	int ret;
+	assert(handler != NULL && (json != NULL || len == 0));
+	c.json = json;
+	c.end = json + len;
+	c.stack = NULL;
+	c.size = c.top = 0;
+	c.insitu = 0;
+	ret = lept_sax_root(&c, handler, ctx, max_depth);
+	LEPT_FREE(c.stack);
+	return ret;
+}
+
+int lept_parse_sax(const char* json, size_t len, const lept_handler* handler, void* ctx)
+{
+	return lept_parse_sax_depth(json, len, handler, ctx, lept_max_depth);
+}
+
+/* the DOM is built by one handler: finished values wait on a stack until their container ends,
+   an object member waits as its key (kept as a string value) followed by its value */
+
+struct lept_dom_builder
+{
+	lept_context values;      // only its stack is used, apart from the parse stack
+	int insitu;               // strings and keys are borrowed from the input
+	lept_document* doc;       // where the values are allocated, NULL for the heap
+};
+
+static lept_value* lept_dom_push(void* ctx)
+{
+	lept_dom_builder* b = static_cast<lept_dom_builder*>(ctx);
+	lept_value* v = static_cast<lept_value*>(lept_context_push(&b->values, sizeof(lept_value)));
+	lept_init_home(v, b->doc);
+	return v;
+}
+
+static int lept_dom_null(void* ctx)
+{
+	lept_dom_push(ctx);
+	return 1;
+}
+
+static int lept_dom_boolean(void* ctx, int b)
+{
+	lept_set_boolean(lept_dom_push(ctx), b);
+	return 1;
+}
+
+static int lept_dom_number(void* ctx, double n)
+{
+	lept_set_number(lept_dom_push(ctx), n);
+	return 1;
+}
+
+static int lept_dom_int64(void* ctx, int64_t i)
+{
+	lept_set_int64(lept_dom_push(ctx), i);
+	return 1;
+}
+
+static int lept_dom_uint64(void* ctx, uint64_t u)
+{
+	lept_set_uint64(lept_dom_push(ctx), u);
+	return 1;
+}
+
+static int lept_dom_string(void* ctx, const char* s, size_t len)
+{
+	lept_value* v = lept_dom_push(ctx);
+	if (static_cast<lept_dom_builder*>(ctx)->insitu)
+	{
+		v->s = const_cast<char*>(s);  // lept_parse_insitu passed its own mutable buffer
+		v->len = len;
+		v->type = LEPT_STRING;
+		v->flags = LEPT_BORROWED;
+	}
+	else
+		lept_set_string(v, s, len);
+	return 1;
+}
+
+static void lept_set_string_buffer(lept_value* v, const char* s, size_t len);
+
+// a key always gets its own buffer, which lept_dom_end_object hands over to the member
+static int lept_dom_key(void* ctx, const char* s, size_t len)
+{
+	lept_dom_builder* b = static_cast<lept_dom_builder*>(ctx);
+	lept_value* v;
+	if (b->insitu)
+		return lept_dom_string(ctx, s, len);
+	v = lept_dom_push(ctx);
+	if (b->doc == NULL || !b->doc->intern)
+	{
+		lept_set_string_buffer(v, s, len);
+		return 1;
+	}
+	v->s = lept_intern_key(b->doc, s, len);
+	v->len = len;
+	v->type = LEPT_STRING;  // flagged LEPT_ARENA by lept_dom_push, so an error leaves it alone
+	return 1;
+}
+
+static void lept_set_packed(lept_value* v, size_t capacity);
+
+// v becomes an array of the size values at items, which it takes over; unless lept_set_pack_numbers(0)
+// an array of LEPT_PACK_MIN doubles or more is packed
+static void lept_make_array(lept_value* v, const lept_value* items, size_t size)
+{
+	size_t i = 0;
+	int pack = lept_pack_numbers && size >= LEPT_PACK_MIN;
+	if (pack)
+		while (i < size && items[i].type == LEPT_NUMBER && items[i].ntype == LEPT_NUMBER_DOUBLE)
+			i++;
+	if (pack && i == size)
+	{
+		lept_set_packed(v, size);
+		for (i = 0; i < size; i++)
+			v->packed[i] = items[i].n;
+	}
+	else
+	{
+		lept_set_array(v, size);
+		if (size)
+			memcpy(v->e, items, size * sizeof(lept_value));  // set all the elements in the e in one time.
+	}
+	v->size = size;
+}
+
+static int lept_dom_end_array(void* ctx, size_t size)
+{
+	lept_dom_builder* b = static_cast<lept_dom_builder*>(ctx);
+	lept_value a;
+	lept_init_home(&a, b->doc);
+	lept_make_array(&a, size ? static_cast<lept_value*>(lept_context_pop(&b->values, size * sizeof(lept_value))) : NULL, size);
+	memcpy(lept_dom_push(ctx), &a, sizeof(lept_value));
+	return 1;
+}
+
+static int lept_dom_end_object(void* ctx, size_t size)
+{
+	lept_dom_builder* b = static_cast<lept_dom_builder*>(ctx);
+	lept_value o;
+	size_t i;
+	lept_init_home(&o, b->doc);
+	lept_set_object(&o, size);
+	if (size)
+	{
+		// the key strings are not freed, their buffers become the member keys
+		lept_value* kv = static_cast<lept_value*>(lept_context_pop(&b->values, 2 * size * sizeof(lept_value)));
+		for (i = 0; i < size; i++)
+		{
+			o.m[i].k = kv[2 * i].s;
+			o.m[i].klen = kv[2 * i].len;
+			memcpy(&o.m[i].v, &kv[2 * i + 1], sizeof(lept_value));
+		}
+	}
+	o.msize = size;
+	lept_index_build(&o);
+	if (b->insitu)
+		o.flags |= LEPT_BORROWED_KEYS;
+	memcpy(lept_dom_push(ctx), &o, sizeof(lept_value));
+	return 1;
+}
+
+static const lept_handler lept_dom_handler = {
+	lept_dom_null, lept_dom_boolean, lept_dom_number, lept_dom_int64, lept_dom_uint64,
+	lept_dom_string, lept_dom_key, NULL, lept_dom_end_object, NULL, lept_dom_end_array
+};
+
+// the parse stack and the value stack are the caller's, left empty but not freed
+static int lept_parse_dom(lept_value* v, lept_context* c, lept_context* values, lept_document* doc)
+{
+	lept_dom_builder b;
+	int ret;
+	b.values = *values;
+	b.insitu = c->insitu;
+	b.doc = doc;
+	lept_init_home(v, doc);
+	ret = lept_sax_root(c, &lept_dom_handler, &b, lept_tree_depth());
+	if (ret == LEPT_PARSE_OK)
+	{
+		assert(b.values.top == sizeof(lept_value));
+		memcpy(v, lept_context_pop(&b.values, sizeof(lept_value)), sizeof(lept_value));
+	}
+	// ʱջϻδɵֵ keyҪͷ
+	while (b.values.top > 0)
+		lept_free(static_cast<lept_value*>(lept_context_pop(&b.values, sizeof(lept_value))));
+	*values = b.values;
+	return ret;
+}
+
+static int lept_parse_root(lept_value* v, const char* json, size_t len, int insitu)
+{
+	lept_context c, values;
+	int ret;
+	assert(v != NULL && (json != NULL || len == 0));
+	c.json = json;
+	c.end = json + len;
+	c.stack = NULL;
+	c.size = c.top = 0;
+	c.insitu = insitu;
+	values.stack = NULL;
+	values.size = values.top = 0;
+	ret = lept_parse_dom(v, &c, &values, NULL);
+	LEPT_FREE(c.stack);
+	LEPT_FREE(values.stack);
+	return ret;
+}
+
+int lept_parse(lept_value* v, const char* json)
+{
+	return lept_parse_root(v, json, strlen(json), 0);
+}
+
+int lept_parse_n(lept_value* v, const char* json, size_t len)
+{
+	return lept_parse_root(v, json, len, 0);
+}
+
+int lept_parse_insitu(lept_value* v, char* json)
+{
+	return lept_parse_root(v, json, strlen(json), 1);
+}
+
+lept_document* lept_document_create(void)
+{
+	lept_document* d = static_cast<lept_document*>(LEPT_MALLOC(sizeof(lept_document)));
+	d->blocks = NULL;
+	d->keys = NULL;
+	d->key_count = d->key_capacity = 0;
+	d->intern = 0;
+	lept_init_home(&d->root, d);
+	return d;
+}
+
+void lept_document_destroy(lept_document* d)
+{
+	if (d == NULL)
+		return;
+	while (d->blocks != NULL)
+	{
+		lept_arena_block* next = d->blocks->next;
+		LEPT_FREE(d->blocks);
+		d->blocks = next;
+	}
+	LEPT_FREE(d->keys);
+	LEPT_FREE(d);
+}
+
+// the newest block is the largest, it is kept for the next document
+void lept_document_reset(lept_document* d)
+{
+	assert(d != NULL);
+	if (d->blocks != NULL)
+	{
+		lept_arena_block* b = d->blocks->next;
+		while (b != NULL)
+		{
+			lept_arena_block* next = b->next;
+			LEPT_FREE(b);
+			b = next;
+		}
+		d->blocks->next = NULL;
+		d->blocks->used = 0;
+	}
+	if (d->key_count != 0)
+	{
+		memset(d->keys, 0, d->key_capacity * sizeof(lept_key_entry));  // their characters are gone
+		d->key_count = 0;
+	}
+	lept_init_home(&d->root, d);
+}
+
+void lept_document_set_intern_keys(lept_document* d, int enable)
+{
+	assert(d != NULL);
+	d->intern = enable;
+}
+
+size_t lept_document_get_used(const lept_document* d)
+{
+	size_t used = 0;
+	assert(d != NULL);
+	for (const lept_arena_block* b = d->blocks; b != NULL; b = b->next)
+		used += b->used;
+	return used;
+}
+
+lept_value* lept_document_get_root(lept_document* d)
+{
+	assert(d != NULL);
+	return &d->root;
+}
+
+int lept_parse_document(lept_document* d, const char* json)
+{
+	lept_context c, values;
+	int ret;
+	assert(d != NULL && json != NULL);
+	lept_document_reset(d);
+	c.json = json;
+	c.end = json + strlen(json);
+	c.stack = NULL;
+	c.size = c.top = 0;
+	c.insitu = 0;
+	values.stack = NULL;
+	values.size = values.top = 0;
+	ret = lept_parse_dom(&d->root, &c, &values, d);
+	LEPT_FREE(c.stack);
+	LEPT_FREE(values.stack);
+	return ret;
+}
+
+/* push parser: the document arrives in chunks of any size. Structure is tracked with an explicit
+   frame stack instead of recursion; a scalar is parsed by the lept_parse_* functions as soon as its
+   last byte is seen, straight out of the chunk, or out of a copy when it spans chunks */
+
+enum lept_parser_state
+{
+	LEPT_PARSER_VALUE,          // a value must come next
+	LEPT_PARSER_FIRST_ELEMENT,  // after '[': a value or ']'
+	LEPT_PARSER_FIRST_MEMBER,   // after '{': a key or '}'
+	LEPT_PARSER_KEY,
+	LEPT_PARSER_COLON,
+	LEPT_PARSER_COMMA,          // after a member or element: ',' or the closing bracket
+	LEPT_PARSER_DONE            // the root value is complete, only whitespace may follow
+};
+
+enum lept_parser_pending { LEPT_PENDING_NONE, LEPT_PENDING_STRING, LEPT_PENDING_NUMBER, LEPT_PENDING_LITERAL };
+
+struct lept_parser_frame
+{
+	lept_type type;           // LEPT_ARRAY or LEPT_OBJECT
+	size_t size;              // elements or members pushed on the stack so far
+	char* k; size_t klen;     // key of the member whose value is being parsed
+};
+
+struct lept_parser
+{
+	lept_context c;           // elements and members of the open containers, as in lept_parse
+	lept_parser_frame* frames;
+	size_t depth, frame_capacity;
+	lept_context token;       // a scalar that began in an earlier chunk, kind and whether a '\\' ends it
+	int token_kind, escaped;
+	int state, ret;
+	lept_value root;
+	size_t scratch_limit;     // c and token are shrunk to this after each document
+};
+
+// a stack kept for the next document, but no larger than limit
+static void lept_context_trim(lept_context* c, size_t limit)
+{
+	assert(c->top == 0);
+	if (c->size > limit)
+	{
+		// lept_context_push grows a buffer by half its size, which gets nowhere from a size of 1:
+		// small limits free it, and the next push starts again at LEPT_PARSE_STACK_INIT_SIZE
+		if (limit < LEPT_PARSE_STACK_INIT_SIZE)
+		{
+			LEPT_FREE(c->stack);
+			c->stack = NULL;
+			c->size = 0;
+		}
+		else
+		{
+			c->stack = static_cast<char*>(LEPT_REALLOC(c->stack, limit));
+			c->size = limit;
+		}
+	}
+}
+
+static void lept_parser_add(lept_parser* p, lept_value* v)
+{
+	lept_parser_frame* f;
+	if (p->depth == 0)
+	{
+		memcpy(&p->root, v, sizeof(lept_value));
+		p->state = LEPT_PARSER_DONE;
+		return;
+	}
+	f = &p->frames[p->depth - 1];
+	if (f->type == LEPT_ARRAY)
+		memcpy(lept_context_push(&p->c, sizeof(lept_value)), v, sizeof(lept_value));
+	else
+	{
+		lept_member* m = static_cast<lept_member*>(lept_context_push(&p->c, sizeof(lept_member)));
+		m->k = f->k;
+		m->klen = f->klen;
+		memcpy(&m->v, v, sizeof(lept_value));
+		f->k = NULL;
+	}
+	f->size++;
+	p->state = LEPT_PARSER_COMMA;
+}
+
+static void lept_parser_open(lept_parser* p, lept_type type)
+{
+	lept_parser_frame* f;
+	if (p->depth == lept_tree_depth())
+	{
+		p->ret = LEPT_PARSE_TOO_DEEP;
+		return;
+	}
+	if (p->depth == p->frame_capacity)
+	{
+		p->frame_capacity = p->frame_capacity ? p->frame_capacity + (p->frame_capacity >> 1) : 16;
+		p->frames = static_cast<lept_parser_frame*>(LEPT_REALLOC(p->frames, p->frame_capacity * sizeof(lept_parser_frame)));
+	}
+	f = &p->frames[p->depth++];
+	f->type = type;
+	f->size = 0;
+	f->k = NULL;
+	p->state = type == LEPT_ARRAY ? LEPT_PARSER_FIRST_ELEMENT : LEPT_PARSER_FIRST_MEMBER;
+}
+
+static void lept_parser_close(lept_parser* p)
+{
+	lept_parser_frame* f = &p->frames[--p->depth];
+	lept_value v;
+	lept_init(&v);
+	if (f->type == LEPT_ARRAY)
+	{
+		lept_make_array(&v, f->size ? static_cast<lept_value*>(lept_context_pop(&p->c, f->size * sizeof(lept_value))) : NULL, f->size);
+	}
+	else
+	{
+		lept_set_object(&v, f->size);
+		if (f->size)
+			memcpy(v.m, lept_context_pop(&p->c, f->size * sizeof(lept_member)), f->size * sizeof(lept_member));
+		v.msize = f->size;
+		lept_index_build(&v);
+	}
+	lept_parser_add(p, &v);
+}
+
+// just past the closing quote of a string scanned from q, or NULL if it is not in [q, end);
+// *escaped is set when the last byte is a '\\' whose escaped byte is still to come
+static const char* lept_parser_string_end(const char* q, const char* end, int* escaped)
+{
+	*escaped = 0;
+	while (q != end)
+	{
+		q = lept_scan_string(q, end);
+		if (q == end)
+			break;
+		if (*q == '\"')
+			return q + 1;
+		if (*q == '\\')
+		{
+			if (end - q == 1)
+			{
+				*escaped = 1;
+				return NULL;
+			}
+			q += 2;
+		}
+		else
+			q++;  // control character, lept_parse_string_raw reports it
+	}
+	return NULL;
+}
+
+// a number or literal ends at the first byte that cannot continue it
+static const char* lept_parser_atom_end(int kind, const char* q, const char* end)
+{
+	if (kind == LEPT_PENDING_NUMBER)
+		while (q != end && (ISDIGIT(*q) || *q == '+' || *q == '-' || *q == '.' || *q == 'e' || *q == 'E'))
+			q++;
+	else
+		while (q != end && *q >= 'a' && *q <= 'z')
+			q++;
+	return q != end ? q : NULL;
+}
+
+// Parses the key or scalar value at json. Unless the token is known to end inside [json, end)
+// (final), an error or a number or literal that reaches end may only mean that it continues in
+// the next chunk: if the token is cut off, nothing is kept and NULL is returned.
+static const char* lept_parser_scalar(lept_parser* p, int kind, const char* json, const char* end, int final)
+{
+	lept_parser_frame* f = p->depth ? &p->frames[p->depth - 1] : NULL;
+	lept_value v;
+	const char* str;
+	size_t len;
+	int ret, escaped;
+	p->c.json = json;
+	p->c.end = end;
+	lept_init(&v);
+	if (p->state == LEPT_PARSER_KEY)
+		ret = lept_parse_string_raw(&p->c, &str, &len);
+	else
+		ret = lept_parse_scalar(&p->c, &v);
+	if (!final && (ret != LEPT_PARSE_OK || (kind != LEPT_PENDING_STRING && p->c.json == end))
+		&& (kind == LEPT_PENDING_STRING ? lept_parser_string_end(json + 1, end, &escaped) : lept_parser_atom_end(kind, json, end)) == NULL)
+	{
+		lept_free(&v);
+		return NULL;
+	}
+	if ((p->ret = ret) == LEPT_PARSE_OK)
+	{
+		if (p->state != LEPT_PARSER_KEY)
+			lept_parser_add(p, &v);
+		else
+		{
+			memcpy(f->k = static_cast<char*>(LEPT_MALLOC(len + 1)), str, len);
+			f->k[len] = '\0';
+			f->klen = len;
+			p->state = LEPT_PARSER_COLON;
+		}
+	}
+	return p->c.json;
+}
+
+static void lept_parser_run(lept_parser* p, const char* s, const char* end);
+
+static const char* lept_parser_start_token(lept_parser* p, int kind, const char* s, const char* end)
+{
+	const char* next = lept_parser_scalar(p, kind, s, end, 0);
+	if (next)
+		return next;
+	// the token runs off the end of the chunk: keep its bytes until the rest arrives
+	PUTS(&p->token, s, end - s);
+	p->token_kind = kind;
+	p->escaped = 0;
+	if (kind == LEPT_PENDING_STRING)
+		lept_parser_string_end(s + 1, end, &p->escaped);
+	return end;
+}
+
+static const char* lept_parser_continue_token(lept_parser* p, const char* s, const char* end)
+{
+	const char *t, *next, *token_end;
+	int escaped = 0;
+	if (p->token_kind == LEPT_PENDING_STRING)
+		t = lept_parser_string_end(s + p->escaped, end, &escaped);
+	else
+		t = lept_parser_atom_end(p->token_kind, s, end);
+	if ((t ? t : end) != s)
+		PUTS(&p->token, s, (t ? t : end) - s);
+	if (!t)
+	{
+		p->escaped = escaped;
+		return end;
+	}
+	token_end = p->token.stack + p->token.top;
+	next = lept_parser_scalar(p, p->token_kind, p->token.stack, token_end, 1);
+	p->token_kind = LEPT_PENDING_NONE;
+	// bytes of the token left unparsed ("1-2", "truex") cannot follow a value, running them through
+	// the state machine reports the same error lept_parse would
+	if (p->ret == LEPT_PARSE_OK && next != token_end)
+		lept_parser_run(p, next, token_end);
+	p->token.top = 0;
+	return t;
+}
+
+static void lept_parser_run(lept_parser* p, const char* s, const char* end)
+{
+	while (p->ret == LEPT_PARSE_OK && s != end)
+	{
+		lept_parser_frame* f;
+		if (p->token_kind != LEPT_PENDING_NONE)
+		{
+			s = lept_parser_continue_token(p, s, end);
+			continue;
+		}
+		if (ISWHITESPACE(*s) && (s = lept_skip_whitespace(s + 1, end)) == end)
+			break;
+		switch (p->state)
+		{
+		case LEPT_PARSER_DONE:
+			p->ret = LEPT_PARSE_ROOT_NOT_SINGULAR;
+			break;
+		case LEPT_PARSER_COLON:
+			if (*s++ != ':')
+				p->ret = LEPT_PARSE_MISS_COLON;
+			p->state = LEPT_PARSER_VALUE;
+			break;
+		case LEPT_PARSER_COMMA:
+			f = &p->frames[p->depth - 1];
+			if (*s == ',')
+			{
+				s++;
+				p->state = f->type == LEPT_ARRAY ? LEPT_PARSER_VALUE : LEPT_PARSER_KEY;
+			}
+			else if (*s == (f->type == LEPT_ARRAY ? ']' : '}'))
+			{
+				s++;
+				lept_parser_close(p);
+			}
+			else
+				p->ret = f->type == LEPT_ARRAY ? LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET : LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET;
+			break;
+		case LEPT_PARSER_FIRST_ELEMENT:
+			if (*s == ']')
+			{
+				s++;
+				lept_parser_close(p);
+			}
+			else
+				p->state = LEPT_PARSER_VALUE;
+			break;
+		case LEPT_PARSER_FIRST_MEMBER:
+			if (*s == '}')
+			{
+				s++;
+				lept_parser_close(p);
+			}
+			else
+				p->state = LEPT_PARSER_KEY;
+			break;
+		case LEPT_PARSER_KEY:
+			if (*s != '\"')
+				p->ret = LEPT_PARSE_MISS_KEY;
+			else
+				s = lept_parser_start_token(p, LEPT_PENDING_STRING, s, end);
+			break;
+		default:
+			switch (*s)
+			{
+			case '[': s++; lept_parser_open(p, LEPT_ARRAY); break;
+			case '{': s++; lept_parser_open(p, LEPT_OBJECT); break;
+			case '\"': s = lept_parser_start_token(p, LEPT_PENDING_STRING, s, end); break;
+			case 't': case 'f': case 'n': s = lept_parser_start_token(p, LEPT_PENDING_LITERAL, s, end); break;
+			default:  s = lept_parser_start_token(p, LEPT_PENDING_NUMBER, s, end); break;
+			}
+			break;
+		}
+	}
+}
+
+// drops whatever the last document left behind, ready for the next one
+static void lept_parser_reset(lept_parser* p)
+{
+	size_t i;
+	while (p->depth > 0)
+	{
+		lept_parser_frame* f = &p->frames[--p->depth];
+		for (i = 0; i < f->size; i++)
+		{
+			if (f->type == LEPT_ARRAY)
+				lept_free(static_cast<lept_value*>(lept_context_pop(&p->c, sizeof(lept_value))));
+			else
+			{
+				lept_member* m = static_cast<lept_member*>(lept_context_pop(&p->c, sizeof(lept_member)));
+				LEPT_FREE(m->k);
+				lept_free(&m->v);
+			}
+		}
+		LEPT_FREE(f->k);
+	}
+	assert(p->c.top == 0);
+	lept_free(&p->root);
+	p->token.top = 0;
+	p->token_kind = LEPT_PENDING_NONE;
+	p->state = LEPT_PARSER_VALUE;
+	p->ret = LEPT_PARSE_OK;
+	lept_context_trim(&p->c, p->scratch_limit);
+	lept_context_trim(&p->token, p->scratch_limit);
+}
+
+lept_parser* lept_parser_create(void)
+{
+	lept_parser* p = static_cast<lept_parser*>(LEPT_MALLOC(sizeof(lept_parser)));
+	p->c.stack = p->token.stack = NULL;
+	p->c.size = p->c.top = p->token.size = p->token.top = 0;
+	p->c.insitu = p->token.insitu = 0;
+	p->frames = NULL;
+	p->depth = p->frame_capacity = 0;
+	p->scratch_limit = static_cast<size_t>(-1);
+	lept_init(&p->root);
+	lept_parser_reset(p);
+	return p;
+}
+
+void lept_parser_set_scratch_limit(lept_parser* p, size_t bytes)
+{
+	assert(p != NULL);
+	p->scratch_limit = bytes;
+	lept_parser_reset(p);
+}
+
+void lept_parser_destroy(lept_parser* p)
+{
+	if (p == NULL)
+		return;
+	lept_parser_reset(p);
+	LEPT_FREE(p->c.stack);
+	LEPT_FREE(p->token.stack);
+	LEPT_FREE(p->frames);
+	LEPT_FREE(p);
+}
+
+int lept_parser_feed(lept_parser* p, const char* buf, size_t len)
+{
+	assert(p != NULL && (buf != NULL || len == 0));
+	lept_parser_run(p, buf, buf + len);
+	if (p->ret != LEPT_PARSE_OK)
+		return p->ret;
+	return p->state == LEPT_PARSER_DONE ? LEPT_PARSE_OK : LEPT_PARSE_NEED_MORE;
+}
+
+int lept_parser_finish(lept_parser* p, lept_value* v)
+{
+	int ret;
+	assert(p != NULL && v != NULL);
+	// a number or literal at the very end is only known to be complete now
+	if (p->ret == LEPT_PARSE_OK && p->token_kind != LEPT_PENDING_NONE)
+	{
+		const char* token_end = p->token.stack + p->token.top;
+		const char* next = lept_parser_scalar(p, p->token_kind, p->token.stack, token_end, 1);
+		p->token_kind = LEPT_PENDING_NONE;
+		if (p->ret == LEPT_PARSE_OK && next != token_end)
+			lept_parser_run(p, next, token_end);
+	}
+	if (p->ret == LEPT_PARSE_OK)
+	{
+		switch (p->state)
+		{
+		case LEPT_PARSER_DONE:          break;
+		case LEPT_PARSER_FIRST_MEMBER:
+		case LEPT_PARSER_KEY:           p->ret = LEPT_PARSE_MISS_KEY; break;
+		case LEPT_PARSER_COLON:         p->ret = LEPT_PARSE_MISS_COLON; break;
+		case LEPT_PARSER_COMMA:
+			p->ret = p->frames[p->depth - 1].type == LEPT_ARRAY ? LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET : LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET;
+			break;
+		default:                        p->ret = LEPT_PARSE_EXPECT_VALUE; break;
+		}
+	}
+	lept_init(v);
+	if ((ret = p->ret) == LEPT_PARSE_OK)
+	{
+		memcpy(v, &p->root, sizeof(lept_value));
+		lept_init(&p->root);
+	}
+	lept_parser_reset(p);
+	return ret;
+}
+
+// the whole document at once, through lept_parse's DOM handler: the value stack is c, and the parse
+// stack is the one that otherwise holds a pending token
+int lept_parser_parse(lept_parser* p, lept_value* v, const char* json, size_t len)
+{
+	int ret;
+	assert(p != NULL && v != NULL && (json != NULL || len == 0));
+	lept_parser_reset(p);
+	p->token.json = json;
+	p->token.end = json + len;
+	p->token.insitu = 0;
+	ret = lept_parse_dom(v, &p->token, &p->c, NULL);
+	lept_parser_reset(p);
+	return ret;
+}
+
+/* pull reader: the same scanning as lept_parse, one token per call, with the nesting kept as one
+   byte per open container on the parse stack; states are those of the push parser */
+
+struct lept_reader
+{
+	lept_context c;           // input, and a stack of '[' or '{' below any string being unescaped
+	size_t depth;
+	int state, error;
+	lept_token token;         // the last token returned
+	const char* s; size_t len;  // string or key of the last token
+	lept_value n;             // number of the last token
+};
+
+static lept_token lept_reader_fail(lept_reader* r, int error)
+{
+	r->error = error;
+	return r->token = LEPT_TOKEN_ERROR;
+}
+
+static lept_token lept_reader_open(lept_reader* r, char open)
+{
+	if (r->depth == lept_max_depth)
+		return lept_reader_fail(r, LEPT_PARSE_TOO_DEEP);
+	r->c.json++;
+	PUTC(&r->c, open);
+	r->depth++;
+	if (open == '[')
+	{
+		r->state = LEPT_PARSER_FIRST_ELEMENT;
+		return r->token = LEPT_TOKEN_START_ARRAY;
+	}
+	r->state = LEPT_PARSER_FIRST_MEMBER;
+	return r->token = LEPT_TOKEN_START_OBJECT;
+}
+
+static lept_token lept_reader_close(lept_reader* r)
+{
+	char open = *static_cast<char*>(lept_context_pop(&r->c, 1));
+	r->c.json++;
+	r->state = --r->depth ? LEPT_PARSER_COMMA : LEPT_PARSER_DONE;
+	return r->token = open == '[' ? LEPT_TOKEN_END_ARRAY : LEPT_TOKEN_END_OBJECT;
+}
+
+lept_reader* lept_reader_create(const char* json, size_t len)
+{
+	lept_reader* r = static_cast<lept_reader*>(LEPT_MALLOC(sizeof(lept_reader)));
+	assert(json != NULL || len == 0);
+	r->c.json = json;
+	r->c.end = json + len;
+	r->c.stack = NULL;
+	r->c.size = r->c.top = 0;
+	r->c.insitu = 0;
+	r->depth = 0;
+	r->state = LEPT_PARSER_VALUE;
+	r->error = LEPT_PARSE_OK;
+	r->token = LEPT_TOKEN_END;
+	lept_init(&r->n);
+	return r;
+}
+
+void lept_reader_destroy(lept_reader* r)
+{
+	if (r == NULL)
+		return;
+	LEPT_FREE(r->c.stack);
+	LEPT_FREE(r);
+}
+
+lept_token lept_reader_next(lept_reader* r)
+{
+	lept_context* c = &r->c;
+	lept_value v;
+	int ret;
+	char open;
+	assert(r != NULL);
+	if (r->error != LEPT_PARSE_OK)
+		return LEPT_TOKEN_ERROR;
+	lept_parse_whitespace(c);
+	switch (r->state)
+	{
+	case LEPT_PARSER_DONE:
+		if (c->json != c->end)
+			return lept_reader_fail(r, LEPT_PARSE_ROOT_NOT_SINGULAR);
+		return r->token = LEPT_TOKEN_END;
+	case LEPT_PARSER_COMMA:
+		open = c->stack[c->top - 1];
+		if (PEEK(c) == (open == '[' ? ']' : '}'))
+			return lept_reader_close(r);
+		if (PEEK(c) != ',')
+			return lept_reader_fail(r, open == '[' ? LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET : LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET);
+		c->json++;
+		lept_parse_whitespace(c);
+		r->state = open == '[' ? LEPT_PARSER_VALUE : LEPT_PARSER_KEY;
+		break;
+	case LEPT_PARSER_FIRST_ELEMENT:
+		if (PEEK(c) == ']')
+			return lept_reader_close(r);
+		r->state = LEPT_PARSER_VALUE;
+		break;
+	case LEPT_PARSER_FIRST_MEMBER:
+		if (PEEK(c) == '}')
+			return lept_reader_close(r);
+		r->state = LEPT_PARSER_KEY;
+		break;
+	}
+	if (r->state == LEPT_PARSER_KEY)
+	{
+		// the colon is checked with the key, so the next call starts at the value
+		if (PEEK(c) != '"')
+			return lept_reader_fail(r, LEPT_PARSE_MISS_KEY);
+		if ((ret = lept_parse_string_raw(c, &r->s, &r->len)) != LEPT_PARSE_OK)
+			return lept_reader_fail(r, ret);
+		lept_parse_whitespace(c);
+		if (PEEK(c) != ':')
+			return lept_reader_fail(r, LEPT_PARSE_MISS_COLON);
+		c->json++;
+		r->state = LEPT_PARSER_VALUE;
+		return r->token = LEPT_TOKEN_KEY;
+	}
+	if (c->json == c->end)
+		return lept_reader_fail(r, LEPT_PARSE_EXPECT_VALUE);
+	switch (*c->json)
+	{
+	case '[':  return lept_reader_open(r, '[');
+	case '{':  return lept_reader_open(r, '{');
+	case '\"':
+		ret = lept_parse_string_raw(c, &r->s, &r->len);
+		r->token = LEPT_TOKEN_STRING;
+		break;
+	case 't': case 'f': case 'n':
+		lept_init(&v);
+		ret = lept_parse_scalar(c, &v);
+		r->token = v.type == LEPT_NULL ? LEPT_TOKEN_NULL : v.type == LEPT_TRUE ? LEPT_TOKEN_TRUE : LEPT_TOKEN_FALSE;
+		break;
+	default:
+		ret = lept_parse_number(c, &r->n);
+		r->token = LEPT_TOKEN_NUMBER;
+		break;
+	}
+	if (ret != LEPT_PARSE_OK)
+		return lept_reader_fail(r, ret);
+	r->state = r->depth ? LEPT_PARSER_COMMA : LEPT_PARSER_DONE;
+	return r->token;
+}
+
+int lept_reader_skip(lept_reader* r)
+{
+	size_t depth;
+	assert(r != NULL);
+	if (r->token == LEPT_TOKEN_KEY && lept_reader_next(r) != LEPT_TOKEN_START_ARRAY && r->token != LEPT_TOKEN_START_OBJECT)
+		return r->error;
+	if (r->token != LEPT_TOKEN_START_ARRAY && r->token != LEPT_TOKEN_START_OBJECT)
+		return r->error;
+	// every token inside is still checked, so a skipped subtree reports the same errors
+	for (depth = r->depth; r->depth >= depth; )
+		if (lept_reader_next(r) == LEPT_TOKEN_ERROR)
+			break;
+	return r->error;
+}
+
+int lept_reader_get_error(const lept_reader* r)
+{
+	assert(r != NULL);
+	return r->error;
+}
+
+const char* lept_reader_get_string(const lept_reader* r)
+{
+	assert(r != NULL && (r->token == LEPT_TOKEN_STRING || r->token == LEPT_TOKEN_KEY));
+	return r->s;
+}
+size_t lept_reader_get_string_length(const lept_reader* r)
+{
+	assert(r != NULL && (r->token == LEPT_TOKEN_STRING || r->token == LEPT_TOKEN_KEY));
+	return r->len;
+}
+
+double lept_reader_get_number(const lept_reader* r)
+{
+	assert(r != NULL && r->token == LEPT_TOKEN_NUMBER);
+	return lept_get_number(&r->n);
+}
+lept_number_type lept_reader_get_number_type(const lept_reader* r)
+{
+	assert(r != NULL && r->token == LEPT_TOKEN_NUMBER);
+	return lept_get_number_type(&r->n);
+}
+int64_t lept_reader_get_int64(const lept_reader* r)
+{
+	assert(r != NULL && r->token == LEPT_TOKEN_NUMBER);
+	return lept_get_int64(&r->n);
+}
+uint64_t lept_reader_get_uint64(const lept_reader* r)
+{
+	assert(r != NULL && r->token == LEPT_TOKEN_NUMBER);
+	return lept_get_uint64(&r->n);
+}
+
+/* two-stage parsing: stage one indexes every structural position with the block classifier,
+   stage two builds the tree by walking that index instead of the bytes in between */
+
+static unsigned lept_ctz64(uint64_t x)
+{
+	assert(x != 0);
+#if defined(_MSC_VER) && defined(_M_X64)
+	unsigned long i;
+	_BitScanForward64(&i, x);
+	return i;
+#elif defined(_MSC_VER)
+	return static_cast<uint32_t>(x) ? lept_ctz(static_cast<uint32_t>(x)) : 32 + lept_ctz(static_cast<uint32_t>(x >> 32));
+#else
+	return __builtin_ctzll(x);
+#endif
+}
+
+// bit i set when an odd number of bits at or below i are set
+static uint64_t lept_prefix_xor(uint64_t x)
+{
+	x ^= x << 1;
+	x ^= x << 2;
+	x ^= x << 4;
+	x ^= x << 8;
+	x ^= x << 16;
+	x ^= x << 32;
+	return x;
+}
+
+// Unescaped quotes and the bytes inside strings (opening quote in, closing quote out) of a
+// classified block; an escape or a string still open at its end carries over to the next one.
+static uint64_t lept_block_strings(const lept_block* b, uint64_t* prev_escaped, uint64_t* prev_in_string, uint64_t* quote)
+{
+	// a backslash that is not itself escaped escapes the next byte; backslashes are rare
+	uint64_t escaped = *prev_escaped, starts = b->backslash & ~*prev_escaped;
+	*prev_escaped = 0;
+	while (starts)
+	{
+		uint64_t bit = starts & (0 - starts);
+		if (bit >> 63)
+			*prev_escaped = 1;
+		else
+			escaped |= bit << 1;
+		starts &= ~(bit | (bit << 1));
+	}
+	*quote = b->quote & ~escaped;
+	uint64_t in_string = lept_prefix_xor(*quote) ^ *prev_in_string;
+	*prev_in_string = 0 - (in_string >> 63);
+	return in_string;
+}
+
+// Stage one: offsets of every unescaped quote, of every operator outside strings and of the
+// first byte of every number or literal. Returns 0 when the input ends inside a string.
+static int lept_build_index(const char* json, size_t len, uint32_t* index, size_t* count)
+{
+	uint64_t prev_escaped = 0, prev_in_string = 0, prev_scalar = 0;
+	size_t n = 0;
+	char pad[64];
+	for (size_t base = 0; base < len; base += 64)
+	{
+		const char* p = json + base;
+		lept_block b;
+		if (len - base < 64)
+		{
+			memset(pad, ' ', sizeof(pad));
+			memcpy(pad, p, len - base);
+			p = pad;
+		}
+		lept_classify(p, &b);
+		uint64_t quote, in_string = lept_block_strings(&b, &prev_escaped, &prev_in_string, &quote);
+		uint64_t scalar = ~(b.op | b.whitespace | quote | in_string);
+		uint64_t structural = (b.op & ~in_string) | quote | (scalar & ~((scalar << 1) | prev_scalar));
+		prev_scalar = scalar >> 63;
+		for (; structural; structural &= structural - 1)
+			index[n++] = static_cast<uint32_t>(base + lept_ctz64(structural));
+	}
+	*count = n;
+	return prev_in_string == 0;
+}
+
+struct lept_index_context
+{
+	lept_context c;           // scalars are still decoded by the lept_parse_* functions
+	const char* json;
+	const uint32_t* index;
+	size_t pos, count;
+	size_t depth;             // open arrays and objects
+};
+
+#define INDEX_PEEK(ic) ((ic)->pos < (ic)->count ? (ic)->json[(ic)->index[(ic)->pos]] : '\0')
+
+static int lept_parse_indexed_value(lept_index_context* ic, lept_value* v);
+
+static int lept_parse_indexed_string(lept_index_context* ic, const char** str, size_t* len)
+{
+	int ret;
+	ic->c.json = ic->json + ic->index[ic->pos];
+	if ((ret = lept_parse_string_raw(&ic->c, str, len)) != LEPT_PARSE_OK)
+		return ret;
+	// nothing inside a string is indexed, so the closing quote is the next entry
+	assert(ic->pos + 1 < ic->count && ic->c.json == ic->json + ic->index[ic->pos + 1] + 1);
+	ic->pos += 2;
+	return LEPT_PARSE_OK;
+}
+
+static int lept_parse_indexed_array(lept_index_context* ic, lept_value* v)
+{
+	size_t i, size = 0;
+	int ret;
+	ic->pos++;
+	if (INDEX_PEEK(ic) == ']')
+	{
+		ic->pos++;
+		lept_set_array(v, 0);
+		return LEPT_PARSE_OK;
+	}
+	while (1)
+	{
+		lept_value e;
+		lept_init(&e);
+		if ((ret = lept_parse_indexed_value(ic, &e)) != LEPT_PARSE_OK)
+			break;
+		memcpy(lept_context_push(&ic->c, sizeof(lept_value)), &e, sizeof(lept_value));
+		size++;
+		if (INDEX_PEEK(ic) == ',')
+			ic->pos++;
+		else if (INDEX_PEEK(ic) == ']')
+		{
+			ic->pos++;
+			lept_make_array(v, static_cast<lept_value*>(lept_context_pop(&ic->c, size * sizeof(lept_value))), size);
 			return LEPT_PARSE_OK;
-		case '\\':
-			switch (*p++)
+		}
+		else
+		{
+			ret = LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET;
+			break;
+		}
+	}
+	for (i = 0; i < size; i++)
+		lept_free((lept_value*)lept_context_pop(&ic->c, sizeof(lept_value)));
+	return ret;
+}
+
+static int lept_parse_indexed_object(lept_index_context* ic, lept_value* v)
+{
+	size_t i, size = 0;
+	lept_member m;
+	int ret;
+	ic->pos++;
+	if (INDEX_PEEK(ic) == '}')
+	{
+		ic->pos++;
+		lept_set_object(v, 0);
+		return LEPT_PARSE_OK;
+	}
+	m.k = NULL;
+	while (1)
+	{
+		const char* str;
+		lept_init(&m.v);
+		if (INDEX_PEEK(ic) != '"')
+		{
+			ret = LEPT_PARSE_MISS_KEY;
+			break;
+		}
+		if ((ret = lept_parse_indexed_string(ic, &str, &m.klen)) != LEPT_PARSE_OK)
+			break;
+		memcpy(m.k = (char*)LEPT_MALLOC(m.klen + 1), str, m.klen);
+		m.k[m.klen] = '\0';
+		if (INDEX_PEEK(ic) != ':')
+		{
+			ret = LEPT_PARSE_MISS_COLON;
+			break;
+		}
+		ic->pos++;
+		if ((ret = lept_parse_indexed_value(ic, &m.v)) != LEPT_PARSE_OK)
+			break;
+		memcpy(lept_context_push(&ic->c, sizeof(lept_member)), &m, sizeof(lept_member));
+		size++;
+		m.k = NULL;
+		if (INDEX_PEEK(ic) == ',')
+			ic->pos++;
+		else if (INDEX_PEEK(ic) == '}')
+		{
+			ic->pos++;
+			lept_set_object(v, size);
+			memcpy(v->m, lept_context_pop(&ic->c, sizeof(lept_member) * size), sizeof(lept_member) * size);
+			v->msize = size;
+			lept_index_build(v);
+			return LEPT_PARSE_OK;
+		}
+		else
+		{
+			ret = LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET;
+			break;
+		}
+	}
+	LEPT_FREE(m.k);
+	for (i = 0; i < size; i++)
+	{
+		lept_member* wrong_m = (lept_member*)lept_context_pop(&ic->c, sizeof(lept_member));
+		LEPT_FREE(wrong_m->k);
+		lept_free(&wrong_m->v);
+	}
+	v->type = LEPT_NULL;
+	return ret;
+}
+
+static int lept_parse_indexed_value(lept_index_context* ic, lept_value* v)
+{
+	const char* str;
+	size_t len;
+	int ret;
+	if (ic->pos == ic->count)
+		return LEPT_PARSE_EXPECT_VALUE;
+	ic->c.json = ic->json + ic->index[ic->pos];
+	switch (*ic->c.json)
+	{
+	case '[':
+	case '{':
+		if (ic->depth == lept_tree_depth())
+			return LEPT_PARSE_TOO_DEEP;
+		ic->depth++;
+		ret = *ic->c.json == '[' ? lept_parse_indexed_array(ic, v) : lept_parse_indexed_object(ic, v);
+		ic->depth--;
+		return ret;
+	case '\"':
+		if ((ret = lept_parse_indexed_string(ic, &str, &len)) == LEPT_PARSE_OK)
+			lept_set_string(v, str, len);
+		return ret;
+	case ']': case '}': case ':': case ',':
+		return LEPT_PARSE_INVALID_VALUE;
+	case 't':  ret = lept_parse_literal(&ic->c, v, "true", LEPT_TRUE); break;
+	case 'f':  ret = lept_parse_literal(&ic->c, v, "false", LEPT_FALSE); break;
+	case 'n':  ret = lept_parse_literal(&ic->c, v, "null", LEPT_NULL); break;
+	default:   ret = lept_parse_number(&ic->c, v); break;
+	}
+	ic->pos++;
+	// the token must end where whitespace or the next indexed byte begins, or trailing bytes would be skipped
+	if (ret == LEPT_PARSE_OK && ic->c.json != ic->c.end && !ISWHITESPACE(*ic->c.json)
+		&& (ic->pos == ic->count || ic->c.json != ic->json + ic->index[ic->pos]))
+	{
+		lept_free(v);
+		ret = LEPT_PARSE_INVALID_VALUE;
+	}
+	return ret;
+}
+
+int lept_parse_indexed(lept_value* v, const char* json)
+{
+	lept_index_context ic;
+	size_t len = strlen(json);
+	uint32_t* index;
+	int ret = LEPT_PARSE_MISS_QUOTATION_MARK;
+	assert(v != NULL);
+	if (len >= UINT32_MAX)
+		return lept_parse(v, json);
+	lept_init(v);
+	index = (uint32_t*)LEPT_MALLOC((len + 1) * sizeof(uint32_t));
+	if (lept_build_index(json, len, index, &ic.count))
+	{
+		ic.c.json = json;
+		ic.c.end = json + len;
+		ic.c.stack = NULL;
+		ic.c.size = ic.c.top = 0;
+		ic.c.insitu = 0;
+		ic.json = json;
+		ic.index = index;
+		ic.pos = 0;
+		ic.depth = 0;
+		ret = lept_parse_indexed_value(&ic, v);
+		if (ret == LEPT_PARSE_OK && ic.pos != ic.count)
+		{
+			lept_free(v);
+			ret = LEPT_PARSE_ROOT_NOT_SINGULAR;
+		}
+		assert(ic.c.top == 0);
+		LEPT_FREE(ic.c.stack);
+	}
+	LEPT_FREE(index);
+	// invalid input is the rare case: let lept_parse report the exact error it finds
+	if (ret != LEPT_PARSE_OK)
+		return lept_parse(v, json);
+	return ret;
+}
+
+/* lazy document: the input is validated once, then an array or object keeps its source until an
+   accessor first looks inside it and only that level is built; nested containers stay lazy */
+
+// end of a container already validated, found 64 bytes at a time with the classification the
+// structural index uses: only brackets outside strings are looked at
+static const char* lept_skip_container(const char* p, const char* end)
+{
+	uint64_t prev_escaped = 0, prev_in_string = 0;
+	size_t depth = 0;
+	char pad[64];
+	for (;; p += 64)
+	{
+		const char* block = p;
+		lept_block b;
+		if (end - p < 64)
+		{
+			memset(pad, ' ', sizeof(pad));
+			memcpy(pad, p, end - p);
+			block = pad;
+		}
+		lept_classify(block, &b);
+		uint64_t quote, in_string = lept_block_strings(&b, &prev_escaped, &prev_in_string, &quote);
+		for (uint64_t op = b.op & ~in_string; op; op &= op - 1)
+		{
+			unsigned i = lept_ctz64(op);
+			if (block[i] == '[' || block[i] == '{')
+				depth++;
+			else if ((block[i] == ']' || block[i] == '}') && --depth == 0)
+				return p + i + 1;
+		}
+	}
+}
+
+static void lept_parse_lazy_value(lept_context* c, lept_value* v)
+{
+	const char* p = c->json;
+	int ret;
+	if (*p == '[' || *p == '{')
+	{
+		c->json = lept_skip_container(p, c->end);
+		v->type = *p == '[' ? LEPT_ARRAY : LEPT_OBJECT;
+		LEPT_SET_SRC(v, p, c->json);
+		v->flags = LEPT_LAZY;
+		return;
+	}
+	ret = lept_parse_scalar(c, v);
+	assert(ret == LEPT_PARSE_OK);
+	(void)ret;
+}
+
+// builds one level the way lept_parse does, with the DOM handler's stack and end callbacks
+static void lept_expand(lept_value* v)
+{
+	lept_context c;
+	lept_dom_builder b;
+	const char* key;
+	size_t size = 0, klen;
+	char close = v->type == LEPT_ARRAY ? ']' : '}';
+	assert(v->flags & LEPT_LAZY);
+	c.json = v->src + 1;
+	c.end = LEPT_SRC_END(v);
+	c.stack = NULL;
+	c.size = c.top = 0;
+	c.insitu = 0;
+	b.values.stack = NULL;
+	b.values.size = b.values.top = 0;
+	b.insitu = 0;
+	b.doc = NULL;
+	lept_parse_whitespace(&c);
+	while (*c.json != close)
+	{
+		if (close == '}')
+		{
+			lept_parse_string_raw(&c, &key, &klen);
+			lept_dom_key(&b, key, klen);
+			lept_parse_whitespace(&c);
+			c.json++;  // ':'
+			lept_parse_whitespace(&c);
+		}
+		lept_parse_lazy_value(&c, lept_dom_push(&b));
+		size++;
+		lept_parse_whitespace(&c);
+		if (*c.json == ',')
+		{
+			c.json++;
+			lept_parse_whitespace(&c);
+		}
+	}
+	if (close == ']')
+		lept_dom_end_array(&b, size);
+	else
+		lept_dom_end_object(&b, size);
+	memcpy(v, lept_context_pop(&b.values, sizeof(lept_value)), sizeof(lept_value));
+	LEPT_FREE(c.stack);
+	LEPT_FREE(b.values.stack);
+}
+
+// set by the first lept_parse_lazy, before any lazy value exists
+static std::atomic<int> lept_lazy_parsed(0);
+
+int lept_parse_lazy(lept_value* v, const char* json)
+{
+	static const lept_handler validate = { NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL };
+	lept_context c;
+	size_t len;
+	int ret;
+	assert(v != NULL && json != NULL);
+	lept_init(v);
+	len = strlen(json);
+	if ((ret = lept_parse_sax_depth(json, len, &validate, NULL, lept_tree_depth())) != LEPT_PARSE_OK)
+		return ret;
+	lept_lazy_parsed.store(1, std::memory_order_relaxed);
+	c.json = json;
+	c.end = json + len;
+	c.stack = NULL;
+	c.size = c.top = 0;
+	c.insitu = 0;
+	lept_parse_whitespace(&c);
+	lept_parse_lazy_value(&c, v);
+	LEPT_FREE(c.stack);
+	return LEPT_PARSE_OK;
+}
+
+/* parallel parsing of one large array: a quote-aware pre-scan with the block classifier picks
+   commas between elements as split points, a pool of threads parses the chunks between them
+   into buffers of their own, then copies them in input order into the one array */
+
+#ifndef LEPT_PARALLEL_MIN
+#define LEPT_PARALLEL_MIN (1 << 20)  // smaller inputs are parsed on the calling thread
+#endif
+
+#ifndef LEPT_PARALLEL_CHUNKS
+#define LEPT_PARALLEL_CHUNKS 8       // chunks per thread, so one slow chunk does not hold up the rest
+#endif
+
+struct lept_chunk
+{
+	const char *begin, *end;  // elements and the commas between them, not those around them
+	lept_value* items;        // the parsed elements, in the chunk's own buffer
+	size_t size, offset;      // element count, index of the first one in the whole array
+	int doubles;              // all of them are double numbers
+	int ret;
+};
+
+// Splits the array at json into at most max chunks at commas of depth 1, the first ones at or
+// after each multiple of step. Returns the chunk count, with the closing bracket in *close, or 0
+// when the input ends inside the array or a string, or nests deeper than lept_tree_depth().
+static size_t lept_split_array(const char* json, const char* end, size_t step, lept_chunk* chunks, const char** close)
+{
+	uint64_t prev_escaped = 0, prev_in_string = 0;
+	const char* next = json + step;
+	size_t depth = 0, n = 0;
+	char pad[64];
+	assert(*json == '[' && step > 0);
+	chunks[0].begin = json + 1;
+	for (const char* p = json; p < end; p += 64)
+	{
+		const char* block = p;
+		lept_block b;
+		if (end - p < 64)
+		{
+			memset(pad, ' ', sizeof(pad));
+			memcpy(pad, p, end - p);
+			block = pad;
+		}
+		lept_classify(block, &b);
+		uint64_t quote, in_string = lept_block_strings(&b, &prev_escaped, &prev_in_string, &quote);
+		for (uint64_t op = b.op & ~in_string; op; op &= op - 1)
+		{
+			unsigned i = lept_ctz64(op);
+			switch (block[i])
 			{
-			case '\"': PUTC(c, '\"'); break;
-			case '\\': PUTC(c, '\\'); break;
-			case '/':  PUTC(c, '/' ); break;
-			case 'b':  PUTC(c, '\b'); break;
-			case 'f':  PUTC(c, '\f'); break;
-			case 'n':  PUTC(c, '\n'); break;
-			case 'r':  PUTC(c, '\r'); break;
-			case 't':  PUTC(c, '\t'); break;
-			case 'u':
-				if (!(p = lept_parse_hex4(p, &u)))
-					STRING_ERROR(LEPT_PARSE_INVALID_UNICODE_HEX);
-				if (u >= 0xD800 && u <= 0xDBFF)
+			case '[':
+			case '{':
+				if (++depth > lept_tree_depth())
+					return 0;
+				break;
+			case ']':
+			case '}':
+				if (--depth == 0)
 				{
-					if (*p++ != '\\')
-						STRING_ERROR(LEPT_PARSE_INVALID_UNICODE_SURROGATE);
-					if (*p++ != 'u')
-						STRING_ERROR(LEPT_PARSE_INVALID_UNICODE_SURROGATE);
-					if (!(p = lept_parse_hex4(p, &u2)))
-						STRING_ERROR(LEPT_PARSE_INVALID_UNICODE_HEX);
-					if (u2<0xDC00 || u2>0xDFFF)
-						STRING_ERROR(LEPT_PARSE_INVALID_UNICODE_SURROGATE);
-					u = (((u - 0xD800) << 10) | (u2 - 0xDC00)) + 0x10000;
+					chunks[n].end = *close = p + i;
+					return n + 1;
+				}
+				break;
+			case ',':
+				if (depth == 1 && p + i >= next)
+				{
+					chunks[n++].end = p + i;
+					chunks[n].begin = p + i + 1;
+					next = p + i + step;
 				}
-				lept_encode_utf8(c, u);
 				break;
-			default:
-				STRING_ERROR(LEPT_PARSE_INVALID_STRING_ESCAPE);
 			}
+		}
+	}
+	return 0;
+}
+
+// the elements of k, parsed by the DOM handler; they are left on its value stack, which becomes
+// k->items
+static void lept_parse_chunk(lept_chunk* k)
+{
+	lept_context c;
+	lept_dom_builder b;
+	c.json = k->begin;
+	c.end = k->end;
+	c.stack = NULL;
+	c.size = c.top = 0;
+	c.insitu = 0;
+	b.values.stack = NULL;
+	b.values.size = b.values.top = 0;
+	b.insitu = 0;
+	b.doc = NULL;
+	lept_parse_whitespace(&c);
+	while ((k->ret = lept_sax_value(&c, &lept_dom_handler, &b, lept_tree_depth())) == LEPT_PARSE_OK)
+	{
+		lept_parse_whitespace(&c);
+		if (c.json == c.end)
 			break;
-		case '\0':
-			STRING_ERROR(LEPT_PARSE_MISS_QUOTATION_MARK);
-		default:
-			if ((unsigned char)ch < 0x20)
-				STRING_ERROR(LEPT_PARSE_INVALID_STRING_CHAR);
-			PUTC(c, ch);
+		if (*c.json != ',')
+		{
+			k->ret = LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET;
+			break;
+		}
+		c.json++;
+		lept_parse_whitespace(&c);
+	}
+	if (k->ret != LEPT_PARSE_OK)
+	{
+		c.top = 0;
+		while (b.values.top > 0)
+			lept_free(static_cast<lept_value*>(lept_context_pop(&b.values, sizeof(lept_value))));
+	}
+	LEPT_FREE(c.stack);
+	k->items = reinterpret_cast<lept_value*>(b.values.stack);
+	k->size = b.values.top / sizeof(lept_value);
+	k->doubles = 1;
+	for (size_t i = 0; i < k->size && k->doubles; i++)
+		k->doubles = k->items[i].type == LEPT_NUMBER && k->items[i].ntype == LEPT_NUMBER_DOUBLE;
+}
+
+// moves the elements of k to their place in the array v, then frees its buffer
+static void lept_stitch_chunk(lept_chunk* k, lept_value* v)
+{
+	if (v->flags & LEPT_PACKED)
+		for (size_t i = 0; i < k->size; i++)
+			v->packed[k->offset + i] = k->items[i].n;
+	else if (k->size)
+		memcpy(v->e + k->offset, k->items, k->size * sizeof(lept_value));
+	LEPT_FREE(k->items);
+}
+
+// the calling thread and threads - 1 more call work(i) for each i below count, taking the next
+// one as they finish, until none is left. A thread that cannot be started (thread limit, memory)
+// is no error: those started and the calling thread take its share.
+template <class Work>
+static void lept_run_tasks(size_t count, unsigned threads, Work work)
+{
+	std::atomic<size_t> next(0);
+	std::vector<std::thread> pool;
+	auto worker = [&]() {
+		for (size_t i; (i = next++) < count; )
+			work(i);
+	};
+	try
+	{
+		for (unsigned t = 1; t < threads && t < count; t++)
+			pool.emplace_back(worker);
+	}
+	catch (const std::system_error&)
+	{
+	}
+	catch (const std::bad_alloc&)
+	{
+	}
+	worker();
+	for (size_t t = 0; t < pool.size(); t++)
+		pool[t].join();
+}
+
+int lept_parse_parallel(lept_value* v, const char* json, size_t len, unsigned threads)
+{
+	const char *p, *close, *end = json + len;
+	lept_chunk* chunks;
+	size_t i, count, size = 0;
+	int doubles = 1;
+	assert(v != NULL && (json != NULL || len == 0));
+	if (threads == 0)
+		threads = std::thread::hardware_concurrency();
+	p = lept_skip_whitespace_scalar(json, end);
+	if (threads <= 1 || len < LEPT_PARALLEL_MIN || p == end || *p != '[')
+		return lept_parse_n(v, json, len);
+	count = static_cast<size_t>(threads) * LEPT_PARALLEL_CHUNKS;
+	chunks = static_cast<lept_chunk*>(LEPT_MALLOC(count * sizeof(lept_chunk)));
+	// the splits are more than step apart, so there are fewer than count of them
+	count = lept_split_array(p, end, (end - p) / count + 1, chunks, &close);
+	if (count < 2 || *close != ']' || lept_skip_whitespace(close + 1, end) != end)
+	{
+		LEPT_FREE(chunks);
+		return lept_parse_n(v, json, len);
+	}
+	lept_run_tasks(count, threads, [chunks](size_t i) { lept_parse_chunk(&chunks[i]); });
+	for (i = 0; i < count && chunks[i].ret == LEPT_PARSE_OK; i++)
+	{
+		chunks[i].offset = size;
+		size += chunks[i].size;
+		doubles = doubles && chunks[i].doubles;
+	}
+	if (i < count)
+	{
+		// invalid input is the rare case: let lept_parse_n report the exact error it finds
+		for (i = 0; i < count; i++)
+		{
+			for (size_t j = 0; j < chunks[i].size; j++)
+				lept_free(&chunks[i].items[j]);
+			LEPT_FREE(chunks[i].items);
 		}
+		LEPT_FREE(chunks);
+		return lept_parse_n(v, json, len);
 	}
+	lept_init_home(v, NULL);
+	if (lept_pack_numbers && doubles && size >= LEPT_PACK_MIN)
+		lept_set_packed(v, size);
+	else
+		lept_set_array(v, size);
+	v->size = size;
+	lept_run_tasks(count, threads, [chunks, v](size_t i) { lept_stitch_chunk(&chunks[i], v); });
+	LEPT_FREE(chunks);
+	return LEPT_PARSE_OK;
 }
 
-static int lept_parse_string(lept_context* c, lept_value* v)
+/* newline-delimited JSON: a window of whole lines is split at line ends into chunks, which a pool
+   of threads parses, each thread with a lept_parser of its own; the records are then handed over
+   in input order on the calling thread before the next window is parsed */
+
+#ifndef LEPT_NDJSON_WINDOW
+#define LEPT_NDJSON_WINDOW (1 << 20)  // bytes of input per thread in a window
+#endif
+
+struct lept_record
 {
+	size_t line;              // within its chunk, from 0
 	int ret;
-	char* s;
-	size_t len;
-	ret = lept_parse_string_raw(c, &s, &len);
-	if (ret == LEPT_PARSE_OK)
-		lept_set_string(v, s, len);
-	return ret;
-}
+	lept_value v;
+};
 
-static int lept_parse_value(lept_context* c, lept_value* v); // 
+struct lept_ndjson_chunk
+{
+	const char *begin, *end;  // whole lines, the last one maybe without its '\n'
+	lept_context records;     // its lept_records; the stack is kept from one window to the next
+	size_t lines;             // line ends in [begin, end)
+	int done;                 // parsed, under the window's mutex
+};
 
-static int lept_parse_array(lept_context* c, lept_value* v)
+struct lept_ndjson
 {
-	size_t i, size = 0;
-	int ret;
-	EXPECT(c, '[');
-	lept_parse_whitespace(c);
-	if (*c->json == ']')
+	lept_ndjson_chunk* chunks;
+	size_t count;             // chunks per window
+	lept_parser** parsers;    // one per thread, so are their scratch buffers
+	unsigned threads;
+	size_t line, records;     // lines before the window, records handed over
+	int (*record)(void* ctx, size_t line, int ret, lept_value* v);
+	void* ctx;
+};
+
+static void lept_ndjson_init(lept_ndjson* nd, unsigned threads, int (*record)(void*, size_t, int, lept_value*), void* ctx)
+{
+	if (threads == 0)
+		threads = std::thread::hardware_concurrency();
+	nd->threads = threads > 0 ? threads : 1;
+	nd->count = static_cast<size_t>(nd->threads) * LEPT_PARALLEL_CHUNKS;
+	nd->chunks = static_cast<lept_ndjson_chunk*>(LEPT_MALLOC(nd->count * sizeof(lept_ndjson_chunk)));
+	for (size_t i = 0; i < nd->count; i++)
 	{
-		c->json++;
-		lept_set_array(v, 0);
-		return LEPT_PARSE_OK;
+		nd->chunks[i].records.stack = NULL;
+		nd->chunks[i].records.size = nd->chunks[i].records.top = 0;
 	}
-	while (1)
+	nd->parsers = static_cast<lept_parser**>(LEPT_MALLOC(nd->threads * sizeof(lept_parser*)));
+	for (unsigned t = 0; t < nd->threads; t++)
+		nd->parsers[t] = lept_parser_create();
+	nd->line = nd->records = 0;
+	nd->record = record;
+	nd->ctx = ctx;
+}
+
+static void lept_ndjson_free(lept_ndjson* nd)
+{
+	for (size_t i = 0; i < nd->count; i++)
+		LEPT_FREE(nd->chunks[i].records.stack);
+	for (unsigned t = 0; t < nd->threads; t++)
+		lept_parser_destroy(nd->parsers[t]);
+	LEPT_FREE(nd->chunks);
+	LEPT_FREE(nd->parsers);
+}
+
+// every line of k that is not blank becomes a record, a failed one with a null value
+static void lept_ndjson_parse_chunk(lept_ndjson_chunk* k, lept_parser* p)
+{
+	const char *s = k->begin, *nl, *e;
+	k->records.top = 0;
+	k->lines = 0;
+	for (; s != k->end; s = nl + 1, k->lines++)
 	{
-		lept_value e;
-		lept_init(&e);
-		if ((ret = lept_parse_value(c, &e))!=LEPT_PARSE_OK)
-			break;
-		memcpy(lept_context_push(c, sizeof(lept_value)), &e, sizeof(lept_value));
-		size++;
-		lept_parse_whitespace(c);
-		if (*c->json == ',')
-		{
-			c->json++;
-			lept_parse_whitespace(c);
-		}
-		else if (*c->json == ']')
+		nl = static_cast<const char*>(memchr(s, '\n', k->end - s));
+		e = nl != NULL ? nl : k->end;
+		if (lept_skip_whitespace(s, e) != e)  // '\r' before '\n' is whitespace as well
 		{
-			c->json++;
-			lept_set_array(v, size);
-			memcpy(v->e, lept_context_pop(c, size * sizeof(lept_value)), size * sizeof(lept_value)); // set all the elements in the e in one time.
-			// elept_free()ͷţΪeַܰĵַvҪõַַָ˲ͷ
-			v->size = size;
-			return LEPT_PARSE_OK;
+			lept_record* r = static_cast<lept_record*>(lept_context_push(&k->records, sizeof(lept_record)));
+			r->line = k->lines;
+			lept_init(&r->v);
+			r->ret = lept_parser_parse(p, &r->v, s, e - s);
 		}
-		else
-		{
-			ret = LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET;
+		if (nl == NULL)
 			break;
-		}
 	}
-	// pop and free values on the stack
-	// ˣѾŵstackҪͷ
-	for (i=0;i<size;i++)
-		lept_free((lept_value*)lept_context_pop(c, sizeof(lept_value)));
-	return ret;
 }
 
-static int lept_parse_object(lept_context* c, lept_value* v)
+// parses the lines [json, end) and hands their records over; returns 0 once the callback has
+// asked to stop, the records after that one are dropped
+static int lept_ndjson_window(lept_ndjson* nd, const char* json, const char* end)
 {
-	size_t i, size = 0;
-	lept_member m;
-	// mڵvkҲҪlept_free()ͷţַҪⲿv
-	int ret;
-	EXPECT(c, '{');
-	lept_parse_whitespace(c);
-	if (*c->json == '}')
+	size_t count = 0, step = (end - json) / nd->count + 1;
+	int go = 1;
+	// each chunk but the last is longer than step, so there are at most nd->count of them
+	for (const char *p = json, *q; p != end; p = q)
 	{
-		c->json++;
-		lept_set_object(v, 0);
-		return LEPT_PARSE_OK;
+		const char* nl = static_cast<size_t>(end - p) > step ? static_cast<const char*>(memchr(p + step, '\n', end - p - step)) : NULL;
+		q = nl != NULL ? nl + 1 : end;
+		nd->chunks[count].begin = p;
+		nd->chunks[count++].end = q;
 	}
-	m.k = NULL;
-	while (1)
+	// the calling thread hands the chunks over in order as soon as they are parsed, and parses
+	// the next free one while it waits, so that records are used while they are still in cache
+	std::atomic<size_t> next(0);
+	std::mutex m;
+	std::condition_variable parsed;
+	std::vector<std::thread> pool;
+	auto parse = [&](size_t i, unsigned t) {
+		lept_ndjson_parse_chunk(&nd->chunks[i], nd->parsers[t]);
+		std::lock_guard<std::mutex> lock(m);
+		nd->chunks[i].done = 1;
+		parsed.notify_one();
+	};
+	auto worker = [&](unsigned t) {
+		for (size_t i; (i = next++) < count; )
+			parse(i, t);
+	};
+	for (size_t i = 0; i < count; i++)
+		nd->chunks[i].done = 0;
+	// as in lept_run_tasks, a thread that cannot be started leaves its chunks to the others
+	try
 	{
-		char* str;
-		lept_init(&m.v);
-		// parse key
-		if (*c->json != '"')
-		{
-			ret = LEPT_PARSE_MISS_KEY;
-			break;
-		}
-		ret = lept_parse_string_raw(c, &str, &m.klen);
-		if (ret != LEPT_PARSE_OK)
-			break;
-		memcpy(m.k = (char*)malloc(m.klen + 1), str, m.klen);
-		m.k[m.klen] = '\0';
-		// parse ws colon ws
-		lept_parse_whitespace(c);
-		if (*c->json != ':')
-		{
-			ret = LEPT_PARSE_MISS_COLON;
-			break;
-		}
-		c->json++;
-		lept_parse_whitespace(c);
-		// parse value
-		ret = lept_parse_value(c, &m.v);
-		if (ret != LEPT_PARSE_OK)
-			break;
-		memcpy(lept_context_push(c, sizeof(lept_member)), &m, sizeof(lept_member));
-		size++;
-		m.k = NULL;
-
-		lept_parse_whitespace(c);
-		if (*c->json == ',')
+		for (unsigned t = 1; t < nd->threads && t < count; t++)
+			pool.emplace_back(worker, t);
+	}
+	catch (const std::system_error&)
+	{
+	}
+	catch (const std::bad_alloc&)
+	{
+	}
+	size_t i, j;
+	for (i = 0; i < count && go; i++)
+	{
+		lept_ndjson_chunk* k = &nd->chunks[i];
+		std::unique_lock<std::mutex> lock(m);
+		while (!k->done)
 		{
-			c->json++;
-			lept_parse_whitespace(c);
+			lock.unlock();
+			if ((j = next++) < count)
+				parse(j, 0);
+			lock.lock();
+			if (j >= count)
+				parsed.wait(lock, [k]() { return k->done != 0; });
 		}
-		else if (*c->json == '}')
+		lock.unlock();
+		lept_record* r = reinterpret_cast<lept_record*>(k->records.stack);
+		for (j = 0; j < k->records.top / sizeof(lept_record); j++)
 		{
-			c->json++;
-			lept_set_object(v, size);
-			memcpy(v->m, lept_context_pop(c, sizeof(lept_member)* size), sizeof(lept_member)* size);
-			v->msize = size;
-			return LEPT_PARSE_OK;
+			if (go)
+			{
+				go = nd->record(nd->ctx, nd->line + r[j].line + 1, r[j].ret, &r[j].v);
+				nd->records++;
+			}
+			lept_free(&r[j].v);
 		}
-		else
+		nd->line += k->lines;
+	}
+	// after a stop the chunks nobody has taken yet are left alone, those parsed are dropped
+	next = count;
+	for (size_t t = 0; t < pool.size(); t++)
+		pool[t].join();
+	for (; i < count; i++)
+		if (nd->chunks[i].done)
 		{
-			ret = LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET;
-			break;
+			lept_record* r = reinterpret_cast<lept_record*>(nd->chunks[i].records.stack);
+			for (j = 0; j < nd->chunks[i].records.top / sizeof(lept_record); j++)
+				lept_free(&r[j].v);
 		}
-	}
-	// pop and free members on the stack
-	free(m.k);
-	for (i = 0; i < size; i++)
-	{
-		lept_member* wrong_m = (lept_member*)lept_context_pop(c, sizeof(lept_member));
-		free(wrong_m->k);
-		lept_free(&wrong_m->v);
-	}
-	v->type = LEPT_NULL;
-	return ret;
-
+	return go;
 }
 
-static int lept_parse_value(lept_context* c, lept_value* v)
+size_t lept_parse_ndjson(const char* json, size_t len, unsigned threads, int (*record)(void* ctx, size_t line, int ret, lept_value* v), void* ctx)
 {
-	switch (*(c->json))
+	lept_ndjson nd;
+	const char *p = json, *end = json + len;
+	assert(record != NULL && (json != NULL || len == 0));
+	lept_ndjson_init(&nd, threads, record, ctx);
+	size_t window = nd.threads * static_cast<size_t>(LEPT_NDJSON_WINDOW);
+	for (const char* q; p != end; p = q)
 	{
-	case 't':  return lept_parse_literal(c, v, "true", LEPT_TRUE);
-	case 'f':  return lept_parse_literal(c, v, "false", LEPT_FALSE);
-	case 'n':  return lept_parse_literal(c, v, "null", LEPT_NULL);
-	case '\0': return LEPT_PARSE_EXPECT_VALUE;
-	case '\"': return lept_parse_string(c, v);
-	case '[':  return lept_parse_array(c, v);
-	case '{':  return lept_parse_object(c, v);
-	default:   return lept_parse_number(c, v);
+		const char* nl = static_cast<size_t>(end - p) > window ? static_cast<const char*>(memchr(p + window, '\n', end - p - window)) : NULL;
+		q = nl != NULL ? nl + 1 : end;
+		if (!lept_ndjson_window(&nd, p, q))
+			break;
 	}
+	lept_ndjson_free(&nd);
+	return nd.records;
 }
 
-int lept_parse(lept_value* v, const char* json)
+size_t lept_parse_ndjson_file(FILE* f, unsigned threads, int (*record)(void* ctx, size_t line, int ret, lept_value* v), void* ctx)
 {
-	lept_context c;
-	int ret;
-	assert(v != NULL);
-	c.json = json;
-	c.stack = NULL;
-	c.size = c.top = 0;
-	lept_init(v);
-	lept_parse_whitespace(&c);
-	ret = lept_parse_value(&c, v);
-	if (ret == LEPT_PARSE_OK)
+	lept_ndjson nd;
+	size_t size = 0, capacity, n;
+	char* buffer;
+	int go = 1;
+	assert(f != NULL && record != NULL);
+	lept_ndjson_init(&nd, threads, record, ctx);
+	capacity = nd.threads * static_cast<size_t>(LEPT_NDJSON_WINDOW);
+	buffer = static_cast<char*>(LEPT_MALLOC(capacity));
+	while (go && (n = fread(buffer + size, 1, capacity - size, f)) > 0)
 	{
-		lept_parse_whitespace(&c);
-		if (*(c.json) != '\0')
+		size += n;
+		// the lines read completely are parsed, the last one waits for the rest of it
+		for (n = size; n > 0 && buffer[n - 1] != '\n'; n--)
+			;
+		if (n > 0)
 		{
-			ret = LEPT_PARSE_ROOT_NOT_SINGULAR;
-			v->type = LEPT_NULL;
+			go = lept_ndjson_window(&nd, buffer, buffer + n);
+			memmove(buffer, buffer + n, size - n);
+			size -= n;
 		}
+		else if (size == capacity)
+			buffer = static_cast<char*>(LEPT_REALLOC(buffer, capacity *= 2));  // a line longer than the buffer
 	}
-	assert(c.top == 0);
-	free(c.stack); // only one free stack
-	return ret;
+	if (go && size > 0)
+		lept_ndjson_window(&nd, buffer, buffer + size);
+	LEPT_FREE(buffer);
+	lept_ndjson_free(&nd);
+	return nd.records;
 }
+
 // 
 static void lept_stringify_string(lept_context *c, const char *s, size_t len)
 {
@@ -432,95 +4241,865 @@ static void lept_stringify_string(lept_context *c, const char *s, size_t len)
 	c->top -= size - (p - head);
 }
 
+static const char lept_digits_lut[] =
+	"00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+	"40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+	"8081828384858687888990919293949596979899";
+
+// writes the decimal digits of u two at a time, returns the end of the output
+static char* lept_u64toa(uint64_t u, char* buffer)
+{
+	char temp[20];
+	char* p = temp;
+	while (u >= 100)
+	{
+		unsigned i = static_cast<unsigned>(u % 100) * 2;
+		u /= 100;
+		*p++ = lept_digits_lut[i + 1];
+		*p++ = lept_digits_lut[i];
+	}
+	if (u < 10)
+		*p++ = static_cast<char>('0' + u);
+	else
+	{
+		*p++ = lept_digits_lut[u * 2 + 1];
+		*p++ = lept_digits_lut[u * 2];
+	}
+	do *buffer++ = *--p; while (p != temp);
+	return buffer;
+}
+
+static char* lept_i64toa(int64_t i, char* buffer)
+{
+	uint64_t u = static_cast<uint64_t>(i);
+	if (i < 0)
+	{
+		*buffer++ = '-';
+		u = 0 - u;
+	}
+	return lept_u64toa(u, buffer);
+}
+
+/* shortest double to string: Schubfach (Raffaello Giulietti, "The Schubfach way to render doubles").
+   Of the decimals that read back to the same double it picks one with the fewest digits, and of
+   those the one closest to the double, so the output is always the shortest round-trip form. */
+
+#define LEPT_SCHUBFACH_K_MIN (-324)
+
+// for k from LEPT_SCHUBFACH_K_MIN to 292: 10^-k = beta * 2^r with 2^125 <= beta < 2^126, and
+// g = floor(beta) + 1 split into its upper and lower 63 bits
+static const uint64_t lept_schubfach_g[] = {
+	0x4F0CEDC95A718DD4, 0x5B01E8B09AA0D1B5, 0x7E7B160EF71C1621, 0x119CA780F767B5EE,
+	0x652F44D8C5B011B4, 0x0E16EC672C52F7F2, 0x50F29D7A37C00E29, 0x581256B8F0425FF5,
+	0x40C21794F96671BA, 0x79A84560C0351991, 0x679CF287F570B5F7, 0x75DA089ACD21C281,
+	0x52E3F5399126F7F9, 0x44AE6D48A41B0201, 0x424FF76140EBF994, 0x36F1F106E9AF34CD,
+	0x6A198BCECE465C20, 0x57E981A4A918547B, 0x54E13CA571D1E34D, 0x2CBACE1D541376C9,
+	0x43E763B78E4182A4, 0x23C8A4E44342C56E, 0x6CA56C58E39C043A, 0x060DD4A06B9E08B0,
+	0x56EABD13E9499CFB, 0x1E7176E6BC7E6D59, 0x458897432107B0C8, 0x7EC12BEBC9FEBDE1,
+	0x6F40F20501A5E7A7, 0x7E01DFDFA9979635, 0x5900C19D9AEB1FB9, 0x4B34B319547944F7,
+	0x4733CE17AF227FC7, 0x55C3C27AA9FA9D93, 0x71EC7CF2B1D0CC72, 0x560603F7765DC8EA,
+	0x5B2397288E40A38E, 0x7804CFF92B7E3A55, 0x48E945BA0B66E93F, 0x13370CC755FE9511,
+	0x74A86F90123E41FE, 0x51F1AE0BBCCA881B, 0x5D538C7341CB67FE, 0x74C1580963D539AF,
+	0x4AA93D29016F8665, 0x43CDE0078310FAF3, 0x77752EA8024C0A3C, 0x0616333F381B2B1E,
+	0x5F90F22001D66E96, 0x3811C298F9AF55B1, 0x4C73F4E667DEBEDE, 0x600E35472E25DE28,
+	0x7A532170A6313164, 0x3349EED849D6303F, 0x61DC1AC084F42783, 0x42A18BE03B11C033,
+	0x4E49AF006A5CEC69, 0x1BB46FE695A7CCF5, 0x7D42B19A43C7E0A8, 0x2C53E63DBC3FAE55,
+	0x64355AE1CFD31A20, 0x237651CAFCFFBEAA, 0x502AAF1B0CA8E1B3, 0x35F8416F30CC9888,
+	0x402225AF3D53E7C2, 0x5E603458F3D6E06D, 0x669D0918621FD937, 0x4A3386F4B957CD7B,
+	0x52173A79E8197A92, 0x6E8F9F2A2DDFD796, 0x41AC2EC7ECE12EDB, 0x720C7F54F17FDFAB,
+	0x69137E0CAE3517C6, 0x1CE0CBBB1BFFCC45, 0x540F980A24F74638, 0x171A3C95AFFFD69E,
+	0x433FACD4EA5F6B60, 0x127B63AAF3331218, 0x6B991487DD657899, 0x6A5F05DE51EB5026,
+	0x5614106CB11DFA14, 0x5518D17EA7EF7352, 0x44DCD9F08DB194DD, 0x2A7A41321FF2C2A8,
+	0x6E2E2980E2B5BAFB, 0x5D906850331E043F, 0x5824EE00B55E2F2F, 0x647386A68F4B3699,
+	0x4683F19A2AB1BF59, 0x36C2D21ED908F87B, 0x70D31C29DDE93228, 0x579E1CFE280E5A5D,
+	0x5A427CEE4B20F4ED, 0x2C7E7D98200B7B7E, 0x483530BEA280C3F1, 0x09FECAE019A2C932,
+	0x73884DFDD0CE064E, 0x43314499C29E0EB6, 0x5C6D0B3173D8050B, 0x4F5A9D47CEE4D891,
+	0x49F0D5C129799DA2, 0x72AEE4397250AD41, 0x764E22CEA8C295D1, 0x377E39F583B44868,
+	0x5EA4E8A553CEDE41, 0x12CB61913629D387, 0x4BB72084430BE500, 0x756F8140F8217605,
+	0x792500D39E796E67, 0x6F18CECE59CF233C, 0x60EA670FB1FABEB9, 0x3F470BD847D8E8FD,
+	0x4D885272F4C89894, 0x329F3CAD064720CA, 0x7C0D50B7EE0DC0ED, 0x37652DE1A3A50143,
+	0x633DDA2CBE716724, 0x2C50F1814FB73436, 0x4F64AE8A31F45283, 0x3D0D8E010C92902B,
+	0x7F077DA9E986EA6B, 0x7B48E334E0EA8045, 0x659F97BB2138BB89, 0x49071C2A4D88669D,
+	0x514C796280FA2FA1, 0x20D27CEEA46D1EE4, 0x4109FAB533FB594D, 0x670ECA58838A7F1D,
+	0x680FF788532BC216, 0x0B4ADD5A6C10CB62, 0x533FF939DC2301AB, 0x22A24AAEBCDA3C4E,
+	0x4299942E49B59AEF, 0x354EA22563E1C9D8, 0x6A8F537D42BC2B18, 0x554A9D089FCFA95A,
+	0x553F75FDCEFCEF46, 0x776EE406E63FBAAE, 0x4432C4CB0BFD8C38, 0x5F8BE99F1E996225,
+	0x6D1E07AB466279F4, 0x327975CB64289D08, 0x574B3955D1E86190, 0x28612B091CED4A6D,
+	0x45D5C777DB204E0D, 0x06B4226DB0BDD524, 0x6FBC72595E9A167B, 0x24536A491AC95506,
+	0x59638EADE54811FC, 0x1D0F883A7BD44405, 0x4782D88B1DD34196, 0x4A72D361FCA9D004,
+	0x726AF411C952028A, 0x43EAEBCFFAA94CD3, 0x5B88C3416DDB353B, 0x4FEF230CC88770A9,
+	0x493A35CDF17C2A96, 0x0CBF4F3D6D3926EE, 0x7529EFAFE8C6AA89, 0x61321862485B717C,
+	0x5DBB262653D22207, 0x675B46B506AF8DFD, 0x4AFC1E850FDB4E6C, 0x52AF6BC405593E64,
+	0x77F9CA6E7FC54A47, 0x377F12D33BC1FD6D, 0x5FFB085866376E9F, 0x45FF42429634CABD,
+	0x4CC8D379EB5F8BB2, 0x6B329B68782A3BCB, 0x7ADAEBF64565AC51, 0x2B842BDA59DD2C77,
+	0x6248BCC5045156A7, 0x3C69BCAEAE4A89F9, 0x4EA0970403744552, 0x6387CA25583BA194,
+	0x7DCDBE6CD253A21E, 0x05A6103BC05F68ED, 0x64A498570EA94E7E, 0x37B80CFC99E5ED8A,
+	0x5083AD1272210B98, 0x2C933D96E184BE08, 0x40695741F4E73C79, 0x7075CADF1AD09807,
+	0x670EF2032171FA5C, 0x4D8944982AE759A4, 0x52725B35B45B2EB0, 0x3E076A135585E150,
+	0x41F515C49048F226, 0x64D2BB42AAD1810D, 0x698822D41A0E503E, 0x07B7920444826815,
+	0x546CE8A9AE71D9CB, 0x1FC60E69D0685344, 0x438A53BAF1F4AE3C, 0x196B3EBB0D20429D,
+	0x6C1085F7E9877D2D, 0x0F11FDF815006A94, 0x56739E5FEE05FDBD, 0x58DB319344005543,
+	0x45294B7FF19E6497, 0x60AF5ADC3666AA9C, 0x6EA878CCB5CA3A8C, 0x344BC4938A3DDDC7,
+	0x5886C70A2B082ED6, 0x5D096A0FA1CB17D2, 0x46D238D4EF39BF12, 0x173ABB3FB4A27975,
+	0x71505AEE4B8F981D, 0x0B912B992103F588, 0x5AA6AF25093FACE4, 0x0940EFADB4032AD3,
+	0x488558EA6DCC8A50, 0x07672624900288A9, 0x74088E43E2E0DD4C, 0x723EA36DB337410E,
+	0x5CD3A5031BE71770, 0x5B654F8AF5C5CDA5, 0x4A42EA68E31F45F3, 0x62B772D5916B0AEB,
+	0x76D1770E38320986, 0x0458B7BC1BDE77DD, 0x5F0DF8D82CF4D46B, 0x1D13C630164B9318,
+	0x4C0B2D79BD90A9EF, 0x30DC9E8CDEA2DC13, 0x79AB7BF5FC1AA97F, 0x0160FDAE31049351,
+	0x6155FCC4C9AEEDFF, 0x1AB3FE24F403A90E, 0x4DDE63D0A158BE65, 0x6229981D9002EDA5,
+	0x7C97061A9BC130A2, 0x69DC2695B337E2A1, 0x63AC04E2163426E8, 0x54B01EDE28F9821B,
+	0x4FBCD0B4DE901F20, 0x43C018B1BA6134E2, 0x7F9481216419CB67, 0x1F99C11C5D68549D,
+	0x6610674DE9AE3C52, 0x4C7B00E37DED107E, 0x51A6B90B21583042, 0x09FC00B5FE574065,
+	0x41522DA2811359CE, 0x3B3000919845CD1D, 0x68837C3734EBC2E3, 0x784CCDB5C06FAE95,
+	0x539C635F5D8968B6, 0x2D0A3E2B00595877, 0x42E382B2B13ABA2B, 0x3DA1CB5599E11393,
+	0x6B059DEAB52AC378, 0x629C7888F634EC1E, 0x559E17EEF755692D, 0x3549FA072B5D89B1,
+	0x447E798BF91120F1, 0x1107FB38EF7E07C1, 0x6D9728DFF4E834B5, 0x01A65EC17F300C68,
+	0x57AC20B32A535D5D, 0x4E1EB23465C009ED, 0x46234D5C21DC4AB1, 0x24E55B5D1E333B24,
+	0x70387BC69C93AAB5, 0x216EF894FD1EC506, 0x59C6C96BB076222A, 0x4DF2607730E56A6C,
+	0x47D23ABC8D2B4E88, 0x3E5B805F5A5121F0, 0x72E9F79415121740, 0x63C59A322A1B697F,
+	0x5BEE5FA9AA74DF67, 0x03047B5B54E2BACC, 0x498B7FBAEEC3E5EC, 0x0269FC4910B5623D,
+	0x75ABFF917E063CAC, 0x6A432D41B45569FB, 0x5E2332DACB38308A, 0x21CF5767C37787FC,
+	0x4B4F5BE23C2CF3A1, 0x67D912B9692C6CCA, 0x787EF969F9E185CF, 0x595B5128A8471476,
+	0x60659454C7E79E3F, 0x6115DA86ED05A9F8, 0x4D1E1043D31FB1CC, 0x4DAB1538BD9E2193,
+	0x7B634D3951CC4FAD, 0x62AB552795C9CF52, 0x62B5D7610E3D0C8B, 0x0222AA86116E3F75,
+	0x4EF7DF80D830D6D5, 0x4E822204DABE992A, 0x7E59659AF38157BC, 0x17369CD49130F510,
+	0x65145148C2CDDFC9, 0x5F5EE3DD40F3F740, 0x50DD0DD3CF0B196E, 0x1918B64A9A5CC5CD,
+	0x40B0D7DCA5A27ABE, 0x4746F83BAEB09E3E, 0x678159610903F797, 0x253E59F91780FD2F,
+	0x52CDE11A6D9CC612, 0x50FEAE60DF9A6426, 0x423E4DAEBE1704DB, 0x5A65584D7FAEB685,
+	0x69FD4917968B3AF9, 0x10A226E265E4573B, 0x54CAA0DFABA29594, 0x0D4E8581EB1D1295,
+	0x43D54D7FBC821143, 0x243ED134BC174211, 0x6C887BFF94034ED2, 0x06CAE85460253682,
+	0x56D396661002A574, 0x6BD586A9E6842B9B, 0x457611EB40021DF7, 0x09779EEE52035616,
+	0x6F234FDECCD02FF1, 0x5BF297E3B66BBCEF, 0x58E90CB23D73598E, 0x165BACB62B8963F3,
+	0x4720D6F4FDF5E13E, 0x451623C4EFA11CC2, 0x71CE24BB2FEFCECA, 0x3B569FA17F682E03,
+	0x5B0B5095BFF30BD5, 0x15DEE61ACC535803, 0x48D5DA11665C0977, 0x2B18B8157042ACCF,
+	0x74895CE8A3C6758B, 0x5E8DF355806AAE18, 0x5D3AB0BA1C9EC46F, 0x653E5C4466BBBE7A,
+	0x4A955A2E7D4BD059, 0x3765169D1EFC9861, 0x77555D172EDFB3C2, 0x256E8A94FE60F3CF,
+	0x5F777DAC257FC301, 0x6ABED543FEB3F63F, 0x4C5F97BCEACC9C01, 0x3BCBDDCFFEF65E99,
+	0x7A328C6177ADC668, 0x5FAC961997F0975B, 0x61C209E792F16B86, 0x7FBD44E1465A12AF,
+	0x4E34D4B9425ABC6B, 0x7FCA9D810514DBBF, 0x7D21545B9D5DFA46, 0x32DDC8CE6E87C5FF,
+	0x641AA9E2E44B2E9E, 0x5BE4A0A525396B32, 0x501554B5836F587E, 0x7CB6E6EA842DEF5C,
+	0x4011109135F2AD32, 0x30925255368B25E3, 0x6681B41B89844850, 0x4DB6EA21F0DEA304,
+	0x52015CE2D469D373, 0x57C5881B2718826A, 0x419AB0B576BB0F8F, 0x5FD139AF527A01EF,
+	0x68F781225791B27F, 0x4C81F5E550C3364A, 0x53F9341B79415B99, 0x239B2B1DDA35C508,
+	0x432DC3492DCDE2E1, 0x02E288E4AE916A6D, 0x6B7C6BA849496B01, 0x516A74A1174F10AE,
+	0x55FD22ED076DEF34, 0x4121F6E745D8DA25, 0x44CA82573924BF5D, 0x1A8192529E4714EB,
+	0x6E10D08B8EA1322E, 0x5D9C1D50FD3E87DD, 0x580D73A2D880F4F2, 0x17B01773FDCB9FE4,
+	0x4671294F139A5D8E, 0x4626792997D61984, 0x70B50EE4EC2A2F4A, 0x3D0A5B75BFBCF59F,
+	0x5A2A7250BCEE8C3B, 0x4A6EAF916630C47F, 0x4821F50D63F209C9, 0x21F2260DEB5A36CC,
+	0x736988156CB6760E, 0x69837016455D247A, 0x5C546CDDF091F80B, 0x6E02C011D1175062,
+	0x49DD23E4C074C66F, 0x719BCCDB0DAC404E, 0x762E9FD467213D7F, 0x68F947C4E2AD33B0,
+	0x5E8BB3105280FDFF, 0x6D94396A4EF0F627, 0x4BA2F5A6A8673199, 0x3E102DEEA58D91B9,
+	0x7904BC3DDA3EB5C2, 0x3019E3176F48E927, 0x60D09697E1CBC49B, 0x4014B5AC590720EC,
+	0x4D73ABACB4A303AF, 0x4CDD5E237A6C1A57, 0x7BEC45E12104D2B2, 0x47C8969F2A46908A,
+	0x63236B1A80D0A88E, 0x6CA0787F5505406F, 0x4F4F88E200A6ED3F, 0x0A19F9FF773766BF,
+	0x7EE5A7D0010B1531, 0x5CF65CCBF1F23DFE, 0x6584864000D5AA8E, 0x172B7D6FF4C1CB32,
+	0x5136D1CCCD77BBA4, 0x78EF978CC3CE3C28, 0x40F8A7D70AC62FB7, 0x13F2DFA3CFD83020,
+	0x67F43FBE77A37F8B, 0x398499061959E699, 0x5329CC985FB5FFA2, 0x6136E0D1ADE18548,
+	0x4287D6E04C91994F, 0x00F8B3DAF181376D, 0x6A72F166E0E8F54B, 0x1B27862B1C01F247,
+	0x5528C11F1A53F76F, 0x2F52D1BC1667F506, 0x44209A7F48432C59, 0x0C424163451FF738,
+	0x6D00F7320D3846F4, 0x7A039BD208332526, 0x5733F8F4D76038C3, 0x7B361641A028EA85,
+	0x45C32D90AC4CFA36, 0x2F5E78348020BB9E, 0x6F9EAF4DE07B29F0, 0x4BCA59ED99CDF8FC,
+	0x594BBF71806287F3, 0x563B7B247B0B2D96, 0x476FCC5ACD1B9FF6, 0x11C92F50626F57AC,
+	0x724C7A2AE1C5CCBD, 0x02DB7EE703E55912, 0x5B7061BBE7D17097, 0x1BE2CBEC031DE0DC,
+	0x4926B496530DF3AC, 0x164F09899C17E716, 0x750ABA8A1E7CB913, 0x3D4B4275C68CA4F0,
+	0x5DA22ED4E530940F, 0x4AA29B916BA3B726, 0x4AE825771DC07672, 0x6EE87C74561C9285,
+	0x77D9D58B62CD8A51, 0x3173FA53BCFA8408, 0x5FE177A2B5713B74, 0x278FFB7630C869A0,
+	0x4CB45FB55DF42F90, 0x1FA662C4F3D387B3, 0x7ABA32BBC986B280, 0x32A3D13B1FB8D91F,
+	0x622E8EFCA1388ECD, 0x0EE9742F4C93E0E6, 0x4E8BA596E760723D, 0x58BAC3590A0FE71E,
+	0x7DAC3C24A5671D2F, 0x412AD228101971C9, 0x6489C9B6EAB8E426, 0x00EF0E8673478E3B,
+	0x506E3AF8BBC71CEB, 0x1A58D86B8F6C71C9, 0x40582F2D6305B0BC, 0x1513E0560C56C16E,
+	0x66F37EAF04D5E793, 0x3B530089AD579BE2, 0x525C6558D0AB1FA9, 0x15DC006E2446164F,
+	0x41E384470D55B2ED, 0x5E4999F1B69E783F, 0x696C06D81555EB15, 0x7D428FE92430C065,
+	0x54566BE0111188DE, 0x31020CBA835A3384, 0x4378564CDA746D7E, 0x5A680A2ECF7B5C69,
+	0x6BF3BD47C3ED7BFD, 0x770CDD17B25EFA42, 0x565C976C9CBDFCCB, 0x1270B0DFC1E59502,
+	0x4516DF8A16FE63D5, 0x5B8D5A4C9B1E10CE, 0x6E8AFF4357FD6C89, 0x127BC3ADC4FCE7B0,
+	0x586F329C466456D4, 0x0EC96957D0CA52F3, 0x46BF5BB038504576, 0x3F07877973D50F29,
+	0x71322C4D26E6D58A, 0x31A5A58F1FBB4B75, 0x5A8E89D75252446E, 0x5AEAEAD8E62F6F91,
+	0x487207DF750E9D25, 0x2F22557A51BF8C74, 0x73E9A63254E42EA2, 0x1836EF2A1C65AD86,
+	0x5CBAEB5B771CF21B, 0x2CF8BF54E3848AD2, 0x4A2F22AF927D8E7C, 0x23FA32AA4F9D3BDB,
+	0x76B1D118EA627D93, 0x5329EAAA18FB92F8, 0x5EF4A74721E86476, 0x0F54BBBB472FA8C6,
+	0x4BF6EC38E7ED1D2B, 0x25DD62FC38F2ED6C, 0x798B138E3FE1C845, 0x22FBD1938E517BDF,
+	0x613C0FA4FFE7D36A, 0x4F2FDADC71DAC97F, 0x4DC9A61D998642BB, 0x58F3157D27E23ACC,
+	0x7C75D695C2706AC5, 0x74B82261D969F7AD, 0x63917877CEC0556B, 0x10934EB4ADEE5FBE,
+	0x4FA793930BCD1122, 0x4075D8908B251965, 0x7F7285B812E1B504, 0x00BC8DB411D4F56E,
+	0x65F537C675815D9C, 0x66FD3E29A7DD9125, 0x5190F96B91344AE3, 0x6BFDCB54864ADA84,
+	0x4140C78940F6A24F, 0x6FFE3C439EA2486A, 0x6867A5A867F103B2, 0x7FFD2D38FDD073DC,
+	0x53861E2053273628, 0x6664242D97D9F64A, 0x42D1B1B375B8F820, 0x51E9B68ADFE191D5,
+	0x6AE91C5255F4C034, 0x1CA924116635B621, 0x558749DB77F70029, 0x63BA83411E915E81,
+	0x446C3B15F9926687, 0x6962029A7EDAB201, 0x6D79F82328EA3DA6, 0x0F03375D97C45001,
+	0x5794C6828721CAEB, 0x259C2C4ADFD04001, 0x46109ECED2816F22, 0x5149BD08B30D0001,
+	0x701A97B150CF1837, 0x3542C80DEB480001, 0x59AEDFC10D7279C5, 0x7768A00B22A00001,
+	0x47BF19673DF52E37, 0x79208008E8800001, 0x72CB5BD86321E38C, 0x5B67334174000001,
+	0x5BD5E313828182D6, 0x7C528F6790000001, 0x4977E8DC68679BDF, 0x16A872B940000001,
+	0x758CA7C70D7292FE, 0x5773EAC200000001, 0x5E0A1FD271287598, 0x45F6556800000001,
+	0x4B3B4CA85A86C47A, 0x04C5112000000001, 0x785EE10D5DA46D90, 0x07A1B50000000001,
+	0x604BE73DE4838AD9, 0x52E7C40000000001, 0x4D0985CB1D3608AE, 0x0F1FD00000000001,
+	0x7B426FAB61F00DE3, 0x31CC800000000001, 0x629B8C891B267182, 0x5B0A000000000001,
+	0x4EE2D6D415B85ACE, 0x7C08000000000001, 0x7E37BE2022C0914B, 0x1340000000000001,
+	0x64F964E68233A76F, 0x2900000000000001, 0x50C783EB9B5C85F2, 0x5400000000000001,
+	0x409F9CBC7C4A04C2, 0x1000000000000001, 0x6765C793FA10079D, 0x0000000000000001,
+	0x52B7D2DCC80CD2E4, 0x0000000000000001, 0x422CA8B0A00A4250, 0x0000000000000001,
+	0x69E10DE76676D080, 0x0000000000000001, 0x54B40B1F852BDA00, 0x0000000000000001,
+	0x43C33C1937564800, 0x0000000000000001, 0x6C6B935B8BBD4000, 0x0000000000000001,
+	0x56BC75E2D6310000, 0x0000000000000001, 0x4563918244F40000, 0x0000000000000001,
+	0x6F05B59D3B200000, 0x0000000000000001, 0x58D15E1762800000, 0x0000000000000001,
+	0x470DE4DF82000000, 0x0000000000000001, 0x71AFD498D0000000, 0x0000000000000001,
+	0x5AF3107A40000000, 0x0000000000000001, 0x48C2739500000000, 0x0000000000000001,
+	0x746A528800000000, 0x0000000000000001, 0x5D21DBA000000000, 0x0000000000000001,
+	0x4A817C8000000000, 0x0000000000000001, 0x7735940000000000, 0x0000000000000001,
+	0x5F5E100000000000, 0x0000000000000001, 0x4C4B400000000000, 0x0000000000000001,
+	0x7A12000000000000, 0x0000000000000001, 0x61A8000000000000, 0x0000000000000001,
+	0x4E20000000000000, 0x0000000000000001, 0x7D00000000000000, 0x0000000000000001,
+	0x6400000000000000, 0x0000000000000001, 0x5000000000000000, 0x0000000000000001,
+	0x4000000000000000, 0x0000000000000001, 0x6666666666666666, 0x3333333333333334,
+	0x51EB851EB851EB85, 0x0F5C28F5C28F5C29, 0x4189374BC6A7EF9D, 0x5916872B020C49BB,
+	0x68DB8BAC710CB295, 0x74F0D844D013A92B, 0x53E2D6238DA3C211, 0x43F3E0370CDC8755,
+	0x431BDE82D7B634DA, 0x698FE69270B06C44, 0x6B5FCA6AF2BD215E, 0x0F4CA41D811A46D4,
+	0x55E63B88C230E77E, 0x3F70834ACDAE9F10, 0x44B82FA09B5A52CB, 0x4C5A02A23E254C0D,
+	0x6DF37F675EF6EADF, 0x2D5CD10396A21347, 0x57F5FF85E592557F, 0x3DE3DA69454E75D3,
+	0x465E6604B7A84465, 0x7E4FE1EDD10B9175, 0x709709A125DA0709, 0x4A19697C81AC1BEF,
+	0x5A126E1A84AE6C07, 0x54E1213067BCE326, 0x480EBE7B9D58566C, 0x43E74DC052FD8285,
+	0x734ACA5F6226F0AD, 0x530BAF9A1E626A6D, 0x5C3BD5191B525A24, 0x426FBFAE7EB521F1,
+	0x49C97747490EAE83, 0x4EBFCC8B9890E7F4, 0x760F253EDB4AB0D2, 0x4ACC7A78F41B0CBA,
+	0x5E72843249088D75, 0x223D2EC729AF3D62, 0x4B8ED0283A6D3DF7, 0x34FDBF05BAF29781,
+	0x78E480405D7B9658, 0x54C931A2C4B758CF, 0x60B6CD004AC94513, 0x5D6DC14F03C5E0A5,
+	0x4D5F0A66A23A9DA9, 0x31249AA59C9E4D51, 0x7BCB43D769F762A8, 0x4EA0F76F60FD4882,
+	0x63090312BB2C4EED, 0x254D92BF80CAA068, 0x4F3A68DBC8F03F24, 0x1DD7A89933D54D20,
+	0x7EC3DAF941806506, 0x62F2A75B86221500, 0x65697BFA9ACD1D9F, 0x025BB91604E810CD,
+	0x51212FFBAF0A7E18, 0x684960DE6A5340A4, 0x40E7599625A1FE7A, 0x203AB3E521DC33B6,
+	0x67D88F56A29CCA5D, 0x19F7863B696052BD, 0x5313A5DEE87D6EB0, 0x7B2C6B62BAB37564,
+	0x42761E4BED31255A, 0x2F56BC4EFBC2C450, 0x6A5696DFE1E83BC3, 0x655793B192D13A1A,
+	0x5512124CB4B9C969, 0x377942F475742E7B, 0x440E750A2A2E3ABA, 0x5F9435905DF68B96,
+	0x6CE3EE76A9E3912A, 0x65B9EF4D63241289, 0x571CBEC554B60DBB, 0x6AFB25D782834207,
+	0x45B0989DDD5E7163, 0x08C8EB12CECF6806, 0x6F80F42FC8971BD1, 0x5ADB11B7B14BD9A3,
+	0x5933F68CA078E30E, 0x157C0E2C8DD647B5, 0x475CC53D4D2D8271, 0x5DFCD823A4AB6C91,
+	0x722E086215159D82, 0x632E269F6DDF141B, 0x5B5806B4DDAAE468, 0x4F581EE5F17F4349,
+	0x49133890B1558386, 0x72ACE584C1329C3B, 0x74EB8DB44EEF38D7, 0x6AAE3C079B842D2A,
+	0x5D893E29D8BF60AC, 0x5558300616035755, 0x4AD431BB13CC4D56, 0x7779C004DE6912AB,
+	0x77B9E92B52E07BBE, 0x258F99A163DB5111, 0x5FC7EDBC424D2FCB, 0x37A614811CAF740D,
+	0x4C9FF163683DBFD5, 0x7951AA00E3BF900B, 0x7A998238A6C932EF, 0x754F7667D2CC19AB,
+	0x6214682D523A8F26, 0x2AA5F8530F09AE22, 0x4E76B9BDDB620C1E, 0x55519375A5A1581B,
+	0x7D8AC2C95F034697, 0x3BB5B8BC3C3559C5, 0x646F023AB2690545, 0x7C9160969691149E,
+	0x5058CE955B87376B, 0x16DAB3ABABA743B2, 0x40470BAAAF9F5F88, 0x78AEF622EFB902F5,
+	0x66D812AAB29898DB, 0x0DE4BD04B2C19E54, 0x524675555BAD4715, 0x57EA30D08F014B76,
+	0x41D1F7777C8A9F44, 0x4654F3DA0C01092C, 0x694FF258C7443207, 0x23BB1FC346680EAC,
+	0x543FF513D29CF4D2, 0x4FC8E635D1ECD88A, 0x43665DA9754A5D75, 0x263A51C4A7F0AD3B,
+	0x6BD6FC425543C8BB, 0x56C3B607731AAEC4, 0x5645969B77696D62, 0x789C919F8F488BD0,
+	0x4504787C5F878AB5, 0x46E3A7B2D906D640, 0x6E6D8D93CC0C1122, 0x3E390C515B3E239A,
+	0x5857A4763CD6741B, 0x4B60D6A77C31B615, 0x46AC8391CA4529AF, 0x55E7121F968E2B44,
+	0x711405B6106EA919, 0x0971B698F0E3786D, 0x5A766AF80D255414, 0x078E2BAD8D82C6BD,
+	0x485EBBF9A41DDCDC, 0x6C71BC8AD79BD231, 0x73CAC65C39C96161, 0x2D82C7448C2C8382,
+	0x5CA23849C7D44DE7, 0x3E023903A356CF9B, 0x4A1B603B06437185, 0x7E682D9C82ABD949,
+	0x76923391A39F1C09, 0x4A4048FA6AAC8EDB, 0x5EDB5C7482E5B007, 0x55003A61EEF07249,
+	0x4BE2B05D35848CD2, 0x773361E7F259F507, 0x796AB3C855A0E151, 0x3EB89CA6508FEE71,
+	0x6122296D114D810D, 0x7EFA16EB73A6585B, 0x4DB4EDF0DAA4673E, 0x3261ABEF8FB846AF,
+	0x7C54AFE7C43A3ECA, 0x1D691318E5F3A44B, 0x6376F31FD02E98A1, 0x64540F471E5C836F,
+	0x4F925C1973587A1B, 0x0376729F4B7D35F3, 0x7F50935BEBC0C35E, 0x38BD84321261EFEB,
+	0x65DA0F7CBC9A35E5, 0x13CAD0280EB4BFEF, 0x517B3F96FD482B1D, 0x5CA240200BC3CCBF,
+	0x412F66126439BC17, 0x63B50019A3030A33, 0x684BD683D38F9359, 0x1F88002904D1A9EA,
+	0x536FDECFDC72DC47, 0x32D3335403DAEE55, 0x42BFE57316C249D2, 0x5BDC291003158B77,
+	0x6ACCA251BE03A951, 0x12F9DB4CD1BC1258, 0x557081DAFE695440, 0x7594AF70A7C9A847,
+	0x445A017BFEBAA9CD, 0x4476F2C0863AED06, 0x6D5CCF2CCAC442E2, 0x3A57EACDA3917B3C,
+	0x577D728A3BD03581, 0x7B7988A482DAC8FD, 0x45FDF53B630CF79B, 0x15FAD3B6CF156D97,
+	0x6FFCBB923814BF5E, 0x565E1F8AE4EF15BE, 0x5996FC74F9AA32B2, 0x11E4E608B725AAFF,
+	0x47ABFD2A6154F55B, 0x27EA51A0928488CC, 0x72ACC843CEEE555E, 0x7310829A84074146,
+	0x5BBD6D030BF1DDE5, 0x42739BAED005CDD2, 0x49645735A327E4B7, 0x4EC2E2F24004A4A8,
+	0x756D5855D1D96DF2, 0x4AD16B1D333AA10C, 0x5DF11377DB1457F5, 0x2241227DC2954DA3,
+	0x4B2742C648DD132A, 0x4E9A81FE35443E1C, 0x783ED13D4161B844, 0x175D9CC9EED39694,
+	0x603240FDCDE7C69C, 0x7917B0A18BDC7876, 0x4CF500CB0B1FD217, 0x1412F3B46FE39392,
+	0x7B219ADE7832E9BE, 0x535185ED7FD285B6, 0x628148B1F9C25498, 0x42A79E57997537C5,
+	0x4ECDD3C1949B76E0, 0x3552E512E12A9304, 0x7E161F9C20F8BE33, 0x6EEB081E3510EB39,
+	0x64DE7FB01A609829, 0x3F226CE4F740BC2E, 0x50B1FFC0151A1354, 0x3281F0B72C33C9BE,
+	0x408E66334414DC43, 0x42018D5F568FD498, 0x674A3D1ED354939F, 0x1CCF48988A7FBA8D,
+	0x52A1CA7F0F76DC7F, 0x30A5D3AD3B99620B, 0x421B0865A5F8B065, 0x73B7DC8A96144E6F,
+	0x69C4DA3C3CC11A3C, 0x52BFC7442353B0B1, 0x549D7B6363CDAE96, 0x756639034F7626F4,
+	0x43B12F82B63E2545, 0x4451C735D92B525D, 0x6C4EB26ABD303BA2, 0x3A1C71EFC1DEEA2E,
+	0x56A55B889759C94E, 0x61B05B2634B254F2, 0x45511606DF7B0772, 0x1AF37C1E908EAA5B,
+	0x6EE8233E325E7250, 0x2B1F2CFDB41776F8, 0x58B9B5CB5B7EC1D9, 0x6F4C23FE29AC5F2D,
+	0x46FAF7D5E2CBCE47, 0x72A34FFE87BD18F1, 0x71918C896ADFB073, 0x04387FFDA5FB5B1B,
+	0x5ADAD6D4557FC05C, 0x0360666484C915AF, 0x48AF1243779966B0, 0x02B3851D3707448C,
+	0x744B506BF28F0AB3, 0x1DEC082EBE720746, 0x5D090D2328726EF5, 0x64BCD358985B3905,
+	0x4A6DA41C205B8BF7, 0x6A30A913AD15C738, 0x7715D36033C5ACBF, 0x5D1AA81F7B560B8C,
+	0x5F44A919C3048A32, 0x7DAEECE5FC44D609, 0x4C36EDAE359D3B5B, 0x7E258A51969D7808,
+	0x79F17C49EF61F893, 0x16A276E8F0FBF33F, 0x618DFD07F2B4C6DC, 0x121B9253F3FCC299,
+	0x4E0B30D328909F16, 0x41AFA84329970214, 0x7CDEB4850DB431BD, 0x4F7F739EA8F19CED,
+	0x63E55D373E29C164, 0x3F99294BBA5AE3F1, 0x4FEAB0F8FE87CDE9, 0x7FADBAA2FB7BE98D,
+	0x7FDDE7F4CA72E30F, 0x7F7C5DD1925FDC15, 0x664B1FF7085BE8D9, 0x4C637E4141E649AB,
+	0x51D5B32C06AFED7A, 0x704F983434B83AEF, 0x4177C2899EF32462, 0x26A6135CF6F9C8BF,
+	0x68BF9DA8FE51D3D0, 0x3DD685618B294132, 0x53CC7E20CB74A973, 0x4B12044E08EDCDC2,
+	0x4309FE80A2C3BAC2, 0x6F419D0B3A57D7CE, 0x6B4330CDD1392AD1, 0x320294DEC3BFBFB0,
+	0x55CF5A3E40FA88A7, 0x419BAA4BCFCC995A, 0x44A5E1CB672ED3B9, 0x1AE2EEA30CA3ADE1,
+	0x6DD636123EB152C1, 0x77D17DD1ADD2AFCF, 0x57DE91A832277567, 0x797464A7BE42263F,
+	0x464BA7B9C1B92AB9, 0x4790508631CE84FF, 0x70790C5C6928445C, 0x0C1A1A704FB0D4CC,
+	0x59FA7049EDB9D049, 0x567B4859D95A43D6, 0x47FB8D07F161736E, 0x11FC39E17AAE9CAB,
+	0x732C14D98235857D, 0x032D2968C44A9445, 0x5C2343E134F79DFD, 0x4F575453D03BA9D1,
+	0x49B5CFE75D92E4CA, 0x72AC4376402FBB0E, 0x75EFB30BC8EB07AB, 0x0446D256CD192B49,
+	0x5E595C096D88D2EF, 0x1D0575123DADBC3A, 0x4B7AB0078AD3DBF2, 0x4A6AC40E97BE302F,
+	0x78C44CD8DE1FC650, 0x771139B0F2C9E6B1, 0x609D0A4718196B73, 0x78DA948D8F07EBC1,
+	0x4D4A6E9F467ABC5C, 0x60AEDD3E0C065634, 0x7BAA4A9870C46094, 0x344AFB9679A3BD20,
+	0x62EEA2138D69E6DD, 0x103BFC78614FCA80, 0x4F254E760ABB1F17, 0x26966393810CA200,
+	0x7EA21723445E9825, 0x2423D2859B476999, 0x654E78E9037EE01D, 0x69B642047C392148,
+	0x510B93ED9C658017, 0x6E2B680396941AA0, 0x40D60FF149EACCDF, 0x71BC53361210154D,
+	0x67BCE64EDCAAE166, 0x1C6085235019BBAE, 0x52FD850BE3BBE784, 0x7D1A041C40149625,
+	0x42646A6FE9631F9D, 0x4A7B367D0010781D, 0x6A3A43E642383295, 0x5D91F0C8001A59C8,
+	0x54FB698501C68EDE, 0x17A7F3D3334847D4, 0x43FC546A67D20BE4, 0x79532975C2A03976,
+	0x6CC6ED770C83463B, 0x0EEB75893766C256, 0x57058AC5A39C382F, 0x25892AD42C523512,
+	0x459E089E1C7CF9BF, 0x37A0EF102374F742, 0x6F6340FCFA618F98, 0x59017E8038BB2536,
+	0x591C33FD951AD946, 0x7A67986693C8EA91, 0x4749C33144157A9F, 0x151FAD1EDCA0BBA8,
+	0x720F9EB539BBF765, 0x0832AE97C76792A5, 0x5B3FB22A94965F84, 0x068EF21305EC7551,
+	0x48FFC1BBAA11E603, 0x1ED8C1A8D189F774, 0x74CC692C434FD66B, 0x4AF4690E1C0FF253,
+	0x5D705423690CAB89, 0x225D20D816732843, 0x4AC0434F873D5607, 0x35174D79AB8F5369,
+	0x779A054C0B955672, 0x21BEE25C45B21F0E, 0x5FAE6AA33C77785B, 0x3498B5169E2818D8,
+	0x4C8B888296C5F9E2, 0x5D46F7454B534713, 0x7A78DA6A8AD65C9D, 0x7BA4BED545520B52,
+	0x61FA48553BDEB07E, 0x2FB6FF110441A2A8, 0x4E61D37763188D31, 0x72F8CC0D9D014EED,
+	0x7D6952589E8DAEB6, 0x1E5AE015C80217E1, 0x645441E07ED7BEF8, 0x1848B344A001ACB4,
+	0x504367E6CBDFCBF9, 0x603A2903B3348A2A, 0x4035ECB8A3196FFB, 0x002E873628F6D4EE,
+	0x66BCADF43828B32B, 0x19E40B89DB2487E3, 0x52308B29C686F5BC, 0x14B66FA17C1D3983,
+	0x41C06F549ED25E30, 0x1091F2E7967DC79C, 0x6933E554315096B3, 0x341CB7D8F0C93F5F,
+	0x542984435AA6DEF5, 0x767D5FE0C0A0FF80, 0x435469CF7BB8B25E, 0x2B977FE70080CC66,
+	0x6BBA42E592C11D63, 0x5F58CCA4CD9AE0A3, 0x562E9BEADBCDB11C, 0x4C470A1D7148B3B6,
+	0x44F216557CA48DB0, 0x3D05A1B1276D5C92, 0x6E5023BBFAA0E2B3, 0x7B3C35E83F1560E9,
+	0x58401C96621A4EF6, 0x2F635E5365AAB3ED, 0x4699B0784E7B725E, 0x591C4B75EAEEF658,
+	0x70F5E726E3F8B6FD, 0x74FA125644B18A26, 0x5A5E5285832D5F31, 0x43FB41DE9D5AD4EB,
+	0x484B75379C244C27, 0x4FFC34B2177BDD89, 0x73ABEEBF603A1372, 0x4CC6BAB68BF96274,
+	0x5C898BCC4CFB42C2, 0x0A38955ED6611B90, 0x4A07A309D72F689B, 0x21C6DDE5784DAFA7,
+	0x76729E762518A75E, 0x693E2FD58D49190B, 0x5EC2185E8413B918, 0x5431BFDE0AA0E0D5,
+	0x4BCE79E536762DAD, 0x29C1664B3BB3E711, 0x794A5CA1F0BD15E2, 0x0F9BD6DEC5ECA4E8,
+	0x61084A1B26FDAB1B, 0x2616457F04BD50BA, 0x4DA03B48EBFE227C, 0x1E783798D09773C8,
+	0x7C33920E46636A60, 0x30C058F480F252D9, 0x635C74D8384F884D, 0x0D66AD9067284247,
+	0x4F7D2A469372D370, 0x711EF14052869B6C, 0x7F2EAA0A85848581, 0x34FE4ECD50D75F14,
+	0x65BEEE6ED136D134, 0x2A650BD773DF7F43, 0x51658B8BDA9240F6, 0x551DA312C319329C,
+	0x411E093CAEDB672B, 0x5DB14F4235ADC217, 0x68300EC77E2BD845, 0x7C4EE536BC49368A,
+	0x5359A56C64EFE037, 0x7D0BEA92303A9208, 0x42AE1DF050BFE693, 0x173CBBA8269541A0,
+	0x6AB02FE6E79970EB, 0x3EC792A6A422029A, 0x5559BFEBEC7AC0BC, 0x3239421EE9B4CEE1,
+	0x4447CCBCBD2F0096, 0x5B6101B25490A581, 0x6D3FADFAC84B3424, 0x2BCE691D541AA268,
+	0x576624C8A03C29B6, 0x563EBA7DDCE21B87, 0x45EB50A08030215E, 0x78322ECB171B4939,
+	0x6FDEE76733803564, 0x59E9E47824F87527, 0x597F1F85C2CCF783, 0x6187E9F9B72D2A86,
+	0x4798E6049BD72C69, 0x346CBB2E2C242205, 0x728E3CD42C8B7A42, 0x20ADF849E039D007,
+	0x5BA4FD768A092E9B, 0x33BE603B19C7D99F, 0x4950CAC53B3A8BAF, 0x42FEB3627B0647B3,
+	0x754E113B91F745E5, 0x5197856A5E7072B8, 0x5DD80DC941929E51, 0x27AC6ABB7EC05BC6,
+	0x4B133E3A9ADBB1DA, 0x52F05562CBCD1638, 0x781EC9F75E2C4FC4, 0x1E4D556ADFAE89F3,
+	0x6018A192B1BD0C9C, 0x7EA444557FBED4C3, 0x4CE0814227CA707D, 0x4BB69D1132FF109C,
+	0x7B00CED03FAA4D95, 0x5F8A94E851981A93, 0x62670BD9CC883E11, 0x32D543ED0E134875,
+	0x4EB8D647D6D364DA, 0x5BDDCFF0D80F6D2B, 0x7DF48A0C8AEBD491, 0x12FC7FE7C018AEAB,
+	0x64C3A1A3A25643A7, 0x28C9FFEC99AD5889, 0x509C814FB511CFB9, 0x0707FFF07AF113A1,
+	0x407D343FC40E3FC7, 0x1F39998D2F2742E7, 0x672EB9FFA016CC71, 0x7EC28F484B7204A4,
+	0x528BC7FFB345705B, 0x189BA5D36F8E6A1D, 0x42096CCC8F6AC048, 0x7A161E42BFA521B1,
+	0x69A8AE1418AACD41, 0x435696D132A1CF81, 0x5486F1A9AD557101, 0x1C454574288172CE,
+	0x439F27BAF1112734, 0x169DD129BA0128A5, 0x6C31D92B1B4EA520, 0x242FB50F9001DAA1,
+	0x568E4755AF721DB3, 0x368C90D940017BB4, 0x453E9F77BF8E7E29, 0x120A0D7A999AC95D,
+	0x6ECA98BF98E3FD0E, 0x50101590F5C47561, 0x58A213CC7A4FFDA5, 0x26734473F7D05DE8,
+	0x46E80FD6C83FFE1D, 0x6B8F69F65FD9E4B9, 0x71734C8AD9FFFCFC, 0x45B24323CC8FD45C,
+	0x5AC2A3A247FFFD96, 0x6AF502830A0CA9E3, 0x489BB61B6CCCCADF, 0x08C402026E7087E9,
+	0x742C569247AE1164, 0x746CD003E3E73FDB, 0x5CF04541D2F1A783, 0x76BD73364FEC3315,
+	0x4A59D101758E1F9C, 0x5EFDF5C50CBCF5AB, 0x76F61B3588E365C7, 0x4B2FEFA1ADFB22AB,
+	0x5F2B48F7A0B5EB06, 0x08F3261AF195B555, 0x4C22A0C61A2B226B, 0x20C284E25ADE2AAB,
+	0x79D1013CF6AB6A45, 0x1AD0D49D5E304444, 0x617400FD9222BB6A, 0x48A7107DE4F369D0,
+	0x4DF6673141B562BB, 0x53B8D9FE50C2BB0D, 0x7CBD71E869223792, 0x52C15CCA1AD12B48,
+	0x63CAC186BA81C60E, 0x75677D6E7BDA8906, 0x4FD5679EFB9B04D8, 0x5DEC645863153A6C,
+	0x7FBBD8FE5F5E6E27, 0x497A3A2704EEC3DF
+};
+
+// floor(e * log10(2)), floor(e * log10(2) + log10(3/4)) and floor(e * log2(10)), exact for |e| <= 2^11
+static int lept_flog10_pow2(int e) { return static_cast<int>((e * 661971961083LL) >> 41); }
+static int lept_flog10_three_quarters_pow2(int e) { return static_cast<int>((e * 661971961083LL - 274743187321LL) >> 41); }
+static int lept_flog2_pow10(int e) { return static_cast<int>((e * 913124641741LL) >> 38); }
+
+// g * cp / 2^126, rounded to odd
+static uint64_t lept_schubfach_rop(const uint64_t* g, uint64_t cp)
+{
+	const uint64_t mask63 = (static_cast<uint64_t>(1) << 63) - 1;
+	uint64_t x1, y1;
+	lept_umul128(g[1], cp, &x1);
+	uint64_t y0 = lept_umul128(g[0], cp, &y1);
+	uint64_t z = (y0 >> 1) + x1;
+	return (y1 + (z >> 63)) | (((z & mask63) + mask63) >> 63);
+}
+
+// the decimal f * 10^e10 for c * 2^q
+static uint64_t lept_schubfach(int q, uint64_t c, int* e10)
+{
+	const uint64_t hidden = static_cast<uint64_t>(1) << 52;
+	uint64_t out = c & 1, cb = c << 2, cbr = cb + 2, cbl;
+	int k;
+	if (c != hidden || q == -1074)
+	{
+		cbl = cb - 2;
+		k = lept_flog10_pow2(q);
+	}
+	else  // the neighbour below is closer at a power of two
+	{
+		cbl = cb - 1;
+		k = lept_flog10_three_quarters_pow2(q);
+	}
+	int h = q + lept_flog2_pow10(-k) + 2;
+	const uint64_t* g = lept_schubfach_g + 2 * (k - LEPT_SCHUBFACH_K_MIN);
+	uint64_t vb = lept_schubfach_rop(g, cb << h);
+	uint64_t vbl = lept_schubfach_rop(g, cbl << h);
+	uint64_t vbr = lept_schubfach_rop(g, cbr << h);
+	uint64_t s = vb >> 2;
+	// one digit fewer, if only one of the two candidates is in range; the paper waits for s >= 100
+	// as Java wants two digits, which would write 4.9e-324 for 5e-324
+	if (s >= 10)
+	{
+		uint64_t sp10 = s / 10 * 10, tp10 = sp10 + 10;
+		bool upin = vbl + out <= sp10 << 2, wpin = (tp10 << 2) + out <= vbr;
+		if (upin != wpin)
+		{
+			*e10 = k;
+			return upin ? sp10 : tp10;
+		}
+	}
+	uint64_t t = s + 1;
+	bool uin = vbl + out <= s << 2, win = (t << 2) + out <= vbr;
+	*e10 = k;
+	if (uin != win)
+		return uin ? s : t;
+	int64_t cmp = static_cast<int64_t>(vb - ((s + t) << 1));
+	return cmp < 0 || (cmp == 0 && !(s & 1)) ? s : t;
+}
+
+// the shortest digits of a finite d > 0 without trailing zeros, so that d reads back from digits * 10^K
+static void lept_shortest(double d, char* buffer, int* len, int* K)
+{
+	const uint64_t hidden = static_cast<uint64_t>(1) << 52;
+	uint64_t bits, f;
+	memcpy(&bits, &d, sizeof(double));
+	int biased = static_cast<int>(bits >> 52) & 0x7FF;
+	uint64_t t = bits & (hidden - 1);
+	assert(biased != 0x7FF);
+	if (biased != 0)
+		f = lept_schubfach(biased - 1075, t | hidden, K);
+	else
+		f = lept_schubfach(-1074, t, K);
+	while (f % 10 == 0)
+	{
+		f /= 10;
+		++*K;
+	}
+	*len = static_cast<int>(lept_u64toa(f, buffer) - buffer);
+}
+
+// "%.17g" with the digits of lept_shortest: exponent notation below 1e-4 and from 1e17 on
+static char* lept_dtoa_shortest(double d, char* buffer)
+{
+	char digits[20];
+	int len, K;
+	// infinities and NaNs have no json, they keep what sprintf writes for them ("inf", "-nan", ...)
+	if (!isfinite(d))
+		return buffer + sprintf(buffer, "%.17g", d);
+	// integers written exactly, which for these is also the shortest
+	if (d > -9007199254740992.0 && d < 9007199254740992.0 && d == static_cast<double>(static_cast<int64_t>(d)))
+	{
+		if (d == 0 && signbit(d))
+			*buffer++ = '-';
+		return lept_i64toa(static_cast<int64_t>(d), buffer);
+	}
+	if (d < 0)
+	{
+		*buffer++ = '-';
+		d = -d;
+	}
+	lept_shortest(d, digits, &len, &K);
+	int exp10 = len + K - 1;  // of the first digit
+	if (exp10 < -4 || exp10 >= 17)
+	{
+		*buffer++ = digits[0];
+		if (len > 1)
+		{
+			*buffer++ = '.';
+			memcpy(buffer, digits + 1, len - 1);
+			buffer += len - 1;
+		}
+		*buffer++ = 'e';
+		*buffer++ = exp10 < 0 ? '-' : '+';
+		if (exp10 < 0)
+			exp10 = -exp10;
+		if (exp10 < 10)
+			*buffer++ = '0';
+		return lept_u64toa(static_cast<uint64_t>(exp10), buffer);
+	}
+	if (exp10 < 0)
+	{
+		*buffer++ = '0';
+		*buffer++ = '.';
+		memset(buffer, '0', -exp10 - 1);
+		buffer += -exp10 - 1;
+		memcpy(buffer, digits, len);
+		return buffer + len;
+	}
+	if (len <= exp10 + 1)
+	{
+		memcpy(buffer, digits, len);
+		memset(buffer + len, '0', exp10 + 1 - len);
+		return buffer + exp10 + 1;
+	}
+	memcpy(buffer, digits, exp10 + 1);
+	buffer[exp10 + 1] = '.';
+	memcpy(buffer + exp10 + 2, digits + exp10 + 1, len - exp10 - 1);
+	return buffer + len + 1;
+}
+
+// at most 24 characters, and a null character after them
+static char* lept_dtoa(double d, char* buffer)
+{
+	if (!lept_shortest_numbers)
+		return buffer + sprintf(buffer, "%.17g", d);
+	char* end = lept_dtoa_shortest(d, buffer);
+	*end = '\0';
+	return end;
+}
+
+static void lept_stringify_number(lept_context *c, const lept_value *v)
+{
+	char *buffer = static_cast<char*>(lept_context_push(c, 32));
+	switch (v->ntype)
+	{
+	case LEPT_NUMBER_INT64:  c->top -= 32 - (lept_i64toa(v->i, buffer) - buffer); break;
+	case LEPT_NUMBER_UINT64: c->top -= 32 - (lept_u64toa(v->u, buffer) - buffer); break;
+	default:                 c->top -= 32 - (lept_dtoa(v->n, buffer) - buffer); break;
+	}
+}
+
+// one push for all of them, each number and its comma take at most 25 characters
+static void lept_stringify_packed(lept_context *c, const double *data, size_t n)
+{
+	size_t reserved = n * 25 + 1;
+	char *begin = static_cast<char*>(lept_context_push(c, reserved)), *p = begin;
+	for (size_t i = 0; i < n; ++i)
+	{
+		if (i > 0)
+			*p++ = ',';
+		p = lept_dtoa(data[i], p);
+	}
+	c->top -= reserved - (p - begin);
+}
+
+static void lept_stringify_value(lept_context *c, const lept_value *v);
+
+// elements [begin, end) of an expanded array, or its members for an object, with commas between
+static void lept_stringify_items(lept_context *c, const lept_value *v, size_t begin, size_t end)
+{
+	const lept_value* e = v->type == LEPT_ARRAY ? lept_array_values(v) : NULL;
+	if (v->type == LEPT_ARRAY && (v->flags & LEPT_PACKED) && e == NULL)
+		lept_stringify_packed(c, v->packed + begin, end - begin);
+	else if (v->type == LEPT_ARRAY)
+		for (size_t i = begin; i != end; ++i)
+		{
+			if (i > begin)
+				PUTC(c, ',');
+			lept_stringify_value(c, &e[i]);
+		}
+	else
+		for (size_t i = begin; i != end; ++i)
+		{
+			if (i > begin)
+				PUTC(c, ',');
+			lept_stringify_string(c, v->m[i].k, v->m[i].klen);
+			PUTC(c, ':');
+			lept_stringify_value(c, &v->m[i].v);
+		}
+}
+
 static void lept_stringify_value(lept_context *c, const lept_value *v)
 {
-	char *buffer;
 	switch (v->type)
 	{
 	case LEPT_NULL:   PUTS(c, "null", 4); break;
 	case LEPT_FALSE:  PUTS(c, "false", 5); break;
 	case LEPT_TRUE:   PUTS(c, "true", 4); break;
-	case LEPT_STRING: lept_stringify_string(c, v->s, v->len); break;
-	case LEPT_NUMBER:
-		buffer = static_cast<char*>(lept_context_push(c, 32));
-		c->top -= 32 - sprintf(buffer, "%.17g", v->n); break;
+	case LEPT_STRING: lept_stringify_string(c, lept_get_string(v), lept_get_string_length(v)); break;
+	case LEPT_NUMBER: lept_stringify_number(c, v); break;
 	case LEPT_ARRAY:
+		EXPAND(v);
 		PUTC(c, '[');
-		for (size_t i = 0; i < v->size; ++i)
+		lept_stringify_items(c, v, 0, v->size);
+		PUTC(c, ']');
+		break;
+	case LEPT_OBJECT:
+		EXPAND(v);
+		PUTC(c, '{');
+		lept_stringify_items(c, v, 0, v->msize);
+		PUTC(c, '}');
+		break;
+	default:
+		assert(0 && "invalid type");
+	}
+}
+
+char* lept_stringify(const lept_value *v, size_t *length)
+{
+	lept_context c;
+	assert(v != NULL);
+	c.stack = (char*)LEPT_MALLOC(c.size = LEPT_PARSE_STRINGIFY_INIT_SIZE);
+	c.top = 0;
+	lept_stringify_value(&c, v);
+	// lengthһָ룬û
+	if (length)
+		*length = c.top;
+	PUTC(&c, '\0');
+	return c.stack;
+}
+
+/* parallel stringify: the tree is cut into ranges of elements or members, each written by a task
+   into a buffer of its own after the brackets, commas and keys that come before it; the buffers are
+   then copied one after another into the result */
+
+#ifndef LEPT_STRINGIFY_TASK
+#define LEPT_STRINGIFY_TASK 4096  // values in a subtree small enough to be written by one task
+#endif
+
+struct lept_segment
+{
+	lept_context out;         // the text before the range, then the range's own
+	const lept_value* v;      // an array or object, NULL when there is no range
+	size_t begin, end;        // the range, in its elements or members
+	size_t offset;            // where out goes in the result
+};
+
+struct lept_stringify_plan
+{
+	lept_context segments;    // lept_segments in output order; the last one is being written
+	size_t split;             // a container with this many items or more is cut evenly
+};
+
+static lept_context* lept_plan_text(lept_stringify_plan* p)
+{
+	return &(reinterpret_cast<lept_segment*>(p->segments.stack + p->segments.top) - 1)->out;
+}
+
+// items [begin, end) of v end the current segment, the text after them goes to a new one
+static void lept_plan_range(lept_stringify_plan* p, const lept_value* v, size_t begin, size_t end)
+{
+	lept_segment* s = reinterpret_cast<lept_segment*>(p->segments.stack + p->segments.top) - 1;
+	s->v = v;
+	s->begin = begin;
+	s->end = end;
+	s = static_cast<lept_segment*>(lept_context_push(&p->segments, sizeof(lept_segment)));
+	s->out.stack = NULL;
+	s->out.size = s->out.top = 0;
+	s->v = NULL;
+}
+
+// values in v, counting no further than limit
+static size_t lept_weigh(const lept_value* v, size_t limit)
+{
+	size_t w = 1;
+	if (v->flags & LEPT_LAZY)
+		w += (LEPT_SRC_END(v) - v->src) / 8;  // not built yet, guessed from its source
+	else if (v->type == LEPT_ARRAY && (v->flags & LEPT_PACKED))
+		w += v->size;
+	else if (v->type == LEPT_ARRAY)
+		for (size_t i = 0; i < v->size && w < limit; i++)
+			w += lept_weigh(&v->e[i], limit - w);
+	else if (v->type == LEPT_OBJECT)
+		for (size_t i = 0; i < v->msize && w < limit; i++)
+			w += lept_weigh(&v->m[i].v, limit - w);
+	return w < limit ? w : limit;
+}
+
+static void lept_plan_value(lept_stringify_plan* p, const lept_value* v);
+
+// A container with many items, or packed numbers, is cut into p->split even ranges. Otherwise the runs of small items
+// become ranges, and the large ones are planned the same way.
+static void lept_plan_items(lept_stringify_plan* p, const lept_value* v, size_t n)
+{
+	size_t run = 0, i;
+	if (n >= p->split || (v->flags & LEPT_PACKED))
+	{
+		size_t k = n < p->split ? n : p->split;
+		for (i = 0; i < k; i++)
 		{
 			if (i > 0)
-				PUTC(c, ',');
-			lept_stringify_value(c, &v->e[i]);
+				PUTC(lept_plan_text(p), ',');
+			lept_plan_range(p, v, n * i / k, n * (i + 1) / k);
 		}
-		PUTC(c, ']');
-		break;
-	case LEPT_OBJECT:
-		PUTC(c, '{');
-		for (size_t i = 0; i != v->msize; ++i)
+		return;
+	}
+	for (i = 0; i < n; i++)
+	{
+		const lept_value* item = v->type == LEPT_ARRAY ? &v->e[i] : &v->m[i].v;
+		if (lept_weigh(item, LEPT_STRINGIFY_TASK) < LEPT_STRINGIFY_TASK)
+			continue;
+		if (run < i)
 		{
-			if (i > 0)
-				PUTC(c, ',');
-			lept_stringify_string(c, v->m[i].k, v->m[i].klen);
-			PUTC(c, ':');
-			lept_stringify_value(c, &v->m[i].v);
+			if (run > 0)
+				PUTC(lept_plan_text(p), ',');
+			lept_plan_range(p, v, run, i);
 		}
-		PUTC(c, '}');
-		break;
-	default:
-		assert(0 && "invalid type");
+		if (i > 0)
+			PUTC(lept_plan_text(p), ',');
+		if (v->type == LEPT_OBJECT)
+		{
+			lept_stringify_string(lept_plan_text(p), v->m[i].k, v->m[i].klen);
+			PUTC(lept_plan_text(p), ':');
+		}
+		lept_plan_value(p, item);
+		run = i + 1;
+	}
+	if (run < n)
+	{
+		if (run > 0)
+			PUTC(lept_plan_text(p), ',');
+		lept_plan_range(p, v, run, n);
 	}
 }
 
-char* lept_stringify(const lept_value *v, size_t *length)
+// only called for values that are not small, so a scalar never gets here
+static void lept_plan_value(lept_stringify_plan* p, const lept_value* v)
 {
-	lept_context c;
+	EXPAND(v);
+	assert(v->type == LEPT_ARRAY || v->type == LEPT_OBJECT);
+	PUTC(lept_plan_text(p), v->type == LEPT_ARRAY ? '[' : '{');
+	lept_plan_items(p, v, v->type == LEPT_ARRAY ? v->size : v->msize);
+	PUTC(lept_plan_text(p), v->type == LEPT_ARRAY ? ']' : '}');
+}
+
+#define LEPT_IS_CONTAINER(v) ((v)->type == LEPT_ARRAY || (v)->type == LEPT_OBJECT)
+
+// builds every lazy value under the array or object v on the calling thread, so that the tasks
+// only read the tree; a process that never called lept_parse_lazy has none, and skips the walk
+static void lept_expand_all(const lept_value* v)
+{
+	const lept_value* e;
+	size_t i;
+	EXPAND(v);
+	if (v->type == LEPT_OBJECT)
+	{
+		for (i = 0; i < v->msize; i++)
+			if (LEPT_IS_CONTAINER(&v->m[i].v))
+				lept_expand_all(&v->m[i].v);
+	}
+	else if ((e = lept_array_values(v)) != NULL)
+	{
+		for (i = 0; i < v->size; i++)
+			if (LEPT_IS_CONTAINER(&e[i]))
+				lept_expand_all(&e[i]);
+	}
+}
+
+char* lept_stringify_parallel(const lept_value* v, size_t* length, unsigned threads)
+{
+	lept_stringify_plan p;
+	lept_segment* s;
+	size_t count, size = 0;
+	char* json;
 	assert(v != NULL);
-	c.stack = (char*)malloc(c.size = LEPT_PARSE_STRINGIFY_INIT_SIZE);
-	c.top = 0;
-	lept_stringify_value(&c, v);
-	// lengthһָ룬û
+	if (threads == 0)
+		threads = std::thread::hardware_concurrency();
+	if (threads <= 1 || lept_weigh(v, LEPT_STRINGIFY_TASK) < LEPT_STRINGIFY_TASK)
+		return lept_stringify(v, length);
+	if (lept_lazy_parsed.load(std::memory_order_relaxed))
+		lept_expand_all(v);
+	p.segments.stack = NULL;
+	p.segments.size = p.segments.top = 0;
+	p.split = static_cast<size_t>(threads) * LEPT_PARALLEL_CHUNKS;
+	s = static_cast<lept_segment*>(lept_context_push(&p.segments, sizeof(lept_segment)));
+	s->out.stack = NULL;
+	s->out.size = s->out.top = 0;
+	s->v = NULL;
+	lept_plan_value(&p, v);
+	s = reinterpret_cast<lept_segment*>(p.segments.stack);
+	count = p.segments.top / sizeof(lept_segment);
+	lept_run_tasks(count, threads, [s](size_t i) {
+		if (s[i].v != NULL)
+			lept_stringify_items(&s[i].out, s[i].v, s[i].begin, s[i].end);
+	});
+	for (size_t i = 0; i < count; i++)
+	{
+		s[i].offset = size;
+		size += s[i].out.top;
+	}
+	json = static_cast<char*>(LEPT_MALLOC(size + 1));
+	lept_run_tasks(count, threads, [s, json](size_t i) {
+		if (s[i].out.top)
+			memcpy(json + s[i].offset, s[i].out.stack, s[i].out.top);
+		LEPT_FREE(s[i].out.stack);
+	});
+	json[size] = '\0';
+	LEPT_FREE(p.segments.stack);
 	if (length)
-		*length = c.top;
-	PUTC(&c, '\0');
-	return c.stack;
+		*length = size;
+	return json;
 }
 
 void lept_copy(lept_value *dst, const lept_value *src)
 {
+	lept_document* home;
+	const lept_value* e;
 	assert(dst != NULL && src != NULL && dst != src);
 	// 漰ַҪ⴦
 	switch (src->type)
 	{
 	case LEPT_STRING:
-		lept_set_string(dst, src->s, src->len);
+		lept_set_string(dst, lept_get_string(src), lept_get_string_length(src));
 		break;
 	case LEPT_ARRAY:
+		if ((src->flags & LEPT_LAZY) && lept_home(dst) == NULL)
+		{
+			lept_free(dst);
+			memcpy(dst, src, sizeof(lept_value));  // same source, still unparsed
+			break;
+		}
+		EXPAND(src);  // for an arena, which only holds built values: lept_expand builds on the heap
+		e = lept_array_values(src);
+		if ((src->flags & LEPT_PACKED) && e == NULL)
+		{
+			lept_set_number_array(dst, src->packed, src->size);
+			break;
+		}
 		lept_set_array(dst, src->size);
 		for (size_t i = 0; i != src->size; ++i)
-			lept_copy(lept_pushback_array_element(dst), &(src->e[i]));
+			lept_copy(lept_pushback_array_element(dst), &e[i]);
 		break;
 	case LEPT_OBJECT:
+		if ((src->flags & LEPT_LAZY) && lept_home(dst) == NULL)
+		{
+			lept_free(dst);
+			memcpy(dst, src, sizeof(lept_value));
+			break;
+		}
+		EXPAND(src);
 		lept_set_object(dst, src->msize);
 		for (size_t i = 0; i != src->msize; ++i)
 			lept_copy(lept_set_object_value(dst, src->m[i].k, src->m[i].klen), &(src->m[i].v));
 		break;
 	default:
+		home = lept_home(dst);
 		lept_free(dst);
 		memcpy(dst, src, sizeof(lept_value));
+		dst->flags = home != NULL ? LEPT_ARENA : 0;  // a scalar stays where dst was
+		lept_set_doc(dst, home);
 		break;
 	}
 }
 void lept_move(lept_value *dst, lept_value *src)
 {
 	assert(dst != NULL && src != NULL && dst != src);
+	lept_document* home = lept_home(src);
+	if (lept_home(dst) != home)
+	{
+		// between the heap and a document, or two documents: the storage cannot change hands
+		lept_copy(dst, src);
+		lept_free(src);
+		return;
+	}
 	lept_free(dst);
 	memcpy(dst, src, sizeof(lept_value));
-	lept_init(src);
+	lept_init_home(src, home);
 }
 void lept_swap(lept_value *lhs, lept_value *rhs)
 {
 	assert(lhs != NULL && rhs != NULL);
-	if (lhs != rhs)
+	if (lhs != rhs && lept_home(lhs) != lept_home(rhs))
+	{
+		lept_value temp;
+		lept_init(&temp);
+		lept_move(&temp, lhs);
+		lept_move(lhs, rhs);
+		lept_move(rhs, &temp);
+	}
+	else if (lhs != rhs)
 	{
 		lept_value temp;
 		memcpy(&temp, lhs, sizeof(lept_value));
@@ -533,35 +5112,84 @@ void lept_swap(lept_value *lhs, lept_value *rhs)
 void lept_free(lept_value* v)
 {
 	assert(v != NULL);
+	lept_document* home = NULL;  // an arena value keeps its document, and releases nothing
 	size_t i;
 	switch (v->type)
 	{
 	case LEPT_STRING:
-		free(v->s);
+		if (v->flags & LEPT_ARENA)
+			home = LEPT_ARENA_OWNER(v->s);
+		else if (!(v->flags & (LEPT_BORROWED | LEPT_INLINE)))
+			LEPT_FREE(v->s);
 		break;
 	case LEPT_ARRAY:
-		for (i = 0; i < v->size; i++)
-			lept_free(&v->e[i]);
-		free(v->e);
+		if (v->flags & LEPT_ARENA)
+			home = LEPT_ITEMS_OWNER(v->e);
+		if (v->flags & (LEPT_LAZY | LEPT_ARENA))
+			break;
+		SETTLE(v);
+		if (!(v->flags & LEPT_PACKED))
+			for (i = 0; i < v->size; i++)
+				lept_free(&v->e[i]);
+		lept_free_items(v->e);
 		break;
 	case LEPT_OBJECT:
+		if (v->flags & LEPT_ARENA)
+			home = LEPT_ITEMS_OWNER(v->m);
+		if (v->flags & (LEPT_LAZY | LEPT_ARENA))
+			break;
 		for (i = 0; i < v->msize; i++)
 		{
-			free(v->m[i].k);
+			if (!(v->flags & LEPT_BORROWED_KEYS))
+				LEPT_FREE(v->m[i].k);
 			lept_free(&(v->m[i].v));
 		}
-		free(v->m);
+		lept_index_free(v);
+		lept_free_items(v->m);
 		break;
 	default:
 		break;
 	}
 	v->type = LEPT_NULL;
+	v->flags &= LEPT_ARENA;
+	if (home != NULL)
+		lept_set_doc(v, home);
 }
 
 lept_type lept_get_type(const lept_value* v)
 {
 	assert(v != NULL);
-	return v->type;
+	return static_cast<lept_type>(v->type);
+}
+// numbers are equal when their mathematical values are, whatever their representation
+static int lept_number_is_equal(const lept_value *lhs, const lept_value *rhs)
+{
+	if (lhs->ntype == LEPT_NUMBER_DOUBLE && rhs->ntype == LEPT_NUMBER_DOUBLE)
+		return lhs->n == rhs->n;
+	if (lhs->ntype != LEPT_NUMBER_DOUBLE && rhs->ntype != LEPT_NUMBER_DOUBLE)
+		return lhs->ntype == rhs->ntype && lhs->u == rhs->u;
+	if (lhs->ntype != LEPT_NUMBER_DOUBLE)
+	{
+		const lept_value* t = lhs;
+		lhs = rhs;
+		rhs = t;
+	}
+	// lhs is the double, rhs the integer; 2^63 and 2^64 are exact doubles
+	double d = lhs->n;
+	if (rhs->ntype == LEPT_NUMBER_INT64)
+		return d >= -9223372036854775808.0 && d < 9223372036854775808.0 && static_cast<int64_t>(d) == rhs->i
+			&& static_cast<double>(static_cast<int64_t>(d)) == d;
+	return d >= 9223372036854775808.0 && d < 18446744073709551616.0 && static_cast<uint64_t>(d) == rhs->u;
+}
+// element i of an array, a packed one's made up in temp if it has no view
+static const lept_value* lept_array_at(const lept_value* v, size_t i, lept_value* temp)
+{
+	const lept_value* e = lept_array_values(v);
+	if (e != NULL)
+		return &e[i];
+	lept_init(temp);
+	lept_set_number(temp, v->packed[i]);
+	return temp;
 }
 int lept_is_equal(const lept_value *lhs, const lept_value *rhs)
 {
@@ -571,19 +5199,25 @@ int lept_is_equal(const lept_value *lhs, const lept_value *rhs)
 	switch (lhs->type)
 	{
 	case LEPT_STRING:
-		return (lhs->len == rhs->len) && (memcmp(lhs->s, rhs->s, lhs->len) == 0);
+		return lept_get_string_length(lhs) == lept_get_string_length(rhs) &&
+			memcmp(lept_get_string(lhs), lept_get_string(rhs), lept_get_string_length(lhs)) == 0;
 	case LEPT_NUMBER:
-		return lhs->n == rhs->n;
+		return lept_number_is_equal(lhs, rhs);
 	case LEPT_ARRAY:
+		EXPAND(lhs);
+		EXPAND(rhs);
 		if (lhs->size != rhs->size)
 			return 0;
 		for (size_t i = 0; i != lhs->size; ++i)
 		{
-			if (!lept_is_equal(&(lhs->e[i]), &(rhs->e[i])))
+			lept_value l, r;
+			if (!lept_is_equal(lept_array_at(lhs, i, &l), lept_array_at(rhs, i, &r)))
 				return 0;
 		}
 		return 1;
 	case LEPT_OBJECT:
+		EXPAND(lhs);
+		EXPAND(rhs);
 		if (lhs->msize != rhs->msize)
 			return 0;
 		for (size_t i = 0; i != lhs->msize; ++i)
@@ -612,34 +5246,87 @@ void lept_set_boolean(lept_value* v, int b)
 double lept_get_number(const lept_value* v)
 {
 	assert(v != NULL && v->type == LEPT_NUMBER);
-	return v->n;
+	switch (v->ntype)
+	{
+	case LEPT_NUMBER_INT64:  return static_cast<double>(v->i);
+	case LEPT_NUMBER_UINT64: return static_cast<double>(v->u);
+	default:                 return v->n;
+	}
 }
 void lept_set_number(lept_value* v, double n)
 {
 	lept_free(v);
 	v->n = n;
 	v->type = LEPT_NUMBER;
+	v->ntype = LEPT_NUMBER_DOUBLE;
+}
+lept_number_type lept_get_number_type(const lept_value* v)
+{
+	assert(v != NULL && v->type == LEPT_NUMBER);
+	return static_cast<lept_number_type>(v->ntype);
+}
+int64_t lept_get_int64(const lept_value* v)
+{
+	assert(v != NULL && v->type == LEPT_NUMBER && v->ntype == LEPT_NUMBER_INT64);
+	return v->i;
+}
+void lept_set_int64(lept_value* v, int64_t i)
+{
+	lept_free(v);
+	v->i = i;
+	v->type = LEPT_NUMBER;
+	v->ntype = LEPT_NUMBER_INT64;
+}
+uint64_t lept_get_uint64(const lept_value* v)
+{
+	assert(v != NULL && v->type == LEPT_NUMBER);
+	assert(v->ntype == LEPT_NUMBER_UINT64 || (v->ntype == LEPT_NUMBER_INT64 && v->i >= 0));
+	return v->u;
+}
+void lept_set_uint64(lept_value* v, uint64_t u)
+{
+	lept_free(v);
+	v->u = u;
+	v->type = LEPT_NUMBER;
+	v->ntype = u > static_cast<uint64_t>(INT64_MAX) ? LEPT_NUMBER_UINT64 : LEPT_NUMBER_INT64;
 }
 
 const char* lept_get_string(const lept_value* v)
 {
 	assert(v != NULL && v->type == LEPT_STRING);
-	return v->s;
+	return v->flags & LEPT_INLINE ? v->sso : v->s;
 }
 size_t lept_get_string_length(const lept_value* v)
 {
 	assert(v != NULL && v->type == LEPT_STRING);
-	return v->len;
+	return v->flags & LEPT_INLINE ? v->ntype : v->len;
 }
-void lept_set_string(lept_value* v, const char* s, size_t len)
+// lept_set_string on an already freed v, never in place
+static void lept_set_string_buffer(lept_value* v, const char* s, size_t len)
 {
-	assert(v != NULL && (s != NULL || len == 0));
-	lept_free(v);
-	v->s = (char*)malloc(len + 1);
+	lept_document* home = lept_home(v);
+	assert(len <= LEPT_COUNT_MAX);
+	v->s = (char*)lept_alloc(home, len + 1);
 	memcpy(v->s, s, len);
 	v->s[len] = '\0';
 	v->len = len;
 	v->type = LEPT_STRING;
+	v->flags = home != NULL ? LEPT_ARENA : 0;
+}
+void lept_set_string(lept_value* v, const char* s, size_t len)
+{
+	assert(v != NULL && (s != NULL || len == 0));
+	lept_free(v);
+	if (len >= LEPT_INLINE_SIZE || (v->flags & LEPT_ARENA))
+	{
+		lept_set_string_buffer(v, s, len);
+		return;
+	}
+	memcpy(v->sso, s, len);
+	v->sso[len] = '\0';
+	v->ntype = static_cast<unsigned char>(len);
+	v->type = LEPT_STRING;
+	v->flags = LEPT_INLINE;
 }
 
 
@@ -647,67 +5334,174 @@ void lept_set_array(lept_value *v, size_t capacity)
 {
 	assert(v != NULL);
 	lept_free(v);
+	lept_document* home = lept_home(v);
+	v->type = LEPT_ARRAY;
+	v->flags = home != NULL ? LEPT_ARENA : 0;
+	v->size = 0;
+	// in a document even an empty array has a block, which names the document
+	v->e = capacity > 0 || home != NULL ? static_cast<lept_value*>(lept_alloc_items(home, capacity, capacity * sizeof(lept_value))) : NULL;
+	LEPT_SET_E_CAPACITY(v, capacity);
+}
+// lept_set_array for an array of doubles
+static void lept_set_packed(lept_value* v, size_t capacity)
+{
+	lept_free(v);
+	lept_document* home = lept_home(v);
 	v->type = LEPT_ARRAY;
-	v->e_capacity = capacity;
+	v->flags = home != NULL ? LEPT_ARENA | LEPT_PACKED : LEPT_PACKED;
 	v->size = 0;
-	v->e = capacity > 0 ? static_cast<lept_value*>(malloc(capacity * sizeof(lept_value))) : NULL;
+	v->packed = capacity > 0 || home != NULL ? static_cast<double*>(lept_alloc_items(home, capacity, LEPT_PACKED_BYTES(capacity))) : NULL;
+	LEPT_SET_E_CAPACITY(v, capacity);
+	lept_init_view_slot(v);
+}
+// the elements of a packed array become lept_values again, with the same capacity: its view if it has one
+static void lept_unpack(lept_value* v)
+{
+	lept_document* home = lept_home(v);
+	double* packed = v->packed;
+	size_t capacity = LEPT_E_CAPACITY(v);
+	lept_value* view = lept_packed_view(v);
+	if (view != NULL)
+		v->e = view;
+	else
+	{
+		v->e = capacity > 0 || home != NULL ? static_cast<lept_value*>(lept_alloc_items(home, capacity, capacity * sizeof(lept_value))) : NULL;
+		for (size_t i = 0; i < v->size; i++)
+		{
+			lept_init_home(&v->e[i], home);
+			lept_set_number(&v->e[i], packed[i]);
+		}
+	}
+	if (home == NULL)
+		lept_free_items(packed);
+	v->flags &= ~LEPT_PACKED;
+}
+int lept_get_number_array(lept_value* v, double** data, size_t* n)
+{
+	assert(v != NULL && v->type == LEPT_ARRAY && data != NULL && n != NULL);
+	EXPAND(v);
+	SETTLE(v);
+	if (!(v->flags & LEPT_PACKED))
+	{
+		lept_value* e = v->e;
+		size_t i;
+		for (i = 0; i < v->size && e[i].type == LEPT_NUMBER && e[i].ntype == LEPT_NUMBER_DOUBLE; i++)
+			;
+		if (i < v->size)
+			return 0;
+		// the numbers are copied as bytes over the elements they come from, the block is not resized:
+		// number i ends before element i + 1 begins, so each element is read before it is written over,
+		// and capacity elements have room for the numbers and the view slot
+		char* raw = reinterpret_cast<char*>(e);
+		for (i = 0; i < v->size; i++)
+		{
+			double d = e[i].n;
+			e[i].~lept_value();
+			memcpy(raw + i * sizeof(double), &d, sizeof(double));
+		}
+		v->packed = reinterpret_cast<double*>(raw);
+		v->flags |= LEPT_PACKED;
+		lept_init_view_slot(v);
+	}
+	*data = v->packed;
+	*n = v->size;
+	return 1;
+}
+void lept_set_number_array(lept_value* v, const double* data, size_t n)
+{
+	assert(v != NULL && (data != NULL || n == 0));
+	lept_set_packed(v, n);
+	if (n)
+		memcpy(v->packed, data, n * sizeof(double));
+	v->size = n;
 }
 size_t lept_get_array_size(const lept_value *v)
 {
 	assert(v != NULL && v->type == LEPT_ARRAY);
+	EXPAND(v);
 	return v->size;
 }
 size_t lept_get_array_capacity(const lept_value *v)
 {
 	assert(v != NULL && v->type == LEPT_ARRAY);
-	return v->e_capacity;
+	EXPAND(v);
+	return LEPT_E_CAPACITY(v);
 }
-void lept_reserve_array(lept_value *v, size_t capacity)
+// the elements, or packed numbers, of a settled array moved to a block of capacity
+static void lept_resize_array(lept_value* v, size_t capacity)
 {
-	assert(v != NULL && v->type == LEPT_ARRAY);
-	if (v->e_capacity < capacity)
+	if (v->flags & LEPT_PACKED)
+	{
+		v->packed = static_cast<double*>(lept_realloc_items(lept_home(v), v->packed, v->size * sizeof(double), capacity, LEPT_PACKED_BYTES(capacity)));
+		LEPT_SET_E_CAPACITY(v, capacity);
+		lept_init_view_slot(v);
+	}
+	else
 	{
-		v->e_capacity = capacity;
-		v->e = (lept_value*)realloc(v->e, capacity*sizeof(lept_value));
+		v->e = static_cast<lept_value*>(lept_realloc_items(lept_home(v), v->e, v->size * sizeof(lept_value), capacity, capacity * sizeof(lept_value)));
+		LEPT_SET_E_CAPACITY(v, capacity);
 	}
 }
+void lept_reserve_array(lept_value *v, size_t capacity)
+{
+	assert(v != NULL && v->type == LEPT_ARRAY);
+	EXPAND(v);
+	SETTLE(v);
+	if (LEPT_E_CAPACITY(v) < capacity)
+		lept_resize_array(v, capacity);
+}
 void lept_shrink_array(lept_value *v)
 {
 	assert(v != NULL && v->type == LEPT_ARRAY);
-	if (v->e_capacity > v->size)
-	{
-		v->e_capacity = v->size;
-		v->e = (lept_value*)realloc(v->e, v->e_capacity*sizeof(lept_value));
-	}
+	EXPAND(v);
+	SETTLE(v);
+	if (LEPT_E_CAPACITY(v) > v->size)
+		lept_resize_array(v, v->size);
 }
 void lept_clear_array(lept_value *v)
 {
 	assert(v != NULL && v->type == LEPT_ARRAY);
+	EXPAND(v);
 	lept_erase_array_element(v, 0, v->size);
 }
 lept_value* lept_get_array_element(const lept_value* v, size_t index)
 {
 	assert(v != NULL && v->type == LEPT_ARRAY);
+	EXPAND(v);
 	assert(index < v->size);
+	if (v->flags & LEPT_PACKED)
+	{
+		lept_value* view = lept_packed_view(v);
+		return &(view != NULL ? view : lept_make_view(v))[index];
+	}
 	return &(v->e[index]);
 }
 lept_value* lept_pushback_array_element(lept_value *v)
 {
 	assert(v != NULL && v->type == LEPT_ARRAY);
-	if (v->size == v->e_capacity)
+	EXPAND(v);
+	UNPACK(v);
+	if (v->size == LEPT_E_CAPACITY(v))
 		lept_reserve_array(v, v->size ? v->size * 2 : 1);
-	lept_init(&(v->e[v->size]));
+	lept_init_home(&(v->e[v->size]), lept_home(v));
 	return &(v->e[v->size++]);
 }
 void lept_popback_array_element(lept_value *v)
 {
-	assert(v != NULL && v->type == LEPT_ARRAY && v->size > 0);
-	lept_free(&(v->e[v->size - 1]));
+	assert(v != NULL && v->type == LEPT_ARRAY);
+	EXPAND(v);
+	SETTLE(v);
+	assert(v->size > 0);
+	if (!(v->flags & LEPT_PACKED))
+		lept_free(&(v->e[v->size - 1]));
 	--v->size;
 }
 lept_value* lept_insert_array_element(lept_value *v, size_t index)
 {
-	assert(v != NULL && v->type == LEPT_ARRAY && index <= v->size);
+	assert(v != NULL && v->type == LEPT_ARRAY);
+	EXPAND(v);
+	UNPACK(v);
+	assert(index <= v->size);
 	lept_pushback_array_element(v);
 	for (size_t i = v->size - 1; i != index; --i)
 		lept_move(&(v->e[i]), &(v->e[i - 1]));
@@ -715,8 +5509,16 @@ lept_value* lept_insert_array_element(lept_value *v, size_t index)
 }
 void lept_erase_array_element(lept_value *v, size_t index, size_t count)
 {
-	assert(v != NULL && v->type == LEPT_ARRAY && index + count <= v->size);
-	if (count != 0)
+	assert(v != NULL && v->type == LEPT_ARRAY);
+	EXPAND(v);
+	SETTLE(v);
+	assert(index + count <= v->size);
+	if (count != 0 && (v->flags & LEPT_PACKED))
+	{
+		memmove(v->packed + index, v->packed + index + count, (v->size - index - count) * sizeof(double));
+		v->size -= count;
+	}
+	else if (count != 0)
 	{
 		for (size_t i = 0; i != count; ++i)
 			lept_free(&(v->e[index + i]));
@@ -730,76 +5532,105 @@ void lept_set_object(lept_value *v, size_t capacity)
 {
 	assert(v != NULL);
 	lept_free(v);
+	lept_document* home = lept_home(v);
 	v->type = LEPT_OBJECT;
-	v->m_capacity = capacity;
+	v->flags = home != NULL ? LEPT_ARENA : 0;
 	v->msize = 0;
-	v->m = capacity > 0 ? static_cast<lept_member*>(malloc(capacity * sizeof(lept_member))) : NULL;
+	v->m = capacity > 0 || home != NULL ? static_cast<lept_member*>(lept_alloc_items(home, capacity, lept_members_size(capacity))) : NULL;
+	LEPT_SET_M_CAPACITY(v, capacity);
+	if (lept_index_slot(v) != NULL)
+		*lept_index_slot(v) = NULL;
 }
 size_t lept_get_object_size(const lept_value* v)
 {
 	assert(v != NULL && v->type == LEPT_OBJECT);
+	EXPAND(v);
 	return v->msize;
 }
 size_t lept_get_object_capacity(const lept_value *v)
 {
 	assert(v != NULL && v->type == LEPT_OBJECT);
-	return v->m_capacity;
+	EXPAND(v);
+	return LEPT_M_CAPACITY(v);
 }
 void lept_reserve_object(lept_value *v, size_t capacity)
 {
 	assert(v != NULL && v->type == LEPT_OBJECT);
-	if (v->m_capacity < capacity)
+	EXPAND(v);
+	if (LEPT_M_CAPACITY(v) < capacity)
 	{
-		v->m_capacity = capacity;
-		v->m = static_cast<lept_member*>(realloc(v->m, capacity * sizeof (lept_member)));
+		lept_object_index* x = lept_index_slot(v) != NULL ? *lept_index_slot(v) : NULL;
+		v->m = static_cast<lept_member*>(lept_realloc_items(lept_home(v), v->m, v->msize * sizeof (lept_member), capacity, lept_members_size(capacity)));
+		LEPT_SET_M_CAPACITY(v, capacity);
+		if (lept_index_slot(v) != NULL)
+			*lept_index_slot(v) = x;
 	}
 }
 void lept_shrink_object(lept_value *v)
 {
 	assert(v != NULL && v->type == LEPT_OBJECT);
-	if (v->m_capacity > v->msize)
+	EXPAND(v);
+	if (LEPT_M_CAPACITY(v) > v->msize)
 	{
-		v->m_capacity = v->msize;
-		v->m = static_cast<lept_member*>(realloc(v->m, v->m_capacity * sizeof (lept_member)));
+		lept_object_index* x = lept_index_slot(v) != NULL ? *lept_index_slot(v) : NULL;
+		if (v->msize < LEPT_OBJECT_INDEX_MIN)
+		{
+			lept_index_free(v);
+			x = NULL;
+		}
+		v->m = static_cast<lept_member*>(lept_realloc_items(lept_home(v), v->m, v->msize * sizeof (lept_member), v->msize, lept_members_size(v->msize)));
+		LEPT_SET_M_CAPACITY(v, v->msize);
+		if (lept_index_slot(v) != NULL)
+			*lept_index_slot(v) = x;
 	}
 }
 void lept_clear_object(lept_value *v)
 {
 	assert(v != NULL && v->type == LEPT_OBJECT);
+	EXPAND(v);
 	if (v->msize)
 	{
 		for (size_t i = 0; i != v->msize; ++i)
 		{
-			free(v->m[i].k);
+			if (!(v->flags & (LEPT_BORROWED_KEYS | LEPT_ARENA)))
+				LEPT_FREE(v->m[i].k);
 			lept_free(&(v->m[i].v));
 		}
 		v->msize = 0;
 	}
+	lept_index_free(v);
+	v->flags &= LEPT_ARENA;
 }
 const char* lept_get_object_key(const lept_value* v, size_t index)
 {
 	assert(v != NULL && v->type == LEPT_OBJECT);
+	EXPAND(v);
 	assert(index < v->msize);
 	return v->m[index].k;
 }
 size_t lept_get_object_key_length(const lept_value* v, size_t index)
 {
 	assert(v != NULL && v->type == LEPT_OBJECT);
+	EXPAND(v);
 	assert(index < v->msize);
 	return v->m[index].klen;
 }
 lept_value* lept_get_object_value(const lept_value* v, size_t index)
 {
 	assert(v != NULL && v->type == LEPT_OBJECT);
+	EXPAND(v);
 	assert(index < v->msize);
 	return &(v->m[index].v);
 }
 size_t lept_find_object_index(const lept_value *v, const char *key, size_t klen)
 {
 	assert(v != NULL && v->type == LEPT_OBJECT && key != NULL);
+	EXPAND(v);
+	if (v->msize >= LEPT_OBJECT_INDEX_MIN && *lept_index_slot(v) != NULL)
+		return lept_index_find(v, key, klen);
 	for (size_t i = 0; i != v->msize; ++i)
 	{
-		if (v->m[i].klen == klen && memcmp(v->m[i].k, key, klen) == 0)
+		if (v->m[i].klen == klen && (v->m[i].k == key || memcmp(v->m[i].k, key, klen) == 0))
 			return i;
 	}
 	return LEPT_KEY_NOT_EXIST;
@@ -812,27 +5643,339 @@ lept_value* lept_find_object_value(lept_value *v, const char *key, size_t klen)
 lept_value* lept_set_object_value(lept_value *v, const char *key, size_t klen)
 {
 	assert(v != NULL && v->type == LEPT_OBJECT && key != NULL);
+	EXPAND(v);
+	lept_index_build(v);
 
 	size_t index = lept_find_object_index(v, key, klen);
 	if (index != LEPT_KEY_NOT_EXIST)
 		return &(v->m[index].v);
 
-	if (v->msize == v->m_capacity)
+	// keys of one object are either all borrowed or all owned, so copy the borrowed ones first
+	if (v->flags & LEPT_BORROWED_KEYS)
+	{
+		for (size_t i = 0; i != v->msize; ++i)
+		{
+			const char* k = v->m[i].k;
+			v->m[i].k = static_cast<char*>(LEPT_MALLOC(v->m[i].klen + 1));
+			memcpy(v->m[i].k, k, v->m[i].klen + 1);
+		}
+		v->flags = 0;
+	}
+	if (v->msize == LEPT_M_CAPACITY(v))
 		lept_reserve_object(v, v->msize ? v->msize * 2 : 1);
-	v->m[v->msize].k = static_cast<char*>(malloc(klen + 1));
-	memcpy(v->m[v->msize].k, key, klen);
-	v->m[v->msize].k[klen] = '\0';
+	v->m[v->msize].k = lept_alloc_key(lept_home(v), key, klen);
 	v->m[v->msize].klen = klen;
-	return &(v->m[v->msize++].v);
+	lept_init_home(&(v->m[v->msize].v), lept_home(v));
+	if (lept_index_slot(v) != NULL && *lept_index_slot(v) != NULL)
+	{
+		lept_object_index* x = *lept_index_slot(v);
+		if (2 * (v->msize + 1) > x->capacity)
+			x = lept_index_resize(v, v->msize + 1, x);
+		lept_index_add(x, lept_hash_key(key, klen), v->msize);
+		return &(v->m[v->msize++].v);
+	}
+	v->msize++;
+	lept_index_build(v);
+	return &(v->m[v->msize - 1].v);
 }
 void lept_remove_object_value(lept_value *v, size_t index)
 {
-	assert(v != NULL && v->type == LEPT_OBJECT && index < v->msize);
-	free(v->m[index].k);
+	assert(v != NULL && v->type == LEPT_OBJECT);
+	EXPAND(v);
+	assert(index < v->msize);
+	if (lept_index_slot(v) != NULL && *lept_index_slot(v) != NULL)
+		lept_index_remove(v, *lept_index_slot(v), index);
+	if (!(v->flags & (LEPT_BORROWED_KEYS | LEPT_ARENA)))
+		LEPT_FREE(v->m[index].k);
+	lept_free(&(v->m[index].v));
 	for (size_t i = index + 1; i != v->msize; ++i)
 	{
 		v->m[i - 1].k = v->m[i].k;
+		v->m[i - 1].klen = v->m[i].klen;
 		lept_move(&(v->m[i - 1].v), &(v->m[i].v));
 	}
 	--v->msize;
 }
+
+/* tape document: each value is one word (type in the top byte) or two words, containers
+   store the position just past their last child so a sibling is reached in one step */
+
+#define LEPT_TAPE_WORD(type, payload) ((static_cast<uint64_t>(type) << 56) | (payload))
+#define LEPT_TAPE_TYPE(w)             static_cast<lept_type>((w) >> 56)
+#define LEPT_TAPE_PAYLOAD(w)          ((w) & ((static_cast<uint64_t>(1) << 56) - 1))
+
+struct lept_tape_context
+{
+	lept_context c;          // scalars are still decoded by the lept_parse_* functions
+	lept_tape* t;
+	size_t capacity;         // words allocated for t->words
+	size_t depth;            // open arrays and objects
+};
+
+static uint64_t* lept_tape_push(lept_tape_context* tc, size_t n)
+{
+	uint64_t* ret;
+	if (tc->t->size + n > tc->capacity)
+	{
+		while (tc->t->size + n > tc->capacity)
+			tc->capacity += tc->capacity >> 1;
+		tc->t->words = static_cast<uint64_t*>(LEPT_REALLOC(tc->t->words, tc->capacity * sizeof(uint64_t)));
+	}
+	ret = tc->t->words + tc->t->size;
+	tc->t->size += n;
+	return ret;
+}
+
+static int lept_parse_tape_string(lept_tape_context* tc)
+{
+	const char* str;
+	size_t len;
+	uint64_t* w;
+	int ret;
+	if ((ret = lept_parse_string_raw(&tc->c, &str, &len)) != LEPT_PARSE_OK)
+		return ret;
+	// the buffer was sized from the input, an unescaped string is never longer than its source
+	w = lept_tape_push(tc, 2);
+	w[0] = LEPT_TAPE_WORD(LEPT_STRING, tc->t->slen);
+	w[1] = len;
+	memcpy(tc->t->strings + tc->t->slen, str, len);
+	tc->t->strings[tc->t->slen + len] = '\0';
+	tc->t->slen += len + 1;
+	return LEPT_PARSE_OK;
+}
+
+static int lept_parse_tape_value(lept_tape_context* tc);
+
+// arrays and objects share the loop, an object member is a key string followed by its value
+static int lept_parse_tape_container(lept_tape_context* tc, lept_type type)
+{
+	lept_context* c = &tc->c;
+	char close = type == LEPT_ARRAY ? ']' : '}';
+	size_t head = tc->t->size, size = 0;
+	int ret;
+	lept_tape_push(tc, 2);
+	c->json++;
+	lept_parse_whitespace(c);
+	if (PEEK(c) != close)
+	{
+		while (1)
+		{
+			if (type == LEPT_OBJECT)
+			{
+				if (PEEK(c) != '\"')
+					return LEPT_PARSE_MISS_KEY;
+				if ((ret = lept_parse_tape_string(tc)) != LEPT_PARSE_OK)
+					return ret;
+				lept_parse_whitespace(c);
+				if (PEEK(c) != ':')
+					return LEPT_PARSE_MISS_COLON;
+				c->json++;
+				lept_parse_whitespace(c);
+			}
+			if ((ret = lept_parse_tape_value(tc)) != LEPT_PARSE_OK)
+				return ret;
+			size++;
+			lept_parse_whitespace(c);
+			if (PEEK(c) == close)
+				break;
+			if (PEEK(c) != ',')
+				return type == LEPT_ARRAY ? LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET : LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET;
+			c->json++;
+			lept_parse_whitespace(c);
+		}
+	}
+	c->json++;
+	tc->t->words[head] = LEPT_TAPE_WORD(type, tc->t->size);
+	tc->t->words[head + 1] = size;
+	return LEPT_PARSE_OK;
+}
+
+static int lept_parse_tape_value(lept_tape_context* tc)
+{
+	lept_value v;
+	uint64_t* w;
+	int ret;
+	if (tc->c.json == tc->c.end)
+		return LEPT_PARSE_EXPECT_VALUE;
+	switch (*tc->c.json)
+	{
+	case '\"': return lept_parse_tape_string(tc);
+	case '[':
+	case '{':
+		if (tc->depth == lept_tree_depth())
+			return LEPT_PARSE_TOO_DEEP;
+		tc->depth++;
+		ret = lept_parse_tape_container(tc, *tc->c.json == '[' ? LEPT_ARRAY : LEPT_OBJECT);
+		tc->depth--;
+		return ret;
+	case 't':  ret = lept_parse_literal(&tc->c, &v, "true", LEPT_TRUE); break;
+	case 'f':  ret = lept_parse_literal(&tc->c, &v, "false", LEPT_FALSE); break;
+	case 'n':  ret = lept_parse_literal(&tc->c, &v, "null", LEPT_NULL); break;
+	default:   ret = lept_parse_number(&tc->c, &v); break;
+	}
+	if (ret != LEPT_PARSE_OK)
+		return ret;
+	if (v.type == LEPT_NUMBER)
+	{
+		w = lept_tape_push(tc, 2);
+		w[0] = LEPT_TAPE_WORD(LEPT_NUMBER, v.ntype);
+		memcpy(&w[1], &v.n, sizeof(uint64_t));  // double, int64_t or uint64_t bits as they are
+	}
+	else
+		*lept_tape_push(tc, 1) = LEPT_TAPE_WORD(v.type, 0);
+	return LEPT_PARSE_OK;
+}
+
+int lept_parse_tape(lept_tape* t, const char* json)
+{
+	lept_tape_context tc;
+	size_t len = strlen(json);
+	int ret;
+	assert(t != NULL);
+	tc.c.json = json;
+	tc.c.end = json + len;
+	tc.c.stack = NULL;
+	tc.c.size = tc.c.top = 0;
+	tc.c.insitu = 0;
+	tc.t = t;
+	tc.capacity = len / 4 + 16;
+	tc.depth = 0;
+	t->words = static_cast<uint64_t*>(LEPT_MALLOC(tc.capacity * sizeof(uint64_t)));
+	t->strings = static_cast<char*>(LEPT_MALLOC(len + 1));
+	t->size = t->slen = 0;
+	lept_parse_whitespace(&tc.c);
+	ret = lept_parse_tape_value(&tc);
+	if (ret == LEPT_PARSE_OK)
+	{
+		lept_parse_whitespace(&tc.c);
+		if (tc.c.json != tc.c.end)
+			ret = LEPT_PARSE_ROOT_NOT_SINGULAR;
+	}
+	LEPT_FREE(tc.c.stack);
+	if (ret != LEPT_PARSE_OK)
+		lept_free_tape(t);
+	return ret;
+}
+
+void lept_free_tape(lept_tape* t)
+{
+	assert(t != NULL);
+	LEPT_FREE(t->words);
+	LEPT_FREE(t->strings);
+	t->words = NULL;
+	t->strings = NULL;
+	t->size = t->slen = 0;
+}
+
+lept_type lept_tape_get_type(const lept_tape* t, size_t pos)
+{
+	assert(t != NULL && pos < t->size);
+	return LEPT_TAPE_TYPE(t->words[pos]);
+}
+size_t lept_tape_next(const lept_tape* t, size_t pos)
+{
+	assert(t != NULL && pos < t->size);
+	switch (LEPT_TAPE_TYPE(t->words[pos]))
+	{
+	case LEPT_NUMBER:
+	case LEPT_STRING: return pos + 2;
+	case LEPT_ARRAY:
+	case LEPT_OBJECT: return static_cast<size_t>(LEPT_TAPE_PAYLOAD(t->words[pos]));
+	default:          return pos + 1;
+	}
+}
+
+int lept_tape_get_boolean(const lept_tape* t, size_t pos)
+{
+	assert(t != NULL && pos < t->size);
+	assert(LEPT_TAPE_TYPE(t->words[pos]) == LEPT_TRUE || LEPT_TAPE_TYPE(t->words[pos]) == LEPT_FALSE);
+	return LEPT_TAPE_TYPE(t->words[pos]) == LEPT_TRUE;
+}
+
+double lept_tape_get_number(const lept_tape* t, size_t pos)
+{
+	double n;
+	assert(t != NULL && pos < t->size && LEPT_TAPE_TYPE(t->words[pos]) == LEPT_NUMBER);
+	switch (LEPT_TAPE_PAYLOAD(t->words[pos]))
+	{
+	case LEPT_NUMBER_INT64:  return static_cast<double>(static_cast<int64_t>(t->words[pos + 1]));
+	case LEPT_NUMBER_UINT64: return static_cast<double>(t->words[pos + 1]);
+	default:
+		memcpy(&n, &t->words[pos + 1], sizeof(double));
+		return n;
+	}
+}
+lept_number_type lept_tape_get_number_type(const lept_tape* t, size_t pos)
+{
+	assert(t != NULL && pos < t->size && LEPT_TAPE_TYPE(t->words[pos]) == LEPT_NUMBER);
+	return static_cast<lept_number_type>(LEPT_TAPE_PAYLOAD(t->words[pos]));
+}
+int64_t lept_tape_get_int64(const lept_tape* t, size_t pos)
+{
+	assert(lept_tape_get_number_type(t, pos) == LEPT_NUMBER_INT64);
+	return static_cast<int64_t>(t->words[pos + 1]);
+}
+uint64_t lept_tape_get_uint64(const lept_tape* t, size_t pos)
+{
+	assert(lept_tape_get_number_type(t, pos) != LEPT_NUMBER_DOUBLE);
+	assert(lept_tape_get_number_type(t, pos) == LEPT_NUMBER_UINT64 || static_cast<int64_t>(t->words[pos + 1]) >= 0);
+	return t->words[pos + 1];
+}
+
+const char* lept_tape_get_string(const lept_tape* t, size_t pos)
+{
+	assert(t != NULL && pos < t->size && LEPT_TAPE_TYPE(t->words[pos]) == LEPT_STRING);
+	return t->strings + LEPT_TAPE_PAYLOAD(t->words[pos]);
+}
+size_t lept_tape_get_string_length(const lept_tape* t, size_t pos)
+{
+	assert(t != NULL && pos < t->size && LEPT_TAPE_TYPE(t->words[pos]) == LEPT_STRING);
+	return static_cast<size_t>(t->words[pos + 1]);
+}
+
+size_t lept_tape_get_array_size(const lept_tape* t, size_t pos)
+{
+	assert(t != NULL && pos < t->size && LEPT_TAPE_TYPE(t->words[pos]) == LEPT_ARRAY);
+	return static_cast<size_t>(t->words[pos + 1]);
+}
+size_t lept_tape_get_array_element(const lept_tape* t, size_t pos, size_t index)
+{
+	assert(index < lept_tape_get_array_size(t, pos));
+	for (pos += 2; index > 0; index--)
+		pos = lept_tape_next(t, pos);
+	return pos;
+}
+
+size_t lept_tape_get_object_size(const lept_tape* t, size_t pos)
+{
+	assert(t != NULL && pos < t->size && LEPT_TAPE_TYPE(t->words[pos]) == LEPT_OBJECT);
+	return static_cast<size_t>(t->words[pos + 1]);
+}
+// position of the key string of a member, its value follows at key + 2
+static size_t lept_tape_get_object_member(const lept_tape* t, size_t pos, size_t index)
+{
+	assert(index < lept_tape_get_object_size(t, pos));
+	for (pos += 2; index > 0; index--)
+		pos = lept_tape_next(t, pos + 2);
+	return pos;
+}
+const char* lept_tape_get_object_key(const lept_tape* t, size_t pos, size_t index)
+{
+	return lept_tape_get_string(t, lept_tape_get_object_member(t, pos, index));
+}
+size_t lept_tape_get_object_key_length(const lept_tape* t, size_t pos, size_t index)
+{
+	return lept_tape_get_string_length(t, lept_tape_get_object_member(t, pos, index));
+}
+size_t lept_tape_get_object_value(const lept_tape* t, size_t pos, size_t index)
+{
+	return lept_tape_get_object_member(t, pos, index) + 2;
+}
+size_t lept_tape_find_object_value(const lept_tape* t, size_t pos, const char* key, size_t klen)
+{
+	size_t i, size = lept_tape_get_object_size(t, pos);
+	for (i = 0, pos += 2; i < size; i++, pos = lept_tape_next(t, pos + 2))
+		if (lept_tape_get_string_length(t, pos) == klen && memcmp(lept_tape_get_string(t, pos), key, klen) == 0)
+			return pos + 2;
+	return LEPT_KEY_NOT_EXIST;
+}
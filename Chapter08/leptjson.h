@@ -2,23 +2,72 @@
 #define LEPTJSON_H_
 
 #include <stddef.h> /* size_t */
+#include <stdint.h> /* int64_t, uint64_t */
+#include <stdio.h>  /* FILE */
 
 enum lept_type {LEPT_NULL, LEPT_FALSE, LEPT_TRUE, LEPT_NUMBER, LEPT_STRING, LEPT_ARRAY, LEPT_OBJECT};
+// how a LEPT_NUMBER is stored; integers without '.' or exponent are kept exactly,
+// LEPT_NUMBER_UINT64 only holds values above INT64_MAX
+enum lept_number_type {LEPT_NUMBER_DOUBLE, LEPT_NUMBER_INT64, LEPT_NUMBER_UINT64};
 
 #define LEPT_KEY_NOT_EXIST (static_cast<size_t>(-1))
 
 struct lept_member;
+struct lept_document;
 
+#ifdef LEPT_COMPACT
+// 16 bytes instead of 32, for very large arrays. Define LEPT_COMPACT for leptjson.cpp and for every file
+// including this header. Counts and string lengths are limited to 32 bits, the capacity of an array or
+// object is kept in front of its elements or members, strings are stored in place below 8 bytes, and a
+// null, boolean or number in a document keeps the document's address (at most 48 bits) in doc_lo/doc_hi.
+struct lept_value
+{
+	union {
+		lept_member* m;                          // object: members
+		lept_value* e;                           // array: elements
+		double* packed;                          // array of doubles only: the numbers
+		char* s;                                 // null-terminated string
+		const char* src;                         // lazy array/object: its source, not parsed yet
+		double n;                                // number
+		int64_t i;                               // integer number
+		uint64_t u;                              // integer number above INT64_MAX
+		char sso[8];                             // short string stored in place, its length in ntype
+	};
+	union { uint32_t msize, size, len, src_len, doc_lo; };  // member, element, character or source count
+	uint16_t doc_hi;
+	unsigned char type : 3;                      // lept_type
+	unsigned char ntype : 3;                     // lept_number_type of a number, length of an in-place string
+	unsigned char flags : 6;                     // storage borrowed from an in-situ parse, lazy, in a document
+};
+#else
 struct lept_value
 {
 	union {
 		struct { lept_member* m; size_t msize, m_capacity; };
-		struct { lept_value* e; size_t size, e_capacity; };  // array: elements, element count
+		struct {
+			union {
+				lept_value* e;                   // array: elements
+				double* packed;                  // array of doubles only: the numbers
+			};
+			size_t size, e_capacity;             // element count
+		};
 		struct { char* s; size_t len; };         // null-terminated string, string length
-		double n;                                // number
+		char sso[sizeof(void*) + 2 * sizeof(size_t)];  // short string stored in place, its length in ntype
+		struct { const char* src, *src_end; };   // lazy array/object: its source, not parsed yet
+		struct {
+			union {
+				double n;                        // number
+				int64_t i;                       // integer number
+				uint64_t u;                      // integer number above INT64_MAX
+			};
+			lept_document* doc;                  // null, boolean or number stored in a document
+		};
 	};
 	lept_type type;
+	unsigned char ntype;                         // lept_number_type of a number, length of an in-place string
+	unsigned char flags;                         // storage borrowed from an in-situ parse, lazy, in a document
 };
+#endif
 
 struct lept_member
 {
@@ -42,13 +91,139 @@ enum parse_state
 	LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET,
 	LEPT_PARSE_MISS_KEY,
 	LEPT_PARSE_MISS_COLON,
-	LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET
+	LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET,
+	LEPT_PARSE_NEED_MORE,                       // lept_parser_feed: the document is not complete yet
+	LEPT_PARSE_ABORTED,                         // lept_parse_sax: a handler returned 0
+	LEPT_PARSE_TOO_DEEP                         // arrays and objects nested beyond lept_get_max_depth()
 };
 
-#define lept_init(v) do {(v)->type = LEPT_NULL;} while(0)
+// instruction sets used by the scanning loops, picked at runtime from what the CPU supports. The CPU
+// is checked once, and threads may parse, and even set the level, at the same time.
+enum lept_simd {LEPT_SIMD_NONE, LEPT_SIMD_SSE2, LEPT_SIMD_AVX2};
+
+lept_simd lept_get_simd(void);
+lept_simd lept_set_simd(lept_simd level);  // clamped to the CPU, returns the level in use
+
+// nesting limit of every parser, LEPT_PARSE_MAX_DEPTH (1024) unless set; a depth of 0 allows scalars only.
+// lept_free, lept_copy, lept_is_equal and lept_stringify recurse once per level, so the parsers that
+// build a tree (or the tape) never go past LEPT_TREE_MAX_DEPTH (2048) levels, whatever is set here;
+// lept_parse_sax and lept_reader take any depth. Trees built by hand deeper than that may overflow
+// the call stack in those functions.
+void lept_set_max_depth(size_t depth);
+size_t lept_get_max_depth(void);
+
+// doubles are written with the fewest digits that read back to the same number (default), or with
+// sprintf("%.17g") when set to 0; both use exponent notation below 1e-4 and from 1e17 on
+void lept_set_shortest_numbers(int enable);
+int lept_get_shortest_numbers(void);
+
+// every allocation of the library goes through these, with ctx passed back as the first argument.
+// Set before anything is allocated: memory is always released with the allocator in use at that time.
+struct lept_allocator
+{
+	void* (*malloc_fn)(void* ctx, size_t size);
+	void* (*realloc_fn)(void* ctx, void* p, size_t size);   // p may be NULL
+	void (*free_fn)(void* ctx, void* p);                    // p may be NULL
+	void* ctx;
+};
+
+void lept_set_allocator(const lept_allocator* a);  // copied; NULL restores malloc(), realloc() and free()
+const lept_allocator* lept_get_allocator(void);
+
+#define lept_init(v) do {(v)->type = LEPT_NULL; (v)->flags = 0;} while(0)
 // most important
 int lept_parse(lept_value* v, const char* json);
+// parses exactly len bytes, json need not be null-terminated and is never read past json + len
+int lept_parse_n(lept_value* v, const char* json, size_t len);
+// same result as lept_parse, built from a SIMD index of the structural characters
+int lept_parse_indexed(lept_value* v, const char* json);
+// strings and keys are unescaped inside json and point into it: the buffer is modified, even
+// on error, and must outlive v; lept_free and the setters never free the borrowed parts
+int lept_parse_insitu(lept_value* v, char* json);
+// validates all of json, but an array or object is only built, one level at a time, when an
+// array/object function first looks inside it; json must outlive v and copies of its parts.
+// Such a first look modifies the value even through a const pointer.
+int lept_parse_lazy(lept_value* v, const char* json);
+// same result as lept_parse_n. A document whose root is an array is split between elements
+// and parsed by threads threads (0: one per core), which use the allocator concurrently;
+// small inputs and other roots are parsed on the calling thread.
+int lept_parse_parallel(lept_value* v, const char* json, size_t len, unsigned threads);
+// Newline-delimited JSON: every line that is not blank is one document. Lines are parsed by
+// threads threads (0: one per core), each reusing its scratch buffers, and handed to record in
+// input order on the calling thread, line counting from 1. A record that failed has its error in
+// ret and a null v; it does not stop the batch, record returning 0 does. v may be moved out of,
+// what is left of it is freed after the call. Returns the number of records handed over.
+size_t lept_parse_ndjson(const char* json, size_t len, unsigned threads, int (*record)(void* ctx, size_t line, int ret, lept_value* v), void* ctx);
+// the same for a file read from its current position to its end
+size_t lept_parse_ndjson_file(FILE* f, unsigned threads, int (*record)(void* ctx, size_t line, int ret, lept_value* v), void* ctx);
+
+// SAX-style events, in document order; a NULL callback ignores its event and a callback returning 0
+// stops the parse. Strings and keys are only valid during the call and are not null-terminated.
+struct lept_handler
+{
+	int (*null)(void* ctx);
+	int (*boolean)(void* ctx, int b);
+	int (*number)(void* ctx, double n);
+	int (*int64)(void* ctx, int64_t i);        // integers; if NULL they go to number
+	int (*uint64)(void* ctx, uint64_t u);      // integers above INT64_MAX; if NULL they go to number
+	int (*string)(void* ctx, const char* s, size_t len);
+	int (*key)(void* ctx, const char* k, size_t len);
+	int (*start_object)(void* ctx);
+	int (*end_object)(void* ctx, size_t member_count);
+	int (*start_array)(void* ctx);
+	int (*end_array)(void* ctx, size_t element_count);
+};
+
+// no tree is built; lept_parse is this with a handler that builds one
+int lept_parse_sax(const char* json, size_t len, const lept_handler* handler, void* ctx);
+
+// forward-only pull reader over a whole document, one token per lept_reader_next
+enum lept_token
+{
+	LEPT_TOKEN_END,             // the document has been read completely
+	LEPT_TOKEN_ERROR,           // lept_reader_get_error tells which; it is returned from then on
+	LEPT_TOKEN_NULL, LEPT_TOKEN_FALSE, LEPT_TOKEN_TRUE, LEPT_TOKEN_NUMBER, LEPT_TOKEN_STRING,
+	LEPT_TOKEN_KEY,             // the value of the member follows
+	LEPT_TOKEN_START_OBJECT, LEPT_TOKEN_END_OBJECT, LEPT_TOKEN_START_ARRAY, LEPT_TOKEN_END_ARRAY
+};
+
+struct lept_reader;
+lept_reader* lept_reader_create(const char* json, size_t len);  // json must outlive the reader
+void lept_reader_destroy(lept_reader* r);
+lept_token lept_reader_next(lept_reader* r);
+// after START_OBJECT/START_ARRAY reads through the matching end, after KEY through the member's
+// value, otherwise does nothing; returns LEPT_PARSE_OK or the error met
+int lept_reader_skip(lept_reader* r);
+int lept_reader_get_error(const lept_reader* r);
+
+// payload of the last token; a string or key is valid until the next call and not null-terminated
+const char* lept_reader_get_string(const lept_reader* r);
+size_t lept_reader_get_string_length(const lept_reader* r);
+double lept_reader_get_number(const lept_reader* r);
+lept_number_type lept_reader_get_number_type(const lept_reader* r);
+int64_t lept_reader_get_int64(const lept_reader* r);
+uint64_t lept_reader_get_uint64(const lept_reader* r);
+
+// incremental parsing of a document that arrives in chunks of any size
+struct lept_parser;
+lept_parser* lept_parser_create(void);
+void lept_parser_destroy(lept_parser* p);
+// LEPT_PARSE_NEED_MORE, LEPT_PARSE_OK once the root value is complete, or the error found so far
+int lept_parser_feed(lept_parser* p, const char* buf, size_t len);
+// end of input: same result as lept_parse on all the chunks joined, then ready for the next document
+int lept_parser_finish(lept_parser* p, lept_value* v);
+// a whole document, same result as lept_parse_n; a document being fed is dropped. The parser's
+// scratch buffers are kept between documents, so a steady stream of them allocates none.
+int lept_parser_parse(lept_parser* p, lept_value* v, const char* json, size_t len);
+// scratch buffers grown past this many bytes are shrunk back to it after each document (default: no limit);
+// below LEPT_PARSE_STACK_INIT_SIZE (256) they are freed instead
+void lept_parser_set_scratch_limit(lept_parser* p, size_t bytes);
+// the result is the caller's, release it with the allocator's free_fn (free() by default)
 char* lept_stringify(const lept_value* v, size_t* length);
+// the same text, written by threads threads (0: one per core), which use the allocator concurrently;
+// a large tree is cut into ranges of elements or members, a small one is written on this thread.
+// Lazy values in a large tree are all built first, on this thread.
+char* lept_stringify_parallel(const lept_value* v, size_t* length, unsigned threads);
 
 void lept_copy(lept_value *dst, const lept_value *src);
 void lept_move(lept_value *dst, lept_value *src);
@@ -66,7 +241,13 @@ void lept_set_boolean(lept_value* v, int b);
 
 double lept_get_number(const lept_value* v);
 void lept_set_number(lept_value* v, double n);
+lept_number_type lept_get_number_type(const lept_value* v);
+int64_t lept_get_int64(const lept_value* v);
+void lept_set_int64(lept_value* v, int64_t i);
+uint64_t lept_get_uint64(const lept_value* v);
+void lept_set_uint64(lept_value* v, uint64_t u);
 
+// short strings are kept inside v: the pointer is only valid until v is changed or moved
 const char* lept_get_string(const lept_value* v);
 size_t lept_get_string_length(const lept_value* v);
 void lept_set_string(lept_value* v, const char* s, size_t len);
@@ -82,6 +263,18 @@ lept_value* lept_pushback_array_element(lept_value *v);
 void lept_popback_array_element(lept_value *v);
 lept_value* lept_insert_array_element(lept_value *v, size_t index);
 void lept_erase_array_element(lept_value *v, size_t index, size_t count);
+// An array whose elements are all double numbers (no integer literals) may be stored as a plain
+// double[]: lept_set_number_array and lept_get_number_array make one, and the parsers do for
+// LEPT_PACK_MIN (16) elements or more unless lept_set_pack_numbers(0) is called (default: 1). The
+// functions above work on it as usual. The first lept_get_array_element makes lept_values for all
+// the elements, next to the numbers, which stay: threads may read the array through const pointers
+// at the same time. Functions that change the array go on with those lept_values.
+// lept_get_number_array packs an all-double array if needed, then gives its numbers, which stay
+// valid and writable until the array is changed; it returns 0 for any other array.
+void lept_set_pack_numbers(int enable);
+int lept_get_pack_numbers(void);
+int lept_get_number_array(lept_value* v, double** data, size_t* n);
+void lept_set_number_array(lept_value* v, const double* data, size_t n);
 
 void lept_set_object(lept_value *v, size_t capacity);
 size_t lept_get_object_size(const lept_value* v);
@@ -92,9 +285,58 @@ void lept_clear_object(lept_value *v);
 const char* lept_get_object_key(const lept_value* v, size_t index);
 size_t lept_get_object_key_length(const lept_value* v, size_t index);
 lept_value* lept_get_object_value(const lept_value* v, size_t index);
+// objects of 16 members or more get a hash index from the parsers and lept_set_object_value; lookups
+// only read it, and never modify a value that is not lazy
 size_t lept_find_object_index(const lept_value *v, const char *key, size_t klen);
 lept_value* lept_find_object_value(lept_value *v, const char *key, size_t klen);
 lept_value* lept_set_object_value(lept_value *v, const char *key, size_t klen);
 void lept_remove_object_value(lept_value *v, size_t index);
 
+// A document owns an arena holding all of its strings, keys, elements and members, which are
+// released together by reset or destroy without visiting the tree. Its values are changed with
+// the usual functions and grow inside the arena; a value moved or copied in or out is copied
+// between the arena and the heap. lept_free on one of them only makes it null.
+lept_document* lept_document_create(void);
+void lept_document_destroy(lept_document* d);
+void lept_document_reset(lept_document* d);           // root becomes null, the arena is reused
+lept_value* lept_document_get_root(lept_document* d);
+int lept_parse_document(lept_document* d, const char* json);  // resets d, then parses into its root
+// off by default. When on, each distinct key is stored once per document and all the members with
+// that name point to it, which saves most of the key memory of an array of records.
+void lept_document_set_intern_keys(lept_document* d, int enable);
+size_t lept_document_get_used(const lept_document* d);  // arena bytes taken by the values, keys and strings
+
+// read-only document in one array of 64-bit words plus one string buffer; values are named
+// by their position on the tape, the root is at 0
+struct lept_tape
+{
+	uint64_t* words; size_t size;   // tape words, word count
+	char* strings; size_t slen;     // null-terminated strings back to back, bytes used
+};
+
+int lept_parse_tape(lept_tape* t, const char* json);
+void lept_free_tape(lept_tape* t);
+
+lept_type lept_tape_get_type(const lept_tape* t, size_t pos);
+size_t lept_tape_next(const lept_tape* t, size_t pos);  // position of the value after pos and its children
+
+int lept_tape_get_boolean(const lept_tape* t, size_t pos);
+double lept_tape_get_number(const lept_tape* t, size_t pos);
+lept_number_type lept_tape_get_number_type(const lept_tape* t, size_t pos);
+int64_t lept_tape_get_int64(const lept_tape* t, size_t pos);
+uint64_t lept_tape_get_uint64(const lept_tape* t, size_t pos);
+const char* lept_tape_get_string(const lept_tape* t, size_t pos);
+size_t lept_tape_get_string_length(const lept_tape* t, size_t pos);
+
+// element and member lookups walk the siblings before them; to visit all of them start at
+// element 0 and step with lept_tape_next. An object member is its key string followed by
+// its value two words later, so lept_tape_next of a value is the key of the next member.
+size_t lept_tape_get_array_size(const lept_tape* t, size_t pos);
+size_t lept_tape_get_array_element(const lept_tape* t, size_t pos, size_t index);
+size_t lept_tape_get_object_size(const lept_tape* t, size_t pos);
+const char* lept_tape_get_object_key(const lept_tape* t, size_t pos, size_t index);
+size_t lept_tape_get_object_key_length(const lept_tape* t, size_t pos, size_t index);
+size_t lept_tape_get_object_value(const lept_tape* t, size_t pos, size_t index);
+size_t lept_tape_find_object_value(const lept_tape* t, size_t pos, const char* key, size_t klen);
+
 #endif
\ No newline at end of file
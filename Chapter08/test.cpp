@@ -5,7 +5,10 @@
 
 #include <stdio.h>
 #include <string.h>
+#include <float.h>
+#include <math.h>
 #include <cstdlib>
+#include <thread>
 #include "leptjson.h"
 
 static int main_ret = 0; // main function return value
@@ -38,12 +41,15 @@ static int test_pass = 0;
 #define EXPECT_EQ_SIZE_T(expect, actual) EXPECT_EQ_BASE((expect)==(actual), (size_t)expect, (size_t)actual, "%zu");
 #endif
 
+/* the parse engine under test; every engine must pass the same suite */
+static int (*parse_json)(lept_value* v, const char* json) = lept_parse;
+
 static void test_parse_null()
 {
 	lept_value v;
 	lept_init(&v);
 	lept_set_boolean(&v, 0);
-	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, "null"));
+	EXPECT_EQ_INT(LEPT_PARSE_OK, parse_json(&v, "null"));
 	EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&v));
 	lept_free(&v);
 }
@@ -53,7 +59,7 @@ static void test_parse_true()
 	lept_value v;
 	lept_init(&v);
 	lept_set_boolean(&v, 0);
-	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, "true"));
+	EXPECT_EQ_INT(LEPT_PARSE_OK, parse_json(&v, "true"));
 	EXPECT_EQ_INT(LEPT_TRUE, lept_get_type(&v));
 	lept_free(&v);
 }
@@ -63,7 +69,7 @@ static void test_parse_false()
 	lept_value v;
 	lept_init(&v);
 	lept_set_boolean(&v, 1);
-	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, "false"));
+	EXPECT_EQ_INT(LEPT_PARSE_OK, parse_json(&v, "false"));
 	EXPECT_EQ_INT(LEPT_FALSE, lept_get_type(&v));
 	lept_free(&v);
 }
@@ -73,7 +79,7 @@ static void test_parse_false()
 	{\
 		lept_value v;\
 		lept_init(&v);\
-		EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, json));\
+		EXPECT_EQ_INT(LEPT_PARSE_OK, parse_json(&v, json));\
 		EXPECT_EQ_INT(LEPT_NUMBER, lept_get_type(&v));\
 		EXPECT_EQ_DOUBLE(expect, lept_get_number(&v));\
 		lept_free(&v);\
@@ -112,12 +118,153 @@ static void test_parse_number()
 	TEST_NUMBER(-1.7976931348623157e+308, "-1.7976931348623157e+308");
 }
 
+#define TEST_INT64(expect, json)\
+	do\
+	{\
+		lept_value v;\
+		lept_init(&v);\
+		EXPECT_EQ_INT(LEPT_PARSE_OK, parse_json(&v, json));\
+		EXPECT_EQ_INT(LEPT_NUMBER, lept_get_type(&v));\
+		EXPECT_EQ_INT(LEPT_NUMBER_INT64, lept_get_number_type(&v));\
+		EXPECT_TRUE((expect) == lept_get_int64(&v));\
+		lept_free(&v);\
+	} while (0)
+
+static void test_parse_int64()
+{
+	lept_value v;
+
+	TEST_INT64(0, "0");
+	TEST_INT64(-1, "-1");
+	TEST_INT64(123, "123");
+	TEST_INT64(9007199254740993LL, "9007199254740993"); /* 2^53 + 1, not a double */
+	TEST_INT64(1234567890123456789LL, "1234567890123456789");
+	TEST_INT64(INT64_MAX, "9223372036854775807");
+	TEST_INT64(INT64_MIN, "-9223372036854775808");
+
+	lept_init(&v);
+	EXPECT_EQ_INT(LEPT_PARSE_OK, parse_json(&v, "9223372036854775808"));
+	EXPECT_EQ_INT(LEPT_NUMBER_UINT64, lept_get_number_type(&v));
+	EXPECT_TRUE(9223372036854775808ULL == lept_get_uint64(&v));
+	EXPECT_EQ_INT(LEPT_PARSE_OK, parse_json(&v, "18446744073709551615"));
+	EXPECT_EQ_INT(LEPT_NUMBER_UINT64, lept_get_number_type(&v));
+	EXPECT_TRUE(UINT64_MAX == lept_get_uint64(&v));
+	EXPECT_EQ_DOUBLE(18446744073709551615.0, lept_get_number(&v));
+
+	/* out of range, negative zero, fraction or exponent: double */
+	EXPECT_EQ_INT(LEPT_PARSE_OK, parse_json(&v, "18446744073709551616"));
+	EXPECT_EQ_INT(LEPT_NUMBER_DOUBLE, lept_get_number_type(&v));
+	EXPECT_EQ_DOUBLE(18446744073709551616.0, lept_get_number(&v));
+	EXPECT_EQ_INT(LEPT_PARSE_OK, parse_json(&v, "-9223372036854775809"));
+	EXPECT_EQ_INT(LEPT_NUMBER_DOUBLE, lept_get_number_type(&v));
+	EXPECT_EQ_INT(LEPT_PARSE_OK, parse_json(&v, "123456789012345678901"));
+	EXPECT_EQ_INT(LEPT_NUMBER_DOUBLE, lept_get_number_type(&v));
+	EXPECT_EQ_INT(LEPT_PARSE_OK, parse_json(&v, "-0"));
+	EXPECT_EQ_INT(LEPT_NUMBER_DOUBLE, lept_get_number_type(&v));
+	EXPECT_EQ_INT(LEPT_PARSE_OK, parse_json(&v, "1.0"));
+	EXPECT_EQ_INT(LEPT_NUMBER_DOUBLE, lept_get_number_type(&v));
+	EXPECT_EQ_INT(LEPT_PARSE_OK, parse_json(&v, "1e2"));
+	EXPECT_EQ_INT(LEPT_NUMBER_DOUBLE, lept_get_number_type(&v));
+	lept_free(&v);
+}
+
+static unsigned long long random_state = 88172645463325252ULL;
+
+static unsigned long long random_next()
+{
+	random_state ^= random_state << 13;
+	random_state ^= random_state >> 7;
+	random_state ^= random_state << 17;
+	return random_state;
+}
+
+/* lept_parse must agree bit for bit with the C library */
+static void test_number_against_strtod(const char* json)
+{
+	lept_value v;
+	double expect = strtod(json, NULL);
+	lept_init(&v);
+	if (expect == HUGE_VAL || expect == -HUGE_VAL)
+		EXPECT_EQ_INT(LEPT_PARSE_NUMBER_TOO_BIG, parse_json(&v, json));
+	else
+		EXPECT_EQ_INT(LEPT_PARSE_OK, parse_json(&v, json));
+	if (lept_get_type(&v) == LEPT_NUMBER) {
+		double actual = lept_get_number(&v);
+		if (memcmp(&expect, &actual, sizeof(double)) != 0)
+			fprintf(stderr, "%s:%d: %s\n", __FILE__, __LINE__, json);
+		EXPECT_EQ_BASE(memcmp(&expect, &actual, sizeof(double)) == 0, expect, actual, "%.17g");
+	}
+	lept_free(&v);
+}
+
+static void test_parse_number_random()
+{
+	char json[128];
+	int i, j;
+
+	/* every bit pattern class, printed short, exact and with more digits than a double holds */
+	for (i = 0; i < 20000; i++) {
+		unsigned long long bits = random_next();
+		double d;
+		memcpy(&d, &bits, sizeof(double));
+		if (d != d || d == HUGE_VAL || d == -HUGE_VAL)
+			continue;
+		sprintf(json, "%.17g", d);
+		test_number_against_strtod(json);
+		sprintf(json, "%.*g", (int)(random_next() % 17) + 1, d);
+		test_number_against_strtod(json);
+		sprintf(json, "%.*e", (int)(random_next() % 20) + 17, d);
+		test_number_against_strtod(json);
+	}
+
+	/* random digit strings across the whole exponent range */
+	for (i = 0; i < 20000; i++) {
+		char* p = json;
+		int int_digits = (int)(random_next() % 25) + 1, frac_digits = (int)(random_next() % 25);
+		if (random_next() & 1)
+			*p++ = '-';
+		for (j = 0; j < int_digits; j++)
+			*p++ = (char)('0' + (j == 0 && int_digits > 1 ? random_next() % 9 + 1 : random_next() % 10));
+		if (frac_digits) {
+			*p++ = '.';
+			for (j = 0; j < frac_digits; j++)
+				*p++ = (char)('0' + random_next() % 10);
+		}
+		sprintf(p, "e%d", (int)(random_next() % 700) - 350);
+		test_number_against_strtod(json);
+	}
+
+#if LDBL_MANT_DIG >= 64
+	/* exactly halfway between two doubles, and a hair on either side */
+	for (i = 0; i < 5000; i++) {
+		unsigned long long bits = random_next() & 0x7FEFFFFFFFFFFFFFULL;
+		double d, next;
+		memcpy(&d, &bits, sizeof(double));
+		next = nextafter(d, HUGE_VAL);
+		long double mid = ((long double)d + (long double)next) / 2;
+		sprintf(json, "%.40Le", mid);
+		test_number_against_strtod(json);
+		sprintf(json, "%.25Le", mid);
+		test_number_against_strtod(json);
+	}
+#endif
+
+	test_number_against_strtod("9007199254740993");
+	test_number_against_strtod("1.00000000000000011102230246251565404236316680908203125");
+	test_number_against_strtod("1.00000000000000011102230246251565404236316680908203124");
+	test_number_against_strtod("1.00000000000000011102230246251565404236316680908203126");
+	test_number_against_strtod("2.4703282292062327208828439643411068618252990130716238221279284125033775363510437593264991818081799618989828234772285886546332835517796989819938739800539093906315035659515570226392290858392449105184435931802849936536152500319370457678249219365623669863658480757001585769269903706311928279558551332927834338409351978015531246597263579574622766465272827220056374006485499977096599470454020828166226237857393450736339007967761930577506740176324673600968951340535537458516661134223766678604162159680461914467291840300530057530849048765391711386591646239524912623653881879636239373280423891018672348497668235089863388587925628302755995657524455507255189313690836254779186948667994968324049705821028513185451396213837722826145437693412532098591327667236328125e-324");
+	test_number_against_strtod("0.000000000000000000000000000000000000000000001e-280");
+	test_number_against_strtod("7.2057594037927933e16");
+	test_number_against_strtod("123456789012345678901234567890e-340");
+}
+
 #define TEST_STRING(expect, json)\
 	do\
 	{\
 		lept_value v;\
 		lept_init(&v);\
-		EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, json));\
+		EXPECT_EQ_INT(LEPT_PARSE_OK, parse_json(&v, json));\
 		EXPECT_EQ_INT(LEPT_STRING, lept_get_type(&v));\
 		EXPECT_EQ_STRING(expect, lept_get_string(&v), lept_get_string_length(&v));\
 		lept_free(&v);\
@@ -143,13 +290,13 @@ static void test_parse_array()
 	lept_value v;
 
 	lept_init(&v);
-	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, "[ ]"));
+	EXPECT_EQ_INT(LEPT_PARSE_OK, parse_json(&v, "[ ]"));
 	EXPECT_EQ_INT(LEPT_ARRAY, lept_get_type(&v));
 	EXPECT_EQ_SIZE_T(0, lept_get_array_size(&v));
 	lept_free(&v);
 
 	lept_init(&v);
-	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, "[ null , false , true , 123 , \"abc\" ]"));
+	EXPECT_EQ_INT(LEPT_PARSE_OK, parse_json(&v, "[ null , false , true , 123 , \"abc\" ]"));
 	EXPECT_EQ_INT(LEPT_ARRAY, lept_get_type(&v));
 	EXPECT_EQ_SIZE_T(5, lept_get_array_size(&v));
 	EXPECT_EQ_INT(LEPT_NULL, lept_get_type(lept_get_array_element(&v, 0)));
@@ -162,7 +309,7 @@ static void test_parse_array()
 	lept_free(&v);
 
 	lept_init(&v);
-	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, "[ [ ] , [ 0 ] , [ 0 , 1 ] , [ 0 , 1 , 2 ] ]"));
+	EXPECT_EQ_INT(LEPT_PARSE_OK, parse_json(&v, "[ [ ] , [ 0 ] , [ 0 , 1 ] , [ 0 , 1 , 2 ] ]"));
 	EXPECT_EQ_INT(LEPT_ARRAY, lept_get_type(&v));
 	EXPECT_EQ_SIZE_T(4, lept_get_array_size(&v));
 	for (i = 0; i < 4; i++) {
@@ -184,13 +331,13 @@ static void test_parse_object()
 	size_t i;
 
 	lept_init(&v);
-	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, " { } "));
+	EXPECT_EQ_INT(LEPT_PARSE_OK, parse_json(&v, " { } "));
 	EXPECT_EQ_INT(LEPT_OBJECT, lept_get_type(&v));
 	EXPECT_EQ_SIZE_T(0, lept_get_object_size(&v));
 	lept_free(&v);
 
 	lept_init(&v);
-	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v,
+	EXPECT_EQ_INT(LEPT_PARSE_OK, parse_json(&v,
 		" { "
 		"\"n\" : null , "
 		"\"f\" : false , "
@@ -244,7 +391,7 @@ static void test_parse_object()
 		lept_value v;\
 		lept_init(&v);\
 		v.type = LEPT_FALSE;\
-		EXPECT_EQ_INT(error, lept_parse(&v, json));\
+		EXPECT_EQ_INT(error, parse_json(&v, json));\
 		EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&v));\
 		lept_free(&v);\
 	} while (0)
@@ -367,12 +514,232 @@ static void test_parse_miss_comma_or_curly_bracket()
 	TEST_ERROR(LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET, "{\"a\":{}");
 }
 
+static int parse_under_simd(lept_simd level, lept_value* v, const char* json)
+{
+	lept_simd old = lept_get_simd();
+	int ret;
+	lept_set_simd(level);
+	ret = parse_json(v, json);
+	lept_set_simd(old);
+	return ret;
+}
+
+// the first thing main runs: threads that parse at once all pick the instruction set, and one of them
+// changes it meanwhile (run under TSan to see it)
+static void test_simd_threads()
+{
+	const char* json = "[ \"a string long enough for the vector loops\" ,     {\"k\" :   [1, 2, 3]   } ,   null ]";
+	int ok[4] = { 0, 0, 0, 0 };
+	std::thread t[4];
+	for (int k = 0; k < 4; k++)
+		t[k] = std::thread([json, &ok, k]() {
+			for (int j = 0; j < 100; j++)
+			{
+				lept_value v;
+				lept_init(&v);
+				if (k == 3 && j % 10 == 0)
+					lept_set_simd((lept_simd)(j / 10 % 3));
+				ok[k] += lept_parse(&v, json) == LEPT_PARSE_OK && lept_get_array_size(&v) == 3;
+				lept_free(&v);
+			}
+		});
+	for (int k = 0; k < 4; k++)
+		t[k].join();
+	for (int k = 0; k < 4; k++)
+		EXPECT_EQ_INT(100, ok[k]);
+	lept_set_simd(LEPT_SIMD_AVX2);
+}
+
+static void test_parse_whitespace()
+{
+	static const char ws[] = " \t\n\r";
+	char json[256];
+	size_t i, n, m;
+	int level;
+	lept_value v1, v2;
+
+	/* whitespace runs of every length up to a few vector widths, at every alignment */
+	for (n = 0; n < 80; n++)
+		for (m = 0; m < 40; m += 13) {
+			char *p = json;
+			*p++ = '[';
+			for (i = 0; i < n; i++)
+				*p++ = ws[i % 4];
+			*p++ = '1';
+			for (i = 0; i < m; i++)
+				*p++ = ws[(i + n) % 4];
+			*p++ = ']';
+			for (i = 0; i < n; i++)
+				*p++ = ' ';
+			*p = '\0';
+			for (level = LEPT_SIMD_NONE; level <= LEPT_SIMD_AVX2; level++) {
+				lept_init(&v1);
+				EXPECT_EQ_INT(LEPT_PARSE_OK, parse_under_simd((lept_simd)level, &v1, json));
+				EXPECT_EQ_SIZE_T(1, lept_get_array_size(&v1));
+				EXPECT_EQ_DOUBLE(1.0, lept_get_number(lept_get_array_element(&v1, 0)));
+				lept_free(&v1);
+				lept_init(&v1);
+				EXPECT_EQ_INT(LEPT_PARSE_EXPECT_VALUE, parse_under_simd((lept_simd)level, &v1, json + strlen(json) - n));
+				lept_free(&v1);
+			}
+		}
+
+	/* a pretty-printed document parses to the same tree on every path */
+	{
+		const char* doc =
+			"{\n"
+			"        \"id\" : 1,\r\n"
+			"        \"items\" : [\n"
+			"                {\n"
+			"\t\t\t\t\t\t\t\t\t\"name\" : \"a\",\n"
+			"                                \"tags\" : [ true ,   false ,    null ]\n"
+			"                },\n"
+			"                {                                                                   }\n"
+			"        ]\n"
+			"}\n";
+		lept_init(&v1);
+		EXPECT_EQ_INT(LEPT_PARSE_OK, parse_under_simd(LEPT_SIMD_NONE, &v1, doc));
+		for (level = LEPT_SIMD_SSE2; level <= LEPT_SIMD_AVX2; level++) {
+			lept_init(&v2);
+			EXPECT_EQ_INT(LEPT_PARSE_OK, parse_under_simd((lept_simd)level, &v2, doc));
+			EXPECT_TRUE(lept_is_equal(&v1, &v2));
+			lept_free(&v2);
+		}
+		lept_free(&v1);
+	}
+
+	EXPECT_TRUE(lept_set_simd(LEPT_SIMD_NONE) == LEPT_SIMD_NONE);
+	EXPECT_TRUE(lept_set_simd(LEPT_SIMD_AVX2) == lept_get_simd());
+}
+
+static void test_parse_long_string()
+{
+	char json[160], expect[160];
+	size_t i, n, k;
+	int level;
+	lept_value v;
+
+	/* an escape, a control character or the closing quote at every offset of a few vectors */
+	for (n = 0; n < 100; n++)
+		for (level = LEPT_SIMD_NONE; level <= LEPT_SIMD_AVX2; level++) {
+			for (k = 0; k <= n; k += 7) {
+				char *p = json, *e = expect;
+				*p++ = '\"';
+				for (i = 0; i < n; i++) {
+					if (i == k) {
+						*p++ = '\\'; *p++ = 't';
+						*e++ = '\t';
+					}
+					*p++ = *e++ = (char)('a' + i % 26);
+				}
+				*p++ = '\"';
+				*p = '\0';
+				lept_init(&v);
+				EXPECT_EQ_INT(LEPT_PARSE_OK, parse_under_simd((lept_simd)level, &v, json));
+				EXPECT_EQ_SIZE_T((size_t)(e - expect), lept_get_string_length(&v));
+				EXPECT_TRUE(memcmp(expect, lept_get_string(&v), e - expect) == 0);
+				lept_free(&v);
+
+				json[1 + k] = '\x01';
+				lept_init(&v);
+				EXPECT_EQ_INT(LEPT_PARSE_INVALID_STRING_CHAR, parse_under_simd((lept_simd)level, &v, json));
+				lept_free(&v);
+
+				json[1 + k] = '\0';
+				lept_init(&v);
+				EXPECT_EQ_INT(LEPT_PARSE_MISS_QUOTATION_MARK, parse_under_simd((lept_simd)level, &v, json));
+				lept_free(&v);
+			}
+		}
+}
+
+static void test_parse_backslash_runs()
+{
+	char json[200];
+	size_t i, pad, r;
+	int level, quote;
+	lept_value v1, v2;
+
+	/* runs of escaped backslashes, optionally ending in \", placed across 64-byte blocks */
+	for (pad = 0; pad < 70; pad++)
+		for (r = 0; r < 40; r += 3)
+			for (quote = 0; quote < 2; quote++) {
+				char *p = json;
+				*p++ = '['; *p++ = '\"';
+				for (i = 0; i < pad; i++)
+					*p++ = 'a';
+				for (i = 0; i < r; i++) {
+					*p++ = '\\'; *p++ = '\\';
+				}
+				if (quote) {
+					*p++ = '\\'; *p++ = '\"';
+				}
+				strcpy(p, "\",{\"k\":[1]}]");
+				lept_init(&v1);
+				EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v1, json));
+				EXPECT_EQ_SIZE_T(pad + r + quote, lept_get_string_length(lept_get_array_element(&v1, 0)));
+				for (level = LEPT_SIMD_NONE; level <= LEPT_SIMD_AVX2; level++) {
+					lept_init(&v2);
+					EXPECT_EQ_INT(LEPT_PARSE_OK, parse_under_simd((lept_simd)level, &v2, json));
+					EXPECT_TRUE(lept_is_equal(&v1, &v2));
+					lept_free(&v2);
+				}
+				lept_free(&v1);
+			}
+}
+
+static void test_parse_n()
+{
+	static const char doc[] =
+		"{ \"n\" : null , \"b\" : [ true , false ] , \"i\" : -1234567890123 , \"d\" : 1.25e-3 ,"
+		"  \"s\" : \"abc\\n\\u00A2\\uD834\\uDD1E                                            def\"                                        }  ";
+	char prefix[sizeof(doc)];
+	size_t len;
+	int level;
+	lept_value v1, v2;
+
+	/* every prefix, in a buffer that ends right there, gives what lept_parse gives for it; under
+	   ASan a read past the buffer fails here at every SIMD level */
+	for (len = 0; len < sizeof(doc); len++) {
+		char* buffer = (char*)malloc(len ? len : 1);
+		memcpy(buffer, doc, len);
+		memcpy(prefix, doc, len);
+		prefix[len] = '\0';
+		lept_init(&v1);
+		for (level = LEPT_SIMD_NONE; level <= LEPT_SIMD_AVX2; level++) {
+			lept_simd old = lept_set_simd((lept_simd)level);
+			int ret = lept_parse(&v1, prefix);
+			lept_init(&v2);
+			EXPECT_EQ_INT(ret, lept_parse_n(&v2, buffer, len));
+			EXPECT_TRUE(lept_is_equal(&v1, &v2));
+			lept_free(&v1);
+			lept_free(&v2);
+			lept_set_simd(old);
+		}
+		free(buffer);
+	}
+
+	/* a '\0' inside the bounds is an ordinary byte */
+	lept_init(&v1);
+	EXPECT_EQ_INT(LEPT_PARSE_INVALID_STRING_CHAR, lept_parse_n(&v1, "\"a\0b\"", 5));
+	EXPECT_EQ_INT(LEPT_PARSE_ROOT_NOT_SINGULAR, lept_parse_n(&v1, "[1]\0", 4));
+	EXPECT_EQ_INT(LEPT_PARSE_INVALID_VALUE, lept_parse_n(&v1, "\0", 1));
+	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_n(&v1, "\"a\\u0000b\"", 10));
+	EXPECT_EQ_STRING("a\0b", lept_get_string(&v1), lept_get_string_length(&v1));
+	lept_free(&v1);
+	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_n(&v1, "123456", 3));
+	EXPECT_EQ_DOUBLE(123.0, lept_get_number(&v1));
+	lept_free(&v1);
+}
+
 static void test_parse()
 {
 	test_parse_null();
 	test_parse_true();
 	test_parse_false();
 	test_parse_number();
+	test_parse_number_random();
+	test_parse_int64();
 	test_parse_string();
 	test_parse_array();
 	test_parse_object();
@@ -389,6 +756,10 @@ static void test_parse()
 	test_parse_miss_key();
 	test_parse_miss_colon();
 	test_parse_miss_comma_or_curly_bracket();
+	test_parse_whitespace();
+	test_parse_long_string();
+	test_parse_backslash_runs();
+	test_parse_n();
 }
 
 #define TEST_ROUNDTRIP(json)\
@@ -398,7 +769,7 @@ static void test_parse()
 		char *json2;\
 		size_t length;\
 		lept_init(&v);\
-		EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, json));\
+		EXPECT_EQ_INT(LEPT_PARSE_OK, parse_json(&v, json));\
 		json2 = lept_stringify(&v, &length);\
 		EXPECT_EQ_STRING(json, json2, length);\
 		lept_free(&v);\
@@ -414,19 +785,126 @@ static void test_stringify_number()
 	TEST_ROUNDTRIP("1.5");
 	TEST_ROUNDTRIP("-1.5");
 	TEST_ROUNDTRIP("3.25");
-	// TEST_ROUNDTRIP("1e+20");
-	// TEST_ROUNDTRIP("1.234e+20");
-	// TEST_ROUNDTRIP("1.234e-20");
+	TEST_ROUNDTRIP("1e+20");
+	TEST_ROUNDTRIP("1.234e+20");
+	TEST_ROUNDTRIP("1.234e-20");
+	TEST_ROUNDTRIP("0.1");
+	TEST_ROUNDTRIP("0.0001");
+	TEST_ROUNDTRIP("1e-05");
+	TEST_ROUNDTRIP("1.5e+17");
+	TEST_ROUNDTRIP("12345678901234568");
+
+	TEST_ROUNDTRIP("9007199254740993");
+	TEST_ROUNDTRIP("9223372036854775807");
+	TEST_ROUNDTRIP("-9223372036854775808");
+	TEST_ROUNDTRIP("18446744073709551615");
+	TEST_ROUNDTRIP("[1,-12,123,-1234,12345,-123456,1234567,-12345678,123456789,-1234567890]");
 
 	TEST_ROUNDTRIP("1.0000000000000002"); /* the smallest number > 1 */
-	TEST_ROUNDTRIP("4.9406564584124654e-324"); /* minimum denormal */
-	TEST_ROUNDTRIP("-4.9406564584124654e-324");
-	TEST_ROUNDTRIP("2.2250738585072009e-308");  /* Max subnormal double */
-	TEST_ROUNDTRIP("-2.2250738585072009e-308");
+	TEST_ROUNDTRIP("5e-324"); /* minimum denormal */
+	TEST_ROUNDTRIP("-5e-324");
+	TEST_ROUNDTRIP("1e-323");
+	TEST_ROUNDTRIP("8e-323");
+	TEST_ROUNDTRIP("2.225073858507201e-308");  /* Max subnormal double */
+	TEST_ROUNDTRIP("-2.225073858507201e-308");
 	TEST_ROUNDTRIP("2.2250738585072014e-308");  /* Min normal positive double */
 	TEST_ROUNDTRIP("-2.2250738585072014e-308");
 	TEST_ROUNDTRIP("1.7976931348623157e+308");  /* Max double */
 	TEST_ROUNDTRIP("-1.7976931348623157e+308");
+
+	/* sprintf("%.17g") on request */
+	lept_set_shortest_numbers(0);
+	TEST_ROUNDTRIP("1.5");
+	TEST_ROUNDTRIP("0.10000000000000001");
+	TEST_ROUNDTRIP("4.9406564584124654e-324");
+	TEST_ROUNDTRIP("2.2250738585072009e-308");
+	lept_set_shortest_numbers(1);
+}
+
+// an xorshift64 state for the randomized tests
+static uint64_t random_u64(uint64_t* s)
+{
+	*s ^= *s << 13;
+	*s ^= *s >> 7;
+	*s ^= *s << 17;
+	return *s;
+}
+
+static void check_number_roundtrip(double d)
+{
+	char printf_buffer[32];
+	lept_value v, w;
+	size_t length;
+	char* json;
+	lept_init(&v);
+	lept_init(&w);
+	lept_set_number(&v, d);
+	json = lept_stringify(&v, &length);
+	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&w, json));
+	EXPECT_TRUE(lept_get_number(&w) == d && signbit(lept_get_number(&w)) == signbit(d));
+	EXPECT_TRUE(length <= static_cast<size_t>(sprintf(printf_buffer, "%.17g", d)));
+	lept_free(&w);
+	free(json);
+}
+
+static void test_stringify_number_random()
+{
+	static const double pow10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15 };
+	uint64_t s = 88172645463325252ULL;
+	char expect[32];
+	lept_value v;
+	char* json;
+	double d;
+	/* any bit pattern but infinities and NaNs reads back bit-exactly, never longer than "%.17g" */
+	for (int i = 0; i < 100000; i++)
+	{
+		uint64_t bits = random_u64(&s);
+		memcpy(&d, &bits, sizeof(double));
+		if (d - d == 0)
+			check_number_roundtrip(d);
+	}
+	/* a decimal of up to 6 digits comes out as written, "%.15g" has it too */
+	lept_init(&v);
+	for (int i = 0; i < 100000; i++)
+	{
+		uint64_t r = random_u64(&s);
+		d = static_cast<double>(r % 1000000) / pow10[r >> 60];
+		sprintf(expect, "%.15g", d);
+		lept_set_number(&v, d);
+		json = lept_stringify(&v, NULL);
+		EXPECT_TRUE(strcmp(expect, json) == 0);
+		free(json);
+	}
+	lept_free(&v);
+}
+
+static void test_stringify_number_nonfinite()
+{
+	static const double special[] = { INFINITY, -INFINITY, NAN, -NAN };
+	char expect[32];
+	lept_value v;
+	char* json;
+	/* no json for these, so they print as "%.17g" does in both modes, never as a finite number */
+	lept_init(&v);
+	for (int shortest = 0; shortest <= 1; shortest++)
+	{
+		lept_set_shortest_numbers(shortest);
+		for (int i = 0; i < 4; i++)
+		{
+			sprintf(expect, "%.17g", special[i]);
+			lept_set_number(&v, special[i]);
+			json = lept_stringify(&v, NULL);
+			EXPECT_TRUE(strcmp(expect, json) == 0);
+			free(json);
+		}
+		/* and in a packed array */
+		lept_set_number_array(&v, special, 4);
+		json = lept_stringify(&v, NULL);
+		sprintf(expect, "[%.17g,%.17g,%.17g,%.17g]", special[0], special[1], special[2], special[3]);
+		EXPECT_TRUE(strcmp(expect, json) == 0);
+		free(json);
+	}
+	lept_free(&v);
 }
 
 static void test_stringify_string()
@@ -456,6 +934,8 @@ static void test_stringify()
 	TEST_ROUNDTRIP("false");
 	TEST_ROUNDTRIP("true");
 	test_stringify_number();
+	test_stringify_number_random();
+	test_stringify_number_nonfinite();
 	test_stringify_string();
 	test_stringify_array();
 	test_stringify_object();
@@ -467,8 +947,8 @@ static void test_stringify()
 		lept_value v1, v2; \
 		lept_init(&v1); \
 		lept_init(&v2); \
-		EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v1, json1)); \
-		EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v2, json2)); \
+		EXPECT_EQ_INT(LEPT_PARSE_OK, parse_json(&v1, json1)); \
+		EXPECT_EQ_INT(LEPT_PARSE_OK, parse_json(&v2, json2)); \
 		EXPECT_EQ_INT(equality, lept_is_equal(&v1, &v2)); \
 		lept_free(&v1); \
 		lept_free(&v2); \
@@ -483,6 +963,14 @@ static void test_equal()
 	TEST_EQUAL("null", "0", 0);
 	TEST_EQUAL("123", "123", 1);
 	TEST_EQUAL("123", "456", 0);
+	TEST_EQUAL("123", "123.0", 1);
+	TEST_EQUAL("-5", "-5e0", 1);
+	TEST_EQUAL("0", "-0", 1);
+	TEST_EQUAL("9007199254740993", "9007199254740992.0", 0); /* 2^53 + 1 is not a double */
+	TEST_EQUAL("9007199254740992", "9007199254740992.0", 1);
+	TEST_EQUAL("18446744073709551615", "1.8446744073709552e19", 0); /* 2^64 - 1 vs 2^64 */
+	TEST_EQUAL("9223372036854775808", "9.223372036854775808e18", 1);
+	TEST_EQUAL("0.5", "0", 0);
 	TEST_EQUAL("\"abc\"", "\"abc\"", 1);
 	TEST_EQUAL("\"abc\"", "\"abcd\"", 0);
 	TEST_EQUAL("[]", "[]", 1);
@@ -505,7 +993,7 @@ static void test_copy()
 {
 	lept_value v1, v2;
 	lept_init(&v1);
-	lept_parse(&v1, "{\"t\":true,\"f\":false,\"n\":null,\"d\":1.5,\"a\":[1,2,3]}");
+	parse_json(&v1, "{\"t\":true,\"f\":false,\"n\":null,\"d\":1.5,\"a\":[1,2,3]}");
 	lept_init(&v2);
 	lept_copy(&v2, &v1);
 	EXPECT_TRUE(lept_is_equal(&v2, &v1));
@@ -516,7 +1004,7 @@ static void test_copy()
 static void test_move() {
 	lept_value v1, v2, v3;
 	lept_init(&v1);
-	lept_parse(&v1, "{\"t\":true,\"f\":false,\"n\":null,\"d\":1.5,\"a\":[1,2,3]}");
+	parse_json(&v1, "{\"t\":true,\"f\":false,\"n\":null,\"d\":1.5,\"a\":[1,2,3]}");
 	lept_init(&v2);
 	lept_copy(&v2, &v1);
 	lept_init(&v3);
@@ -542,6 +1030,1387 @@ static void test_swap() {
 }
 
 
+/* walks the tape the way a reader would and checks every value against the tree */
+static int tape_is_equal(const lept_tape* t, size_t pos, const lept_value* v)
+{
+	size_t i, p;
+	if (lept_tape_get_type(t, pos) != lept_get_type(v))
+		return 0;
+	switch (lept_get_type(v)) {
+		case LEPT_NUMBER:
+			return lept_tape_get_number_type(t, pos) == lept_get_number_type(v)
+				&& lept_tape_get_number(t, pos) == lept_get_number(v)
+				&& (lept_get_number_type(v) != LEPT_NUMBER_INT64 || lept_tape_get_int64(t, pos) == lept_get_int64(v))
+				&& (lept_get_number_type(v) != LEPT_NUMBER_UINT64 || lept_tape_get_uint64(t, pos) == lept_get_uint64(v));
+		case LEPT_STRING:
+			return lept_tape_get_string_length(t, pos) == lept_get_string_length(v)
+				&& memcmp(lept_tape_get_string(t, pos), lept_get_string(v), lept_get_string_length(v) + 1) == 0;
+		case LEPT_ARRAY:
+			if (lept_tape_get_array_size(t, pos) != lept_get_array_size(v))
+				return 0;
+			for (i = 0; i < lept_get_array_size(v); i++)
+				if (lept_tape_get_array_element(t, pos, i) != (i ? lept_tape_next(t, p) : pos + 2)
+					|| !tape_is_equal(t, p = lept_tape_get_array_element(t, pos, i), lept_get_array_element(v, i)))
+					return 0;
+			return 1;
+		case LEPT_OBJECT:
+			if (lept_tape_get_object_size(t, pos) != lept_get_object_size(v))
+				return 0;
+			for (i = 0; i < lept_get_object_size(v); i++) {
+				p = lept_tape_get_object_value(t, pos, i);
+				if (lept_tape_get_object_key_length(t, pos, i) != lept_get_object_key_length(v, i)
+					|| memcmp(lept_tape_get_object_key(t, pos, i), lept_get_object_key(v, i), lept_get_object_key_length(v, i)) != 0
+					|| !tape_is_equal(t, p, lept_get_object_value(v, i)))
+					return 0;
+			}
+			return 1;
+		default:
+			return 1;
+	}
+}
+
+static void test_tape()
+{
+	static const char* valid[] = {
+		"null", "false", "true", "0", "-0", "1.5e300", "-9223372036854775808", "18446744073709551615",
+		"\"\"", "\"Hello\\nWorld\"", "\"\\uD834\\uDD1E\\u0000x\"", "[]", "{}", " [ [ ] , [ 0 , [ 1 ] ] ] ",
+		"{\"n\":null,\"f\":false,\"t\":true,\"i\":123,\"s\":\"abc\",\"a\":[1,2,3],\"o\":{\"1\":1,\"2\":2,\"3\":[{}]}}"
+	};
+	static const char* invalid[] = {
+		"", "nul", "[1,]", "[1", "{\"a\":1,}", "{\"a\"}", "{\"a\":1 \"b\":2}", "[\"\\x\"]", "\"abc",
+		"1e309", "[] x", "{1:1}", "[\"\\uD800\"]"
+	};
+	lept_tape t;
+	lept_value v;
+	size_t i, p;
+
+	for (i = 0; i < sizeof(valid) / sizeof(valid[0]); i++) {
+		lept_init(&v);
+		EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, valid[i]));
+		EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_tape(&t, valid[i]));
+		EXPECT_TRUE(tape_is_equal(&t, 0, &v));
+		EXPECT_EQ_SIZE_T(t.size, lept_tape_next(&t, 0));
+		lept_free_tape(&t);
+		lept_free(&v);
+	}
+	for (i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++) {
+		lept_init(&v);
+		EXPECT_EQ_INT(lept_parse(&v, invalid[i]), lept_parse_tape(&t, invalid[i]));
+		EXPECT_TRUE(t.words == NULL && t.strings == NULL);
+		lept_free(&v);
+	}
+
+	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_tape(&t, "{\"a\":[true,{\"b\":\"x\"}],\"c\":-2}"));
+	p = lept_tape_find_object_value(&t, 0, "a", 1);
+	EXPECT_EQ_INT(LEPT_ARRAY, lept_tape_get_type(&t, p));
+	EXPECT_TRUE(lept_tape_get_boolean(&t, lept_tape_get_array_element(&t, p, 0)));
+	p = lept_tape_find_object_value(&t, lept_tape_get_array_element(&t, p, 1), "b", 1);
+	EXPECT_EQ_STRING("x", lept_tape_get_string(&t, p), lept_tape_get_string_length(&t, p));
+	p = lept_tape_find_object_value(&t, 0, "c", 1);
+	EXPECT_TRUE(-2 == lept_tape_get_int64(&t, p));
+	EXPECT_EQ_SIZE_T(LEPT_KEY_NOT_EXIST, lept_tape_find_object_value(&t, 0, "b", 1));
+	lept_free_tape(&t);
+}
+
+static void test_parse_insitu()
+{
+	static const char* jsons[] = {
+		"\"\"", "\"Hello\\nWorld\"", "\"\\\"\\\\\\/\\b\\f\\n\\r\\t\"", "\"\\uD834\\uDD1E\\u20AC x\"", " [ \"a\" , [ \"\\u0024\" ] ] ",
+		"{\"\":\"\",\"a\\tb\":{\"c\":[\"d\",\"\\u00A2\"]},\"e\":\"f\"}", "[1,\"x\"] x", "{\"a\":\"b\\x\"}", "{\"a\":\"b\",\"c\"}"
+	};
+	char buffer[128];
+	lept_value v1, v2;
+	size_t i;
+
+	for (i = 0; i < sizeof(jsons) / sizeof(jsons[0]); i++) {
+		strcpy(buffer, jsons[i]);
+		lept_init(&v1);
+		lept_init(&v2);
+		EXPECT_EQ_INT(lept_parse(&v1, jsons[i]), lept_parse_insitu(&v2, buffer));
+		EXPECT_TRUE(lept_is_equal(&v1, &v2));
+		lept_free(&v1);
+		lept_free(&v2);
+	}
+
+	strcpy(buffer, "{\"k\\u0031\":\"a\\nb\",\"k2\":[\"c\"]}");
+	lept_init(&v1);
+	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_insitu(&v1, buffer));
+	EXPECT_EQ_STRING("k1", lept_get_object_key(&v1, 0), lept_get_object_key_length(&v1, 0));
+	EXPECT_TRUE(lept_get_object_key(&v1, 0) == buffer + 2);
+	EXPECT_EQ_STRING("a\nb", lept_get_string(lept_get_object_value(&v1, 0)), 3);
+	EXPECT_TRUE(lept_get_string(lept_get_object_value(&v1, 0)) == buffer + 12);
+	/* owned and borrowed values mix freely after the parse */
+	lept_set_string(lept_get_object_value(&v1, 0), "x", 1);
+	lept_set_string(lept_set_object_value(&v1, "k3", 2), "y", 1);
+	lept_remove_object_value(&v1, 1);
+	EXPECT_EQ_SIZE_T(2, lept_get_object_size(&v1));
+	EXPECT_EQ_STRING("k3", lept_get_object_key(&v1, 1), lept_get_object_key_length(&v1, 1));
+	lept_free(&v1);
+}
+
+static void test_parse_lazy()
+{
+	const char* json = " { \"a\" : [ 1 , \"]\\\\\\\"\" , { \"}\" : \"\\\"[\" } ] , \"b\" : { \"c\" : \"d\\n\" , \"e\" : [ ] } , \"f\" : true } ";
+	static const char pad[] = "[[[[{{{{]]]]}}}}[[[[{{{{]]]]}}}}[[[[{{{{]]]]}}}}[[[[{{{{]]]]}}}}[[[[{{{{]]]]}}}}";
+	char json2[256];
+	lept_value v1, v2;
+	size_t i;
+
+	lept_init(&v1);
+	lept_init(&v2);
+	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_lazy(&v1, json));
+	EXPECT_EQ_INT(LEPT_OBJECT, lept_get_type(&v1));
+	/* a copy shares the unparsed source and is built on its own */
+	lept_copy(&v2, &v1);
+	EXPECT_EQ_STRING("d\n", lept_get_string(lept_find_object_value(lept_find_object_value(&v1, "b", 1), "c", 1)), 2);
+	EXPECT_EQ_INT(LEPT_ARRAY, lept_get_type(lept_find_object_value(&v1, "a", 1)));
+	EXPECT_EQ_SIZE_T(3, lept_get_array_size(lept_find_object_value(&v2, "a", 1)));
+	EXPECT_EQ_STRING("\"[", lept_get_string(lept_find_object_value(lept_get_array_element(lept_find_object_value(&v2, "a", 1), 2), "}", 1)), 2);
+	EXPECT_TRUE(lept_is_equal(&v1, &v2));
+	/* lazy values can be modified like any other */
+	lept_set_number(lept_pushback_array_element(lept_find_object_value(&v1, "a", 1)), 2.0);
+	lept_set_boolean(lept_set_object_value(lept_find_object_value(&v2, "b", 1), "g", 1), 0);
+	lept_remove_object_value(&v2, 0);
+	lept_free(&v1);
+	lept_free(&v2);
+
+	/* and cleared while still unparsed */
+	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_lazy(&v1, "[1,2,[3]]"));
+	lept_clear_array(&v1);
+	EXPECT_EQ_SIZE_T(0, lept_get_array_size(&v1));
+	lept_free(&v1);
+	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_lazy(&v1, "{\"a\":1,\"b\":[2]}"));
+	lept_clear_object(&v1);
+	EXPECT_EQ_SIZE_T(0, lept_get_object_size(&v1));
+	lept_free(&v1);
+
+	/* skipped strings with escaped quotes and backslashes across the 64-byte blocks of the skip,
+	   under each SIMD level */
+	for (i = 0; i < 3 * 140; i++) {
+		lept_set_simd((lept_simd)(i / 140));
+		sprintf(json2, "[[\"%.*s\\\\\\\"]\"],{\"%.*s\":\"\\\\\"},[]]", (int)(i % 70), pad, (int)(i / 2), pad);
+		lept_init(&v1);
+		lept_init(&v2);
+		EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v1, json2));
+		EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_lazy(&v2, json2));
+		EXPECT_EQ_SIZE_T(3, lept_get_array_size(&v2));
+		EXPECT_TRUE(lept_is_equal(&v1, &v2));
+		lept_free(&v1);
+		lept_free(&v2);
+	}
+	lept_set_simd(LEPT_SIMD_AVX2);
+
+	EXPECT_EQ_INT(LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET, lept_parse_lazy(&v1, "{\"a\":[1,{}}"));
+	EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&v1));
+}
+
+/* feeds json in chunks of the given size, each in a buffer of exactly that size */
+static int parse_in_chunks(lept_parser* p, lept_value* v, const char* json, size_t chunk)
+{
+	size_t i, len = strlen(json), n;
+	for (i = 0; i < len; i += n) {
+		char* buffer;
+		int ret;
+		n = len - i < chunk ? len - i : chunk;
+		buffer = (char*)malloc(n);
+		memcpy(buffer, json + i, n);
+		ret = lept_parser_feed(p, buffer, n);
+		free(buffer);
+		if (ret != LEPT_PARSE_OK && ret != LEPT_PARSE_NEED_MORE)
+			break;
+	}
+	return lept_parser_finish(p, v);
+}
+
+static void test_parser_feed()
+{
+	static const char* jsons[] = {
+		"null", "true", "false", "123", "-1.5e-10", "18446744073709551615", "\"\"", "\"abc\\\\\\\"\\u00A2\\uD834\\uDD1E\"",
+		"  [ ] ", "[1,[2,[3]],{\"a\":{}}]", "{ \"n\" : null , \"s\" : \"x\\ny\" , \"a\" : [ true , 0 , -0.0 ] , \"o\" : { \"k\" : \"v\" } }",
+		"", " ", "nul", "nulx", "truefalse", "?", "+1", "1.", "1e", "1-2", "1e309", "\"abc", "\"\\v\"", "\"\\u12\"",
+		"\"\\uDBFF\"", "\"\x01\"", "[1,]", "[1", "[1 2", "[\"a\", nul]", "{", "{1:1}", "{\"a\"", "{\"a\" 1}", "{\"a\":}",
+		"{\"a\":1", "{\"a\":1,", "{\"a\":1 \"b\"", "{\"a\":1]", "[1} ", "[] x", "1 2", "[\"abc\\", "{\"a\\", "[[[[[[[[]]]]]]]]"
+	};
+	lept_parser* p = lept_parser_create();
+	lept_value v1, v2;
+	size_t i, chunk;
+
+	for (i = 0; i < sizeof(jsons) / sizeof(jsons[0]); i++)
+		for (chunk = 1; chunk <= strlen(jsons[i]) + 1; chunk++) {
+			lept_init(&v1);
+			lept_init(&v2);
+			EXPECT_EQ_INT(lept_parse(&v1, jsons[i]), parse_in_chunks(p, &v2, jsons[i], chunk));
+			EXPECT_TRUE(lept_is_equal(&v1, &v2));
+			lept_free(&v1);
+			lept_free(&v2);
+		}
+
+	EXPECT_EQ_INT(LEPT_PARSE_NEED_MORE, lept_parser_feed(p, "{\"a\":[1,", 8));
+	EXPECT_EQ_INT(LEPT_PARSE_NEED_MORE, lept_parser_feed(p, "2]", 2));
+	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parser_feed(p, "}", 1));
+	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parser_feed(p, " \n", 2));
+	EXPECT_EQ_INT(LEPT_PARSE_ROOT_NOT_SINGULAR, lept_parser_feed(p, "x", 1));
+	EXPECT_EQ_INT(LEPT_PARSE_ROOT_NOT_SINGULAR, lept_parser_finish(p, &v1));
+	EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&v1));
+	/* an unfinished document is dropped by destroy */
+	EXPECT_EQ_INT(LEPT_PARSE_NEED_MORE, lept_parser_feed(p, "[{\"a\":[\"b\",{\"c", 14));
+	lept_parser_destroy(p);
+}
+
+static void test_parser_parse()
+{
+	static const char* jsons[] = {
+		"null", "-1.5e-10", "\"abc\\\\\\\"\\u00A2\\uD834\\uDD1E\"", "[1,[2,[3]],{\"a\":{}}]",
+		"{ \"n\" : null , \"s\" : \"x\\ny\" , \"a\" : [ true , 0 , -0.0 ] , \"o\" : { \"k\" : \"v\" } }",
+		"", "nulx", "\"\\u12\"", "[1,]", "{\"a\" 1}", "{\"a\":1 \"b\"", "[] x", "[[[[[[[[]]]]]]]]"
+	};
+	static const size_t limits[] = { (size_t)-1, 0, 1, 64, 256, 300 };
+	lept_parser* p = lept_parser_create();
+	lept_value v1, v2;
+	char big[1000];
+	size_t i, j;
+
+	/* a long escaped string grows the scratch buffers past the limits */
+	memset(big, 'x', sizeof(big));
+	memcpy(big, "[\"\\n", 4);
+	memcpy(big + sizeof(big) - 3, "\"]", 3);
+	for (j = 0; j < sizeof(limits) / sizeof(limits[0]); j++) {
+		lept_parser_set_scratch_limit(p, limits[j]);
+		for (i = 0; i <= sizeof(jsons) / sizeof(jsons[0]); i++) {
+			const char* json = i < sizeof(jsons) / sizeof(jsons[0]) ? jsons[i] : big;
+			lept_init(&v1);
+			EXPECT_EQ_INT(lept_parse(&v1, json), lept_parser_parse(p, &v2, json, strlen(json)));
+			EXPECT_TRUE(lept_is_equal(&v1, &v2));
+			lept_free(&v1);
+			lept_free(&v2);
+		}
+	}
+
+	/* a document being fed is dropped, feeding works again afterwards */
+	EXPECT_EQ_INT(LEPT_PARSE_NEED_MORE, lept_parser_feed(p, "[{\"a\":[\"b\",{\"c", 14));
+	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parser_parse(p, &v1, "[1]", 3));
+	EXPECT_EQ_SIZE_T(1, lept_get_array_size(&v1));
+	lept_free(&v1);
+	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parser_feed(p, "{}", 2));
+	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parser_finish(p, &v1));
+	EXPECT_EQ_INT(LEPT_OBJECT, lept_get_type(&v1));
+	lept_free(&v1);
+	lept_parser_destroy(p);
+}
+
+/* writes every event to a string; the abort_after-th event returns 0 */
+struct sax_log
+{
+	char text[512];
+	size_t len;
+	int events, abort_after;
+};
+
+static int sax_printf(void* ctx, const char* format, const char* s, size_t n)
+{
+	sax_log* log = (sax_log*)ctx;
+	log->len += sprintf(log->text + log->len, format, (int)n, s);
+	return ++log->events != log->abort_after;
+}
+
+static int sax_null(void* ctx) { return sax_printf(ctx, "null%.*s ", "", 0); }
+static int sax_boolean(void* ctx, int b) { return sax_printf(ctx, "%.*s ", b ? "true" : "false", 5); }
+static int sax_number(void* ctx, double n) { char s[32]; sprintf(s, "%g", n); return sax_printf(ctx, "d:%.*s ", s, strlen(s)); }
+static int sax_int64(void* ctx, int64_t i) { char s[32]; sprintf(s, "%lld", (long long)i); return sax_printf(ctx, "i:%.*s ", s, strlen(s)); }
+static int sax_string(void* ctx, const char* s, size_t len) { return sax_printf(ctx, "\"%.*s\" ", s, len); }
+static int sax_key(void* ctx, const char* k, size_t len) { return sax_printf(ctx, "%.*s: ", k, len); }
+static int sax_start_object(void* ctx) { return sax_printf(ctx, "{%.*s ", "", 0); }
+static int sax_end_object(void* ctx, size_t n) { char s[32]; sprintf(s, "%u", (unsigned)n); return sax_printf(ctx, "}%.*s ", s, strlen(s)); }
+static int sax_start_array(void* ctx) { return sax_printf(ctx, "[%.*s ", "", 0); }
+static int sax_end_array(void* ctx, size_t n) { char s[32]; sprintf(s, "%u", (unsigned)n); return sax_printf(ctx, "]%.*s ", s, strlen(s)); }
+
+static void test_parse_sax()
+{
+	static const lept_handler handler = {
+		sax_null, sax_boolean, sax_number, sax_int64, NULL, sax_string, sax_key,
+		sax_start_object, sax_end_object, sax_start_array, sax_end_array
+	};
+	static const lept_handler strings_only = { NULL, NULL, NULL, NULL, NULL, sax_string, NULL, NULL, NULL, NULL, NULL };
+	const char* json = " { \"a\" : [ null , true , false , 1 , 1.5 , 18446744073709551615 , \"x\\ty\" ] , \"b\" : { } } ";
+	sax_log log;
+
+	log.len = 0; log.events = 0; log.abort_after = -1;
+	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_sax(json, strlen(json), &handler, &log));
+	EXPECT_EQ_STRING("{ a: [ null true false i:1 d:1.5 d:1.84467e+19 \"x\ty\" ]7 b: { }0 }2 ", log.text, log.len);
+
+	log.len = 0; log.events = 0; log.abort_after = -1;
+	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_sax(json, strlen(json), &strings_only, &log));
+	EXPECT_EQ_STRING("\"x\ty\" ", log.text, log.len);
+
+	/* a handler returning 0 stops the parse right there */
+	log.len = 0; log.events = 0; log.abort_after = 5;
+	EXPECT_EQ_INT(LEPT_PARSE_ABORTED, lept_parse_sax(json, strlen(json), &handler, &log));
+	EXPECT_EQ_STRING("{ a: [ null true ", log.text, log.len);
+
+	/* errors are the ones lept_parse reports, the events before them are delivered */
+	log.len = 0; log.events = 0; log.abort_after = -1;
+	EXPECT_EQ_INT(LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET, lept_parse_sax("[1 2]", 5, &handler, &log));
+	EXPECT_EQ_STRING("[ i:1 ", log.text, log.len);
+	EXPECT_EQ_INT(LEPT_PARSE_ROOT_NOT_SINGULAR, lept_parse_sax("[] []", 5, &handler, &log));
+}
+
+/* reads every token into the same text sax_log gets from the matching events */
+static int read_all(lept_reader* r, sax_log* log)
+{
+	lept_token token;
+	char s[32];
+	log->len = 0;
+	while ((token = lept_reader_next(r)) != LEPT_TOKEN_END && token != LEPT_TOKEN_ERROR) {
+		switch (token) {
+		case LEPT_TOKEN_NULL:  log->len += sprintf(log->text + log->len, "null "); break;
+		case LEPT_TOKEN_FALSE: log->len += sprintf(log->text + log->len, "false "); break;
+		case LEPT_TOKEN_TRUE:  log->len += sprintf(log->text + log->len, "true "); break;
+		case LEPT_TOKEN_NUMBER:
+			if (lept_reader_get_number_type(r) == LEPT_NUMBER_INT64)
+				sprintf(s, "i:%lld", (long long)lept_reader_get_int64(r));
+			else
+				sprintf(s, "d:%g", lept_reader_get_number(r));
+			log->len += sprintf(log->text + log->len, "%s ", s);
+			break;
+		case LEPT_TOKEN_STRING:
+			log->len += sprintf(log->text + log->len, "\"%.*s\" ", (int)lept_reader_get_string_length(r), lept_reader_get_string(r));
+			break;
+		case LEPT_TOKEN_KEY:
+			log->len += sprintf(log->text + log->len, "%.*s: ", (int)lept_reader_get_string_length(r), lept_reader_get_string(r));
+			break;
+		case LEPT_TOKEN_START_OBJECT: log->len += sprintf(log->text + log->len, "{ "); break;
+		case LEPT_TOKEN_END_OBJECT:   log->len += sprintf(log->text + log->len, "} "); break;
+		case LEPT_TOKEN_START_ARRAY:  log->len += sprintf(log->text + log->len, "[ "); break;
+		case LEPT_TOKEN_END_ARRAY:    log->len += sprintf(log->text + log->len, "] "); break;
+		default: break;
+		}
+	}
+	return lept_reader_get_error(r);
+}
+
+static void test_reader()
+{
+	static const char* errors[] = {
+		"", " ", "nul", "truefalse", "?", "+1", "1.", "1e309", "\"abc", "\"\\v\"", "\"\\u12\"", "\"\\uDBFF\"",
+		"\"\x01\"", "[1,]", "[1", "[1 2", "[\"a\", nul]", "{", "{1:1}", "{\"a\"", "{\"a\" 1}", "{\"a\":}", "{\"a\":1",
+		"{\"a\":1 \"b\"", "{\"a\":1]", "[1} ", "[] x", "1 2", "[[[]]]"
+	};
+	const char* json = " { \"a\" : [ null , true , false , 1 , 1.5 , \"x\\ty\" ] , \"b\" : { } , \"c\" : 2 } ";
+	lept_reader* r;
+	lept_value v;
+	sax_log log;
+	size_t i;
+
+	r = lept_reader_create(json, strlen(json));
+	EXPECT_EQ_INT(LEPT_PARSE_OK, read_all(r, &log));
+	EXPECT_EQ_STRING("{ a: [ null true false i:1 d:1.5 \"x\ty\" ] b: { } c: i:2 } ", log.text, log.len);
+	/* the end and an error are sticky */
+	EXPECT_EQ_INT(LEPT_TOKEN_END, lept_reader_next(r));
+	lept_reader_destroy(r);
+
+	/* errors are the ones lept_parse reports */
+	for (i = 0; i < sizeof(errors) / sizeof(errors[0]); i++) {
+		lept_init(&v);
+		r = lept_reader_create(errors[i], strlen(errors[i]));
+		EXPECT_EQ_INT(lept_parse(&v, errors[i]), read_all(r, &log));
+		if (lept_reader_get_error(r) != LEPT_PARSE_OK)
+			EXPECT_EQ_INT(LEPT_TOKEN_ERROR, lept_reader_next(r));
+		lept_reader_destroy(r);
+		lept_free(&v);
+	}
+
+	/* skipping a member's value, a container after its start, and a scalar member's value */
+	r = lept_reader_create(json, strlen(json));
+	EXPECT_EQ_INT(LEPT_TOKEN_START_OBJECT, lept_reader_next(r));
+	EXPECT_EQ_INT(LEPT_TOKEN_KEY, lept_reader_next(r));
+	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_reader_skip(r));
+	EXPECT_EQ_INT(LEPT_TOKEN_KEY, lept_reader_next(r));
+	EXPECT_EQ_STRING("b", lept_reader_get_string(r), lept_reader_get_string_length(r));
+	EXPECT_EQ_INT(LEPT_TOKEN_START_OBJECT, lept_reader_next(r));
+	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_reader_skip(r));
+	EXPECT_EQ_INT(LEPT_TOKEN_KEY, lept_reader_next(r));
+	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_reader_skip(r));
+	EXPECT_EQ_DOUBLE(2.0, lept_reader_get_number(r));
+	EXPECT_EQ_INT(LEPT_TOKEN_END_OBJECT, lept_reader_next(r));
+	EXPECT_EQ_INT(LEPT_TOKEN_END, lept_reader_next(r));
+	lept_reader_destroy(r);
+
+	/* a skipped subtree is still checked */
+	r = lept_reader_create("[[1,{\"a\":[2 3]}],4]", 19);
+	EXPECT_EQ_INT(LEPT_TOKEN_START_ARRAY, lept_reader_next(r));
+	EXPECT_EQ_INT(LEPT_TOKEN_START_ARRAY, lept_reader_next(r));
+	EXPECT_EQ_INT(LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET, lept_reader_skip(r));
+	lept_reader_destroy(r);
+
+	r = lept_reader_create("[[1,{\"a\":[2,3]}],4]", 19);
+	EXPECT_EQ_INT(LEPT_TOKEN_START_ARRAY, lept_reader_next(r));
+	EXPECT_EQ_INT(LEPT_TOKEN_START_ARRAY, lept_reader_next(r));
+	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_reader_skip(r));
+	EXPECT_EQ_INT(LEPT_TOKEN_NUMBER, lept_reader_next(r));
+	EXPECT_EQ_DOUBLE(4.0, lept_reader_get_number(r));
+	EXPECT_EQ_INT(LEPT_TOKEN_END_ARRAY, lept_reader_next(r));
+	EXPECT_EQ_INT(LEPT_TOKEN_END, lept_reader_next(r));
+	lept_reader_destroy(r);
+}
+
+static int parse_with_reader(const char* json)
+{
+	lept_reader* r = lept_reader_create(json, strlen(json));
+	int ret;
+	while (lept_reader_next(r) > LEPT_TOKEN_ERROR)
+		;
+	ret = lept_reader_get_error(r);
+	lept_reader_destroy(r);
+	return ret;
+}
+
+static int parse_with_tape(const char* json)
+{
+	lept_tape t;
+	int ret = lept_parse_tape(&t, json);
+	if (ret == LEPT_PARSE_OK)
+		lept_free_tape(&t);
+	return ret;
+}
+
+/* every parser, through the value it builds if any */
+static int parse_with_each(int which, const char* json)
+{
+	static const lept_handler none = { NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL };
+	lept_parser* p;
+	lept_value v;
+	int ret;
+	lept_init(&v);
+	switch (which) {
+	case 0: ret = lept_parse(&v, json); break;
+	case 1: ret = lept_parse_indexed(&v, json); break;
+	case 2: ret = lept_parse_lazy(&v, json); break;
+	case 3:
+		p = lept_parser_create();
+		lept_parser_feed(p, json, strlen(json));
+		ret = lept_parser_finish(p, &v);
+		lept_parser_destroy(p);
+		break;
+	case 4: ret = lept_parse_sax(json, strlen(json), &none, NULL); break;
+	case 5: ret = parse_with_reader(json); break;
+	default: ret = parse_with_tape(json); break;
+	}
+	lept_free(&v);
+	return ret;
+}
+
+static void test_parse_depth()
+{
+	static const lept_handler none = { NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL };
+	size_t old = lept_get_max_depth(), n = 1000000, i;
+	char *json, *s;
+	lept_value v, w;
+	int which;
+
+	EXPECT_EQ_SIZE_T(1024, old);
+	for (which = 0; which < 7; which++) {
+		lept_set_max_depth(3);
+		EXPECT_EQ_INT(LEPT_PARSE_OK, parse_with_each(which, "[[[1]]]"));
+		EXPECT_EQ_INT(LEPT_PARSE_OK, parse_with_each(which, "[[],[[]],{\"a\":[]},[[\"[[[[\"]]]"));
+		EXPECT_EQ_INT(LEPT_PARSE_TOO_DEEP, parse_with_each(which, "[[[[1]]]]"));
+		EXPECT_EQ_INT(LEPT_PARSE_TOO_DEEP, parse_with_each(which, "{\"a\":{\"b\":[{}]}}"));
+		EXPECT_EQ_INT(LEPT_PARSE_TOO_DEEP, parse_with_each(which, "[1,[2,[3,[]"));
+		lept_set_max_depth(0);
+		EXPECT_EQ_INT(LEPT_PARSE_OK, parse_with_each(which, " 1 "));
+		EXPECT_EQ_INT(LEPT_PARSE_TOO_DEEP, parse_with_each(which, "[]"));
+		lept_set_max_depth(old);
+	}
+
+	/* nesting only costs heap, not call stack: a million levels with the limit raised */
+	json = (char*)malloc(2 * n + 1);
+	for (i = 0; i < n; i++) {
+		json[i] = '[';
+		json[2 * n - 1 - i] = ']';
+	}
+	json[2 * n] = '\0';
+	EXPECT_EQ_INT(LEPT_PARSE_TOO_DEEP, lept_parse_sax(json, 2 * n, &none, NULL));
+	lept_set_max_depth(n);
+	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_sax(json, 2 * n, &none, NULL));
+	EXPECT_EQ_INT(LEPT_PARSE_OK, parse_with_reader(json));
+
+	/* trees are freed, copied, compared and written recursively, so the parsers that build one
+	   stop at 2048 levels whatever the limit says */
+	for (which = 0; which < 7; which++)
+		if (which != 4 && which != 5)
+			EXPECT_EQ_INT(LEPT_PARSE_TOO_DEEP, parse_with_each(which, json));
+	lept_init(&v);
+	EXPECT_EQ_INT(LEPT_PARSE_TOO_DEEP, lept_parse_parallel(&v, json, 2 * n, 4));
+	n = 2048;
+	memmove(json + n, json + 2 * 1000000 - n, n + 1);
+	for (which = 0; which < 7; which++)
+		EXPECT_EQ_INT(LEPT_PARSE_OK, parse_with_each(which, json));
+	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, json));
+	lept_init(&w);
+	lept_copy(&w, &v);
+	EXPECT_TRUE(lept_is_equal(&v, &w));
+	s = lept_stringify(&w, NULL);
+	EXPECT_TRUE(strcmp(json, s) == 0);
+	free(s);
+	s = lept_stringify_parallel(&w, NULL, 2);
+	EXPECT_TRUE(strcmp(json, s) == 0);
+	free(s);
+	lept_free(&v);
+	lept_free(&w);
+	memmove(json + n + 1, json + n, n + 1);
+	json[n] = '[';
+	json[2 * n + 1] = ']';
+	json[2 * n + 2] = '\0';
+	for (which = 0; which < 7; which++)
+		EXPECT_EQ_INT(which == 4 || which == 5 ? LEPT_PARSE_OK : LEPT_PARSE_TOO_DEEP, parse_with_each(which, json));
+	lept_set_max_depth(old);
+	free(json);
+}
+
+static void test_document()
+{
+	const char* json = "{\"n\":null,\"t\":true,\"d\":1.5,\"s\":\"a\\nb\",\"a\":[1,\"x\",[],{}],\"o\":{\"k\":[2]}}";
+	lept_document* d = lept_document_create();
+	lept_document* d2 = lept_document_create();
+	lept_value v, h, *root, *a, *e;
+	char* s;
+	size_t i;
+
+	lept_init(&v);
+	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, json));
+	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_document(d, json));
+	root = lept_document_get_root(d);
+	EXPECT_TRUE(lept_is_equal(&v, root));
+	s = lept_stringify(root, NULL);
+	EXPECT_TRUE(strcmp(json, s) == 0);
+	free(s);
+
+	/* the usual functions grow the values inside the arena */
+	a = lept_find_object_value(root, "a", 1);
+	for (i = 0; i < 1000; i++)
+		lept_set_string(lept_pushback_array_element(a), "grow", 4);
+	lept_set_number(lept_insert_array_element(a, 0), 0.0);
+	lept_erase_array_element(a, 5, 900);
+	lept_popback_array_element(a);
+	EXPECT_EQ_SIZE_T(104, lept_get_array_size(a));
+	lept_shrink_array(a);
+	EXPECT_EQ_SIZE_T(104, lept_get_array_capacity(a));
+	EXPECT_EQ_STRING("x", lept_get_string(lept_get_array_element(a, 2)), 1);
+	EXPECT_EQ_STRING("grow", lept_get_string(lept_get_array_element(a, 103)), 4);
+	for (i = 0; i < 100; i++) {
+		char key[8];
+		sprintf(key, "k%u", (unsigned)i);
+		lept_set_array(lept_set_object_value(root, key, strlen(key)), 0);
+	}
+	lept_remove_object_value(root, lept_find_object_index(root, "k0", 2));
+	EXPECT_EQ_SIZE_T(105, lept_get_object_size(root));
+	e = lept_find_object_value(root, "k99", 3);
+	lept_set_object(lept_pushback_array_element(e), 0);
+	lept_set_string(lept_set_object_value(lept_get_array_element(e, 0), "deep", 4), "value", 5);
+	lept_clear_object(lept_find_object_value(root, "o", 1));
+	lept_shrink_object(root);
+	/* lept_free only makes a value null, it stays in the document */
+	lept_free(lept_find_object_value(root, "s", 1));
+	lept_set_string(lept_find_object_value(root, "s", 1), "again", 5);
+
+	/* values cross between the heap, the document and another document by copy */
+	lept_init(&h);
+	lept_move(&h, lept_find_object_value(root, "o", 1));
+	EXPECT_EQ_INT(LEPT_OBJECT, lept_get_type(&h));
+	EXPECT_EQ_INT(LEPT_NULL, lept_get_type(lept_find_object_value(root, "o", 1)));
+	lept_move(lept_find_object_value(root, "n", 1), &v);
+	EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&v));
+	lept_swap(&h, lept_find_object_value(root, "d", 1));
+	EXPECT_EQ_DOUBLE(1.5, lept_get_number(&h));
+	lept_copy(&v, root);
+	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_document(d2, "[]"));
+	lept_copy(lept_pushback_array_element(lept_document_get_root(d2)), lept_find_object_value(root, "n", 1));
+	lept_move(lept_pushback_array_element(lept_document_get_root(d2)), lept_find_object_value(root, "t", 1));
+
+	/* everything above is released at once, the heap copies stay valid */
+	lept_document_reset(d);
+	EXPECT_EQ_INT(LEPT_NULL, lept_get_type(lept_document_get_root(d)));
+	EXPECT_EQ_INT(LEPT_OBJECT, lept_get_type(&v));
+	EXPECT_EQ_STRING("value", lept_get_string(lept_find_object_value(lept_get_array_element(lept_find_object_value(&v, "k99", 3), 0), "deep", 4)), 5);
+	EXPECT_TRUE(lept_is_equal(lept_find_object_value(&v, "n", 1), lept_get_array_element(lept_document_get_root(d2), 0)));
+	EXPECT_EQ_INT(LEPT_TRUE, lept_get_type(lept_get_array_element(lept_document_get_root(d2), 1)));
+	EXPECT_EQ_INT(LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET, lept_parse_document(d, "[\"a\",{\"b\":[1}]"));
+	EXPECT_EQ_INT(LEPT_NULL, lept_get_type(lept_document_get_root(d)));
+	lept_free(&v);
+	lept_free(&h);
+
+	/* a lazy value copied in is built first, an arena holds no unparsed source */
+	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_lazy(&v, "[1,2,[3]]"));
+	lept_copy(lept_document_get_root(d), &v);
+	EXPECT_EQ_SIZE_T(3, lept_get_array_size(lept_document_get_root(d)));
+	EXPECT_TRUE(lept_is_equal(&v, lept_document_get_root(d)));
+	lept_free(&v);
+	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_lazy(&v, "{\"a\":[1],\"b\":{\"c\":\"d\"}}"));
+	lept_copy(lept_pushback_array_element(lept_document_get_root(d2)), &v);
+	lept_free(&v);
+	EXPECT_EQ_STRING("d", lept_get_string(lept_find_object_value(lept_find_object_value(lept_get_array_element(lept_document_get_root(d2), 2), "b", 1), "c", 1)), 1);
+	lept_document_destroy(d);
+	lept_document_destroy(d2);
+}
+
+static void test_intern_keys()
+{
+	const char* json = "[{\"id\":1,\"ts\":\"a\",\"value\":{\"id\":2}},{\"value\":[],\"id\":3,\"ts\":\"b\"},{\"id\":4}]";
+	lept_document* d = lept_document_create();
+	lept_document* copied = lept_document_create();
+	lept_value v, *root, *r0, *r1, *r2;
+	int pass;
+
+	lept_init(&v);
+	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, json));
+	lept_document_set_intern_keys(d, 1);
+	for (pass = 0; pass < 2; pass++)  /* the second parse reuses the arena and starts a new table */
+	{
+		EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_document(d, json));
+		root = lept_document_get_root(d);
+		EXPECT_TRUE(lept_is_equal(&v, root));
+		r0 = lept_get_array_element(root, 0);
+		r1 = lept_get_array_element(root, 1);
+		r2 = lept_get_array_element(root, 2);
+		EXPECT_TRUE(lept_get_object_key(r0, 0) == lept_get_object_key(r1, 1));
+		EXPECT_TRUE(lept_get_object_key(r0, 0) == lept_get_object_key(r2, 0));
+		EXPECT_TRUE(lept_get_object_key(r0, 0) == lept_get_object_key(lept_get_object_value(r0, 2), 0));
+		EXPECT_TRUE(lept_get_object_key(r0, 1) == lept_get_object_key(r1, 2));
+		EXPECT_TRUE(lept_get_object_key(r0, 2) == lept_get_object_key(r1, 0));
+		EXPECT_EQ_STRING("value", lept_get_object_key(r1, 0), lept_get_object_key_length(r1, 0));
+	}
+
+	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_document(copied, json));
+	EXPECT_TRUE(lept_document_get_used(d) < lept_document_get_used(copied));
+	lept_document_destroy(copied);
+
+	/* members added later share the keys too, and removing one leaves the others alone */
+	lept_set_number(lept_set_object_value(r2, "ts", 2), 5.0);
+	EXPECT_TRUE(lept_get_object_key(r2, 1) == lept_get_object_key(r0, 1));
+	lept_remove_object_value(r0, 1);
+	lept_clear_object(r1);
+	EXPECT_EQ_STRING("ts", lept_get_object_key(r2, 1), 2);
+
+	/* a copy out of the document owns its keys */
+	lept_copy(&v, r2);
+	EXPECT_TRUE(lept_get_object_key(&v, 0) != lept_get_object_key(r2, 0));
+	EXPECT_EQ_INT(LEPT_PARSE_MISS_COLON, lept_parse_document(d, "[{\"id\":1},{\"id\" 2}]"));
+	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_document(d, "{\"id\":{\"id\":null}}"));
+	root = lept_document_get_root(d);
+	EXPECT_TRUE(lept_get_object_key(root, 0) == lept_get_object_key(lept_get_object_value(root, 0), 0));
+	EXPECT_TRUE(lept_is_equal(lept_find_object_value(&v, "id", 2), lept_get_object_value(lept_get_object_value(root, 0), 0)) == 0);
+	lept_free(&v);
+	lept_document_destroy(d);
+}
+
+struct counting_allocator
+{
+	size_t live, calls;
+};
+
+static void* counting_malloc(void* ctx, size_t size)
+{
+	counting_allocator* a = static_cast<counting_allocator*>(ctx);
+	a->live++;
+	a->calls++;
+	return malloc(size);
+}
+
+static void* counting_realloc(void* ctx, void* p, size_t size)
+{
+	counting_allocator* a = static_cast<counting_allocator*>(ctx);
+	if (p == NULL)
+		a->live++;
+	a->calls++;
+	return realloc(p, size);
+}
+
+static void counting_free(void* ctx, void* p)
+{
+	counting_allocator* a = static_cast<counting_allocator*>(ctx);
+	if (p != NULL)
+		a->live--;
+	a->calls++;
+	free(p);
+}
+
+static void test_allocator()
+{
+	const char* json = "{\"a\":[1,2.5,\"x\\ty\",[],{\"k\":null}],\"b\":{\"c\":[true,false]},\"s\":\"str\"}";
+	counting_allocator count = {0, 0};
+	lept_allocator a = {counting_malloc, counting_realloc, counting_free, &count};
+	lept_value v, w;
+	lept_tape t;
+	lept_parser* p;
+	lept_reader* r;
+	lept_document* d;
+	char* s;
+
+	lept_set_allocator(&a);
+	EXPECT_TRUE(lept_get_allocator()->ctx == &count);
+	lept_init(&v);
+	lept_init(&w);
+	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, json));
+	lept_copy(&w, &v);
+	lept_set_string(lept_pushback_array_element(lept_find_object_value(&w, "a", 1)), "more", 4);
+	lept_set_object_value(&w, "new", 3);
+	s = lept_stringify(&v, NULL);
+	EXPECT_TRUE(strcmp(json, s) == 0);
+	lept_get_allocator()->free_fn(lept_get_allocator()->ctx, s);
+	lept_free(&w);
+	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_lazy(&w, json));
+	EXPECT_TRUE(lept_is_equal(&v, &w));
+	lept_free(&w);
+	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_indexed(&w, json));
+	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_tape(&t, json));
+	lept_free_tape(&t);
+	p = lept_parser_create();
+	lept_free(&w);
+	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parser_parse(p, &w, json, strlen(json)));
+	lept_parser_destroy(p);
+	r = lept_reader_create(json, strlen(json));
+	while (lept_reader_next(r) != LEPT_TOKEN_END)
+		;
+	lept_reader_destroy(r);
+	d = lept_document_create();
+	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_document(d, json));
+	lept_copy(&w, lept_document_get_root(d));
+	lept_document_destroy(d);
+	lept_free(&v);
+	lept_free(&w);
+	lept_set_allocator(NULL);
+
+	/* everything went through the hooks, and all of it came back */
+	EXPECT_TRUE(count.calls > 0);
+	EXPECT_EQ_SIZE_T(0, count.live);
+	EXPECT_TRUE(lept_get_allocator()->ctx == NULL);
+}
+
+static void test_parse_indexed_invalid()
+{
+	/* the indexed engine fails first and tears down what it built, then lept_parse reports the error:
+	   every allocation comes back, and more were made than lept_parse alone makes */
+	static const char* invalid[] = {
+		"[1,2,[3,4,\"abc\",{\"k\":[true,x]}]]",
+		"{\"a\":\"long enough to need its own buffer\",\"b\":[1,2],\"c\":{\"d\":nul}}",
+		"{\"a\":[{\"b\":1},{\"c\":2}],\"d\" 1}",
+		"{\"a\":{\"b\":[1,2,3],\"c\":\"x\"},1:2}",
+		"[{\"a\":1},{\"b\":[\"s\",\"t\"]} 3]",
+		"{\"a\":[1,2,3],\"b\":{\"c\":[4,5,6]}}}",
+		"[[[[\"deep\",[1,2,3]],{\"x\":[]}],\"\\u12\"]]"
+	};
+	for (size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++)
+	{
+		counting_allocator plain = {0, 0}, indexed = {0, 0};
+		lept_allocator a = {counting_malloc, counting_realloc, counting_free, &plain};
+		lept_value v;
+		int ret;
+		lept_init(&v);
+		lept_set_allocator(&a);
+		ret = lept_parse(&v, invalid[i]);
+		a.ctx = &indexed;
+		lept_set_allocator(&a);
+		EXPECT_EQ_INT(ret, lept_parse_indexed(&v, invalid[i]));
+		lept_set_allocator(NULL);
+		EXPECT_TRUE(ret != LEPT_PARSE_OK);
+		EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&v));
+		EXPECT_EQ_SIZE_T(0, plain.live);
+		EXPECT_EQ_SIZE_T(0, indexed.live);
+		EXPECT_TRUE(indexed.calls > plain.calls);
+	}
+}
+
+static void test_inline_string()
+{
+	static const char* text = "0123456789abcdefghijklmnopqrstuvwxyz";
+	counting_allocator count = {0, 0};
+	lept_allocator a = {counting_malloc, counting_realloc, counting_free, &count};
+	lept_value v, w, o;
+	size_t len;
+
+	/* every length around the in-place limit, and a change of storage in both directions */
+	lept_init(&v);
+	lept_init(&w);
+	for (len = 0; len <= 36; len++)
+	{
+		lept_set_string(&v, text, len);
+		EXPECT_EQ_SIZE_T(len, lept_get_string_length(&v));
+		EXPECT_TRUE(memcmp(text, lept_get_string(&v), len) == 0 && lept_get_string(&v)[len] == '\0');
+		lept_copy(&w, &v);
+		EXPECT_TRUE(lept_is_equal(&v, &w));
+		lept_set_string(&v, text, 36 - len);
+		lept_swap(&v, &w);
+		EXPECT_EQ_SIZE_T(len, lept_get_string_length(&v));
+		EXPECT_EQ_SIZE_T(36 - len, lept_get_string_length(&w));
+		EXPECT_TRUE(memcmp(text, lept_get_string(&w), 36 - len) == 0);
+	}
+	lept_move(&w, &v);
+	EXPECT_EQ_STRING("0123456789abcdefghijklmnopqrstuvwxyz", lept_get_string(&w), lept_get_string_length(&w));
+	lept_free(&w);
+
+	/* short values and keys, the keys still get their own buffers */
+	lept_init(&o);
+	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&o, "{\"id\":\"a1\",\"tag\":[\"x\",\"\",\"yz\"],\"k\":{\"s\":\"ok\"}}"));
+	EXPECT_EQ_STRING("a1", lept_get_string(lept_find_object_value(&o, "id", 2)), 2);
+	EXPECT_EQ_STRING("yz", lept_get_string(lept_get_array_element(lept_find_object_value(&o, "tag", 3), 2)), 2);
+	EXPECT_EQ_STRING("ok", lept_get_string(lept_find_object_value(lept_find_object_value(&o, "k", 1), "s", 1)), 2);
+	lept_free(&o);
+
+	/* which costs no allocation */
+	lept_set_allocator(&a);
+	lept_set_string(&v, "status", 6);
+	lept_set_string(&v, text, 36);
+	lept_set_string(&v, "ok", 2);
+	EXPECT_EQ_SIZE_T(0, count.live);
+	lept_free(&v);
+	lept_set_allocator(NULL);
+	EXPECT_EQ_SIZE_T(2, count.calls);  // the long string's malloc and free
+}
+
+static void check_object_index(lept_value* o)
+{
+	char key[16], order[2000];  /* order[i]: whether key i is in o */
+	size_t expect = 0, i, j;
+	unsigned seed = 1;
+	memset(order, 0, sizeof(order));
+	for (i = 0; i < 20000; i++)
+	{
+		size_t n;
+		seed = seed * 1103515245 + 12345;
+		n = (seed >> 8) % 2000;
+		sprintf(key, "key%u", (unsigned)n);
+		if ((seed >> 20) % 3 != 0)
+		{
+			if (!order[n])
+				expect++;
+			order[n] = 1;
+			lept_set_number(lept_set_object_value(o, key, strlen(key)), (double)n);
+		}
+		else if (order[n])
+		{
+			order[n] = 0;
+			expect--;
+			lept_remove_object_value(o, lept_find_object_index(o, key, strlen(key)));
+		}
+		else
+			EXPECT_EQ_SIZE_T(LEPT_KEY_NOT_EXIST, lept_find_object_index(o, key, strlen(key)));
+	}
+	EXPECT_EQ_SIZE_T(expect, lept_get_object_size(o));
+	for (i = 0; i < 2000; i++)
+	{
+		sprintf(key, "key%u", (unsigned)i);
+		j = lept_find_object_index(o, key, strlen(key));
+		if (order[i])
+		{
+			EXPECT_TRUE(j != LEPT_KEY_NOT_EXIST);
+			if (j != LEPT_KEY_NOT_EXIST)
+				EXPECT_EQ_DOUBLE((double)i, lept_get_number(lept_get_object_value(o, j)));
+		}
+		else
+			EXPECT_EQ_SIZE_T(LEPT_KEY_NOT_EXIST, j);
+	}
+}
+
+static void test_object_index()
+{
+	lept_document* d = lept_document_create();
+	lept_value o, p;
+	size_t i;
+	char key[16];
+
+	/* lookups, insertions and removals over an object that keeps growing and shrinking */
+	lept_init(&o);
+	lept_set_object(&o, 0);
+	check_object_index(&o);
+	lept_set_object(lept_document_get_root(d), 0);
+	check_object_index(lept_document_get_root(d));
+	EXPECT_TRUE(lept_is_equal(&o, lept_document_get_root(d)));
+
+	/* insertion order is kept, whatever the index does */
+	lept_set_object(&o, 0);
+	for (i = 0; i < 100; i++)
+	{
+		sprintf(key, "%u", (unsigned)(99 - i));
+		lept_set_number(lept_set_object_value(&o, key, strlen(key)), (double)i);
+	}
+	lept_remove_object_value(&o, 0);
+	lept_remove_object_value(&o, 50);
+	EXPECT_EQ_STRING("98", lept_get_object_key(&o, 0), 2);
+	EXPECT_EQ_STRING("47", lept_get_object_key(&o, 50), 2);
+	EXPECT_EQ_SIZE_T(50, lept_find_object_index(&o, "47", 2));
+	EXPECT_EQ_SIZE_T(LEPT_KEY_NOT_EXIST, lept_find_object_index(&o, "48", 2));
+	EXPECT_EQ_SIZE_T(97, lept_find_object_index(&o, "0", 1));
+
+	/* a copy in another order is equal, and the index survives moves, shrinking and clearing */
+	lept_init(&p);
+	lept_set_object(&p, 0);
+	for (i = lept_get_object_size(&o); i-- > 0; )
+		lept_copy(lept_set_object_value(&p, lept_get_object_key(&o, i), lept_get_object_key_length(&o, i)), lept_get_object_value(&o, i));
+	EXPECT_TRUE(lept_is_equal(&o, &p));
+	lept_move(lept_document_get_root(d), &p);
+	EXPECT_TRUE(lept_is_equal(&o, lept_document_get_root(d)));
+	lept_shrink_object(&o);
+	EXPECT_EQ_SIZE_T(97, lept_find_object_index(&o, "0", 1));
+	for (i = 0; i < 90; i++)
+		lept_remove_object_value(&o, 0);
+	lept_shrink_object(&o);
+	EXPECT_EQ_SIZE_T(7, lept_find_object_index(&o, "0", 1));
+	lept_clear_object(lept_document_get_root(d));
+	EXPECT_EQ_SIZE_T(LEPT_KEY_NOT_EXIST, lept_find_object_index(lept_document_get_root(d), "0", 1));
+	lept_free(&o);
+	lept_free(&p);
+	lept_document_destroy(d);
+
+	/* parsed objects come with their index and lookups only read it, so threads may look up and
+	   compare through const pointers at the same time (run under TSan to see it) */
+	{
+		const char* parsed = "{\"k0\":0,\"k1\":1,\"k2\":2,\"k3\":3,\"k4\":4,\"k5\":5,\"k6\":6,\"k7\":7,\"k8\":8,"
+			"\"k9\":9,\"k10\":10,\"k11\":11,\"k12\":12,\"k13\":13,\"k14\":14,\"k15\":15,\"k16\":16,\"k17\":17}";
+		int (*parsers[])(lept_value*, const char*) = { lept_parse, lept_parse_indexed };
+		for (i = 0; i < 2; i++)
+		{
+			lept_value q;
+			size_t found[2] = { 0, 0 };
+			std::thread t[2];
+			lept_init(&o);
+			lept_init(&q);
+			EXPECT_EQ_INT(LEPT_PARSE_OK, parsers[i](&o, parsed));
+			EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&q, parsed));
+			for (int k = 0; k < 2; k++)
+				t[k] = std::thread([&o, &q, &found, k]() {
+					const lept_value* c = &o;
+					char name[8];
+					for (unsigned j = 0; j < 18; j++)
+					{
+						sprintf(name, "k%u", j);
+						found[k] += lept_find_object_index(c, name, strlen(name)) == j;
+					}
+					found[k] += lept_is_equal(c, &q);
+				});
+			for (int k = 0; k < 2; k++)
+				t[k].join();
+			EXPECT_EQ_SIZE_T(19, found[0]);
+			EXPECT_EQ_SIZE_T(19, found[1]);
+			lept_free(&o);
+			lept_free(&q);
+		}
+	}
+}
+
+static void test_packed_array()
+{
+	const char* json = "[0.5,1.5,2.5,3.5,4.5,5.5,6.5,7.5,8.5,9.5,10.5,11.5,12.5,13.5,14.5,15.5,-9.5367431640625e-07,1048576.25]";
+	static const double more[] = { 1.25, -2.5, 1e10 };
+	lept_document* d = lept_document_create();
+	lept_parser* p;
+	counting_allocator count = {0, 0};
+	lept_allocator a = {counting_malloc, counting_realloc, counting_free, &count};
+	lept_value v, w, *e;
+	const lept_value* c;
+	double* data;
+	size_t n;
+	char* s;
+
+	/* the parsers pack by default. Element pointers read through a const pointer come from one view
+	   made next to the numbers, which the array goes on with once it is changed */
+	lept_init(&v);
+	lept_init(&w);
+	EXPECT_TRUE(lept_get_pack_numbers());
+	lept_set_allocator(&a);
+	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, json));
+	count.calls = 0;
+	c = &v;
+	EXPECT_EQ_DOUBLE(1.5, lept_get_number(lept_get_array_element(c, 1)));
+	EXPECT_EQ_DOUBLE(15.5, lept_get_number(lept_get_array_element(c, 15)));
+	EXPECT_TRUE(lept_get_array_element(c, 2) == lept_get_array_element(c, 0) + 2);
+	EXPECT_EQ_SIZE_T(1, count.calls);
+	lept_set_string(lept_get_array_element(&v, 2), "x", 1);
+	lept_set_allocator(NULL);
+	s = lept_stringify(c, NULL);
+	EXPECT_TRUE(strncmp("[0.5,1.5,\"x\",3.5,", s, 15) == 0);
+	free(s);
+	lept_set_allocator(&a);
+	lept_copy(&w, c);
+	EXPECT_TRUE(lept_is_equal(&w, c));
+	lept_free(&w);
+	EXPECT_EQ_SIZE_T(18, lept_get_array_size(c));
+	lept_popback_array_element(&v);
+	EXPECT_EQ_STRING("x", lept_get_string(lept_get_array_element(&v, 2)), 1);
+	EXPECT_FALSE(lept_get_number_array(&v, &data, &n));
+	lept_free(&v);
+	lept_set_allocator(NULL);
+	EXPECT_EQ_SIZE_T(0, count.live);
+
+	/* and not once turned off, so reading an element allocates nothing */
+	lept_set_pack_numbers(0);
+	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, json));
+	lept_set_pack_numbers(1);
+	count.calls = 0;
+	lept_set_allocator(&a);
+	EXPECT_EQ_DOUBLE(1.5, lept_get_number(lept_get_array_element(c, 1)));
+	lept_set_allocator(NULL);
+	EXPECT_EQ_SIZE_T(0, count.calls);
+	lept_free(&v);
+
+	/* threads reading one packed array through const pointers, element by element and as a whole,
+	   read its numbers or its view (run under TSan to see it) */
+	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, json));
+	{
+		int ok[4] = { 0, 0, 0, 0 };
+		std::thread t[4];
+		for (int k = 0; k < 4; k++)
+			t[k] = std::thread([c, json, &ok, k]() {
+				for (int j = 0; j < 20; j++)
+				{
+					if (k % 2 == 0)
+						ok[k] += lept_get_number(lept_get_array_element(c, (j + k) % 16)) == (j + k) % 16 + 0.5;
+					else
+					{
+						char* text = lept_stringify(c, NULL);
+						ok[k] += strcmp(json, text) == 0;
+						free(text);
+					}
+				}
+			});
+		for (int k = 0; k < 4; k++)
+			t[k].join();
+		for (int k = 0; k < 4; k++)
+			EXPECT_EQ_INT(20, ok[k]);
+	}
+	lept_free(&v);
+
+	/* every parser packs an array of doubles, and it prints the same */
+	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, json));
+	EXPECT_TRUE(lept_get_number_array(&v, &data, &n));
+	EXPECT_EQ_SIZE_T(18, n);
+	EXPECT_EQ_DOUBLE(-9.5367431640625e-07, data[16]);
+	s = lept_stringify(&v, NULL);
+	EXPECT_TRUE(strcmp(json, s) == 0);
+	free(s);
+	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_indexed(&w, json));
+	EXPECT_TRUE(lept_get_number_array(&w, &data, &n));
+	EXPECT_TRUE(lept_is_equal(&v, &w));
+	lept_free(&w);
+	p = lept_parser_create();
+	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parser_parse(p, &w, json, strlen(json)));
+	lept_parser_destroy(p);
+	EXPECT_TRUE(lept_get_number_array(&w, &data, &n));
+	EXPECT_TRUE(lept_is_equal(&v, &w));
+	lept_free(&w);
+	lept_init(&w);
+	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_lazy(&w, json));
+	EXPECT_TRUE(lept_is_equal(&v, &w));
+	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_document(d, json));
+	EXPECT_TRUE(lept_get_number_array(lept_document_get_root(d), &data, &n));
+	EXPECT_TRUE(lept_is_equal(&v, lept_document_get_root(d)));
+
+	/* packed and unpacked arrays compare by value */
+	e = lept_get_array_element(&w, 0);
+	EXPECT_EQ_DOUBLE(0.5, lept_get_number(e));
+	EXPECT_EQ_INT(LEPT_NUMBER_DOUBLE, lept_get_number_type(e));
+	EXPECT_TRUE(lept_is_equal(&v, &w));
+	lept_set_int64(e, 7);
+	EXPECT_FALSE(lept_is_equal(&v, &w));
+	EXPECT_FALSE(lept_get_number_array(&w, &data, &n));
+
+	/* changes that keep the doubles, and those that do not */
+	lept_erase_array_element(&v, 1, 14);
+	lept_popback_array_element(&v);
+	lept_reserve_array(&v, 100);
+	EXPECT_TRUE(lept_get_number_array(&v, &data, &n));
+	EXPECT_EQ_SIZE_T(3, n);
+	data[0] = 42.0;
+	lept_shrink_array(&v);
+	EXPECT_EQ_SIZE_T(3, lept_get_array_capacity(&v));
+	s = lept_stringify(&v, NULL);
+	EXPECT_TRUE(strcmp("[42,15.5,-9.5367431640625e-07]", s) == 0);
+	free(s);
+	lept_set_string(lept_pushback_array_element(&v), "x", 1);
+	EXPECT_FALSE(lept_get_number_array(&v, &data, &n));
+	EXPECT_EQ_DOUBLE(15.5, lept_get_number(lept_get_array_element(&v, 1)));
+	EXPECT_EQ_STRING("x", lept_get_string(lept_get_array_element(&v, 3)), 1);
+	lept_clear_array(&v);
+	EXPECT_TRUE(lept_get_number_array(&v, &data, &n));
+	EXPECT_EQ_SIZE_T(0, n);
+
+	/* from a C array, and small arrays packed on request */
+	lept_set_number_array(&v, more, 3);
+	lept_copy(&w, &v);
+	EXPECT_TRUE(lept_get_number_array(&w, &data, &n));
+	EXPECT_EQ_DOUBLE(1e10, data[2]);
+	lept_move(lept_pushback_array_element(lept_document_get_root(d)), &w);
+	lept_insert_array_element(lept_document_get_root(d), 0);
+	EXPECT_EQ_DOUBLE(-2.5, lept_get_number(lept_get_array_element(lept_get_array_element(lept_document_get_root(d), 19), 1)));
+	lept_free(&v);
+	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, "[1.5,2.5,3]"));
+	EXPECT_FALSE(lept_get_number_array(&v, &data, &n));
+	lept_free(&v);
+	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, "[[1.5,2.5],[]]"));
+	EXPECT_TRUE(lept_get_number_array(lept_get_array_element(&v, 0), &data, &n));
+	EXPECT_EQ_SIZE_T(2, n);
+	EXPECT_EQ_DOUBLE(2.5, data[1]);
+	s = lept_stringify(&v, NULL);
+	EXPECT_TRUE(strcmp("[[1.5,2.5],[]]", s) == 0);
+	free(s);
+	EXPECT_TRUE(lept_get_number_array(lept_get_array_element(&v, 1), &data, &n));
+	EXPECT_EQ_SIZE_T(0, n);
+	lept_free(&v);
+	lept_free(&w);
+	lept_document_destroy(d);
+}
+
+// count elements of the records below, about 1.5 MB of json
+static char* make_parallel_json(size_t count)
+{
+	static const char* records[] = {
+		"{\"id\":%u,\"name\":\"a,b]\\\"[{\",\"tags\":[1,2.5,\"x\"],\"o\":{}}",
+		"\"str %u with \\\" and , ] }\"",
+		"[[],{\"k\":[%u,{}]}]",
+		"true", "null", "-12.5e3", "123456789012345", "%u.5"
+	};
+	char* json = static_cast<char*>(malloc(count * 64 + 2));
+	size_t len = 0;
+	json[len++] = '[';
+	for (size_t i = 0; i < count; i++)
+	{
+		if (i)
+		{
+			json[len++] = ',';
+			json[len++] = '\n';
+		}
+		len += sprintf(json + len, records[i % 8], static_cast<unsigned>(i));
+	}
+	json[len++] = ']';
+	json[len] = '\0';
+	return json;
+}
+
+static void test_parse_parallel()
+{
+	static const unsigned threads[] = { 1, 2, 3, 8, 0 };
+	char* json = make_parallel_json(80000);
+	size_t len = strlen(json), i, n;
+	lept_value v, w;
+	double* data;
+	char* bad;
+
+	/* the same tree as lept_parse_n, for any number of threads; smaller inputs are not split */
+	EXPECT_TRUE(len > 1024 * 1024);
+	lept_init(&w);
+	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_n(&w, json, len));
+	EXPECT_EQ_SIZE_T(80000, lept_get_array_size(&w));
+	for (i = 0; i < sizeof(threads) / sizeof(threads[0]); i++)
+	{
+		lept_init(&v);
+		EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_parallel(&v, json, len, threads[i]));
+		EXPECT_TRUE(lept_is_equal(&v, &w));
+		lept_free(&v);
+	}
+	lept_free(&w);
+
+	/* an array of doubles is packed */
+	bad = static_cast<char*>(malloc(200000 * 12 + 2));
+	n = sprintf(bad, "[");
+	for (i = 0; i < 200000; i++)
+		n += sprintf(bad + n, i ? ",%u.5" : "%u.5", static_cast<unsigned>(i));
+	strcpy(bad + n, "]  ");
+	lept_init(&v);
+	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_parallel(&v, bad, strlen(bad), 4));
+	EXPECT_TRUE(lept_get_number_array(&v, &data, &n));
+	EXPECT_EQ_SIZE_T(200000, n);
+	EXPECT_EQ_DOUBLE(123456.5, data[123456]);
+	lept_free(&v);
+	free(bad);
+
+	/* errors anywhere are the ones lept_parse_n reports: at the end, in a middle chunk, after the
+	   root, in a string left open, a mismatched bracket */
+	bad = static_cast<char*>(malloc(len + 16));
+	for (i = 0; i < 6; i++)
+	{
+		memcpy(bad, json, len + 1);
+		n = len;
+		switch (i)
+		{
+		case 0: bad[len - 1] = ','; break;
+		case 1: memcpy(strstr(bad + len / 2, "true"), "tru ", 4); break;
+		case 2: n = sprintf(bad + len, " x") + len; break;
+		case 3: n = sprintf(bad + len - 1, ",\"open]") + len - 1; break;
+		case 4: bad[len - 1] = '}'; break;
+		case 5: memcpy(strstr(bad + len / 3, "null"), ",,,,", 4); break;
+		}
+		lept_init(&v);
+		lept_init(&w);
+		int expect = lept_parse_n(&w, bad, n);
+		EXPECT_TRUE(expect != LEPT_PARSE_OK);
+		EXPECT_EQ_INT(expect, lept_parse_parallel(&v, bad, n, 4));
+		lept_free(&v);
+		lept_free(&w);
+	}
+	free(bad);
+
+	/* elements are 4 levels deep, the root array counts towards the depth limit */
+	size_t depth = lept_get_max_depth();
+	lept_set_max_depth(4);
+	lept_init(&v);
+	EXPECT_EQ_INT(LEPT_PARSE_TOO_DEEP, lept_parse_parallel(&v, json, len, 4));
+	lept_set_max_depth(5);
+	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_parallel(&v, json, len, 4));
+	lept_free(&v);
+	lept_set_max_depth(depth);
+	free(json);
+}
+
+struct ndjson_records
+{
+	lept_value a;             // the records, a failed one as null
+	size_t lines[64];         // line and error of the first 64
+	int rets[64];
+	size_t stop;              // the callback returns 0 on this record
+};
+
+static int collect_record(void* ctx, size_t line, int ret, lept_value* v)
+{
+	ndjson_records* r = static_cast<ndjson_records*>(ctx);
+	size_t n = lept_get_array_size(&r->a);
+	if (n < 64)
+	{
+		r->lines[n] = line;
+		r->rets[n] = ret;
+	}
+	lept_move(lept_pushback_array_element(&r->a), v);
+	return n + 1 != r->stop;
+}
+
+static void test_parse_ndjson()
+{
+	static const char* lines[] = {
+		"{\"id\":%u,\"tags\":[\"a\",\"b\\n\"]}\n", "%u\r\n", "\n", "  \t\r\n", "[1,2,%u\n", "\"s%u\"\n", "{\"k\":}\n", "null"
+	};
+	static const unsigned threads[] = { 1, 3, 0 };
+	char* json = static_cast<char*>(malloc(3000 * 32));
+	size_t len = 0, i, j;
+	ndjson_records r;
+	lept_value expect;
+	for (i = 0; i < 3000; i++)
+		len += sprintf(json + len, lines[i % 7], static_cast<unsigned>(i));
+	len += sprintf(json + len, "%s", lines[7]);  // no '\n' after the last line
+	lept_init(&r.a);
+
+	/* records in input order, blank lines skipped, errors kept in place */
+	for (i = 0; i < sizeof(threads) / sizeof(threads[0]); i++)
+	{
+		lept_set_array(&r.a, 0);
+		r.stop = 0;
+		EXPECT_EQ_SIZE_T(3000 / 7 * 5 + 2 + 1, lept_parse_ndjson(json, len, threads[i], collect_record, &r));
+		EXPECT_EQ_SIZE_T(1, r.lines[0]);
+		EXPECT_EQ_SIZE_T(2, r.lines[1]);
+		EXPECT_EQ_SIZE_T(5, r.lines[2]);
+		EXPECT_EQ_INT(LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET, r.rets[2]);
+		EXPECT_EQ_INT(LEPT_PARSE_OK, r.rets[3]);
+		EXPECT_EQ_INT(LEPT_PARSE_INVALID_VALUE, r.rets[4]);
+		EXPECT_EQ_SIZE_T(8, r.lines[5]);
+		for (j = 0; j < lept_get_array_size(&r.a); j++)
+		{
+			size_t line = j / 5 * 7 + (j % 5 < 2 ? j % 5 : j % 5 + 2);
+			const char* s = json;
+			for (size_t k = 0; k < line; k++)
+				s = strchr(s, '\n') + 1;
+			lept_init(&expect);
+			lept_parse_n(&expect, s, strchr(s, '\n') != NULL ? strchr(s, '\n') - s : strlen(s));
+			EXPECT_TRUE(lept_is_equal(&expect, lept_get_array_element(&r.a, j)));
+			lept_free(&expect);
+		}
+		lept_free(&r.a);
+	}
+
+	/* the callback stops the batch */
+	lept_set_array(&r.a, 0);
+	r.stop = 10;
+	EXPECT_EQ_SIZE_T(10, lept_parse_ndjson(json, len, 2, collect_record, &r));
+	EXPECT_EQ_SIZE_T(10, lept_get_array_size(&r.a));
+	lept_free(&r.a);
+	free(json);
+
+	/* a file larger than a window, with a line longer than one */
+	FILE* f = tmpfile();
+	for (i = 0; i < 300000; i++)
+		fprintf(f, "{\"id\":%u}\n", static_cast<unsigned>(i));
+	fputc('"', f);
+	for (i = 0; i < 5000000; i++)
+		fputc('a' + i % 26, f);
+	fputs("\"\n[true]", f);
+	rewind(f);
+	lept_set_array(&r.a, 0);
+	r.stop = 0;
+	EXPECT_EQ_SIZE_T(300002, lept_parse_ndjson_file(f, 1, collect_record, &r));
+	EXPECT_EQ_DOUBLE(299999.0, lept_get_number(lept_find_object_value(lept_get_array_element(&r.a, 299999), "id", 2)));
+	EXPECT_EQ_SIZE_T(5000000, lept_get_string_length(lept_get_array_element(&r.a, 300000)));
+	EXPECT_EQ_INT(LEPT_TRUE, lept_get_type(lept_get_array_element(lept_get_array_element(&r.a, 300001), 0)));
+	lept_free(&r.a);
+	fclose(f);
+}
+
+static void check_stringify_parallel(const lept_value* v)
+{
+	static const unsigned threads[] = { 1, 2, 3, 8, 0 };
+	size_t length, n;
+	char* expect = lept_stringify(v, &length);
+	for (size_t i = 0; i < sizeof(threads) / sizeof(threads[0]); i++)
+	{
+		char* actual = lept_stringify_parallel(v, &n, threads[i]);
+		EXPECT_EQ_SIZE_T(length, n);
+		EXPECT_TRUE(memcmp(expect, actual, length + 1) == 0);
+		free(actual);
+	}
+	free(expect);
+}
+
+static void test_stringify_parallel()
+{
+	char* records = make_parallel_json(80000);
+	char* json = static_cast<char*>(malloc(3 * strlen(records) + 2000000));
+	lept_document* d = lept_document_create();
+	lept_value v;
+	double* data;
+	size_t len, i, count;
+
+	/* a large array is cut evenly, a few large members are each cut, small ones are kept together */
+	lept_init(&v);
+	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, records));
+	check_stringify_parallel(&v);
+	lept_free(&v);
+	len = sprintf(json, "{\"meta\":{\"a\":1,\"b\":[]},\"data\":%s,\"deep\":{\"x\":[true,{\"y\":%s}]},\"n\":[", records, records);
+	for (i = 0; i < 100000; i++)
+		len += sprintf(json + len, i ? ",%u.5" : "%u.5", static_cast<unsigned>(i));
+	strcpy(json + len, "],\"e\":{},\"s\":\"end\"}");
+	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, json));
+	check_stringify_parallel(&v);
+	EXPECT_TRUE(lept_get_number_array(lept_find_object_value(&v, "n", 1), &data, &count));
+	check_stringify_parallel(&v);
+	check_stringify_parallel(lept_find_object_value(&v, "n", 1));
+	lept_free(&v);
+
+	/* lazy values are built before the tasks start, packed arrays among them are read as they are,
+	   document values are read in place (run under TSan to see it) */
+	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_lazy(&v, json));
+	check_stringify_parallel(&v);
+	lept_free(&v);
+	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_lazy(&v, json));
+	free(lept_stringify_parallel(&v, NULL, 4));
+	EXPECT_TRUE(lept_get_number_array(lept_find_object_value(&v, "n", 1), &data, &count));
+	EXPECT_EQ_SIZE_T(100000, count);
+	lept_free(&v);
+	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_document(d, json));
+	check_stringify_parallel(lept_document_get_root(d));
+	lept_document_destroy(d);
+
+	/* a small value is written on the calling thread */
+	EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, "[1,{\"a\":\"b\"},null]"));
+	check_stringify_parallel(&v);
+	lept_free(&v);
+	free(json);
+	free(records);
+}
+
 static void test_access_null()
 {
 	lept_value v;
@@ -571,6 +2440,17 @@ static void test_access_number()
 	lept_set_string(&v, "a", 1);
 	lept_set_number(&v, 1234.5);
 	EXPECT_EQ_DOUBLE(1234.5, lept_get_number(&v));
+	EXPECT_EQ_INT(LEPT_NUMBER_DOUBLE, lept_get_number_type(&v));
+	lept_set_int64(&v, -9007199254740993LL);
+	EXPECT_EQ_INT(LEPT_NUMBER_INT64, lept_get_number_type(&v));
+	EXPECT_TRUE(-9007199254740993LL == lept_get_int64(&v));
+	lept_set_uint64(&v, 42);
+	EXPECT_EQ_INT(LEPT_NUMBER_INT64, lept_get_number_type(&v));
+	EXPECT_TRUE(42 == lept_get_int64(&v));
+	EXPECT_TRUE(42 == lept_get_uint64(&v));
+	lept_set_uint64(&v, UINT64_MAX);
+	EXPECT_EQ_INT(LEPT_NUMBER_UINT64, lept_get_number_type(&v));
+	EXPECT_TRUE(UINT64_MAX == lept_get_uint64(&v));
 	lept_free(&v);
 }
 
@@ -749,6 +2629,7 @@ int main()
 	#ifdef _WINDOWS
 	_CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF | _CRTDBG_LEAK_CHECK_DF);
 	#endif
+	test_simd_threads();
 	test_parse();
 	test_stringify();
 	test_equal();
@@ -756,6 +2637,40 @@ int main()
 	test_move();
 	test_swap();
 	test_access();
+	test_tape();
+	test_parse_insitu();
+	test_parse_lazy();
+	test_parser_feed();
+	test_parser_parse();
+	test_parse_sax();
+	test_reader();
+	test_parse_depth();
+	test_document();
+	test_intern_keys();
+	test_allocator();
+	test_parse_indexed_invalid();
+	test_inline_string();
+	test_object_index();
+	test_packed_array();
+	test_parse_parallel();
+	test_parse_ndjson();
+	test_stringify_parallel();
+
+	parse_json = lept_parse_indexed;
+	test_parse();
+	test_stringify();
+	test_equal();
+	test_copy();
+	test_move();
+
+	parse_json = lept_parse_lazy;
+	test_parse();
+	test_stringify();
+	test_equal();
+	test_copy();
+	test_move();
+	parse_json = lept_parse;
+
 	printf("%d/%d (%3.2f%%) passed\n", test_pass, test_count, test_pass*100.0 / test_count);
 	return main_ret;
 }
\ No newline at end of file